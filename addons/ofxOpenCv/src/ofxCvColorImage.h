@@ -17,6 +17,7 @@ class ofxCvColorImage : public ofxCvImage {
 
   public:
 	using ofxCvImage::setFromPixels;
+	using ofxCvImage::setRoiFromPixels;
 
     ofxCvColorImage();
     ofxCvColorImage( const ofxCvColorImage& mom );
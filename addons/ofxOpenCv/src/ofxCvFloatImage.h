@@ -26,6 +26,7 @@ class ofxCvFloatImage : public ofxCvImage {
 
   public:
 	using ofxCvImage::setFromPixels;
+	using ofxCvImage::setRoiFromPixels;
 
     ofxCvFloatImage();
     ofxCvFloatImage( const ofxCvFloatImage& mom );
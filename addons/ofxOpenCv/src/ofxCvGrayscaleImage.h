@@ -19,6 +19,7 @@ class ofxCvGrayscaleImage : public ofxCvImage {
 
   public:
 	using ofxCvImage::setFromPixels;
+	using ofxCvImage::setRoiFromPixels;
 
     ofxCvGrayscaleImage();
     ~ofxCvGrayscaleImage();
@@ -862,6 +862,72 @@ void ofxCvImage::setRoiFromPixels( const ofPixels & pixels ){
 	setRoiFromPixels(pixels.getPixels(),pixels.getWidth(),pixels.getHeight());
 }
 
+//--------------------------------------------------------------------------------
+void ofxCvImage::setFromPixels( const ofPixelsView & pixels ){
+	if( pixels.isContiguous() ){
+		setFromPixels(pixels.getPixels(),pixels.getWidth(),pixels.getHeight());
+		return;
+	}
+	if( !cvImage || cvImage->depth != IPL_DEPTH_8U || cvImage->nChannels != pixels.getNumChannels() ){
+		// other image types convert from contiguous pixels
+		ofPixels packed;
+		packed.setFromView(pixels);
+		setFromPixels(packed);
+		return;
+	}
+
+	if( !bAllocated || pixels.getWidth() != width || pixels.getHeight() != height ) {
+		allocate(pixels.getWidth(),pixels.getHeight());
+	}
+
+	// wrap the view rows in an image header so opencv copies them in place
+	IplImage view;
+	cvInitImageHeader(&view, cvSize(pixels.getWidth(),pixels.getHeight()), IPL_DEPTH_8U, pixels.getNumChannels());
+	cvSetData(&view, pixels.getPixels(), pixels.getStride());
+
+	ofRectangle roi = getROI();
+	resetImageROI(cvImage);
+	cvCopy(&view, cvImage);
+	setImageROI(cvImage, roi);
+	flagImageChanged();
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvImage::setRoiFromPixels( const ofPixelsView & pixels ){
+	if( pixels.isContiguous() ){
+		setRoiFromPixels(pixels.getPixels(),pixels.getWidth(),pixels.getHeight());
+		return;
+	}
+	if( !cvImage || cvImage->depth != IPL_DEPTH_8U || cvImage->nChannels != pixels.getNumChannels() ){
+		ofPixels packed;
+		packed.setFromView(pixels);
+		setRoiFromPixels(packed);
+		return;
+	}
+	if( !bAllocated ){
+		ofLogError("ofxCvImage") << "setRoiFromPixels(): image not allocated";
+		return;
+	}
+
+	ofRectangle roi = getROI();
+	ofRectangle iRoi = getIntersectionROI( roi, ofRectangle( roi.x, roi.y, pixels.getWidth(), pixels.getHeight() ) );
+	if( iRoi.width <= 0 || iRoi.height <= 0 ) {
+		ofLogError("ofxCvImage") << "setRoiFromPixels(): region of interest width and/or height are zero: "
+			<< iRoi.width << " " << iRoi.height;
+		return;
+	}
+
+	// copy however many pixels we have or will fit in cvImage
+	IplImage view;
+	cvInitImageHeader(&view, cvSize((int)iRoi.width,(int)iRoi.height), IPL_DEPTH_8U, pixels.getNumChannels());
+	cvSetData(&view, pixels.getPixels(), pixels.getStride());
+
+	setImageROI(cvImage, iRoi);
+	cvCopy(&view, cvImage);
+	setImageROI(cvImage, roi);
+	flagImageChanged();
+}
+
 //--------------------------------------------------------------------------------
 unsigned char*  ofxCvImage::getPixels(){
 	return getPixelsRef().getPixels();
@@ -61,6 +61,8 @@ class ofxCvImage : public ofBaseImage {
     virtual void  setFromPixels( const ofPixels & pixels );
     virtual void  setRoiFromPixels( const unsigned char* _pixels, int w, int h ) = 0;
     virtual void  setRoiFromPixels( const ofPixels & pixels );
+    virtual void  setFromPixels( const ofPixelsView & pixels );  // views can be strided
+    virtual void  setRoiFromPixels( const ofPixelsView & pixels );
     virtual void  operator = ( const ofxCvGrayscaleImage& mom ) = 0;
     virtual void  operator = ( const ofxCvColorImage& mom ) = 0;
     virtual void  operator = ( const ofxCvFloatImage& mom ) = 0;
@@ -1,137 +1,216 @@
 #include "ofxThreadedImageLoader.h"
 #include <sstream>
-ofxThreadedImageLoader::ofxThreadedImageLoader() 
+ofxThreadedImageLoader::ofxThreadedImageLoader(int numWorkers)
 :ofThread()
 {
 	nextID = 0;
+	maxUploadsPerFrame = 1;
+	maxUploadTimePerFrame = 0;
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
-	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
+
     startThread();
-    lastUpdate = 0;
+    for(int i=1;i<numWorkers;i++){
+    	workers.push_back(ofPtr<Worker>(new Worker(*this)));
+    	workers.back()->startThread();
+    }
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	condition.signal();
+	// stop every worker while holding the mutex so none of them misses the
+	// signal between checking if it's running and waiting
+	lock();
+	stopThread();
+	for(int i=0;i<(int)workers.size();i++){
+		workers[i]->stopThread();
+	}
+	condition.broadcast();
+	unlock();
+
+	waitForThread(false);
+	for(int i=0;i<(int)workers.size();i++){
+		workers[i]->waitForThread(false);
+	}
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
-	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
+}
+
+//--------------------------------------------------------------
+ofxThreadedImageLoader::Worker::Worker(ofxThreadedImageLoader & loader)
+:loader(loader){}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::Worker::threadedFunction(){
+	loader.work(*this);
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename) {
-	nextID++;
+int ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename, int priority) {
 	ofImageLoaderEntry entry(image, OF_LOAD_FROM_DISK);
 	entry.filename = filename;
-	entry.id = nextID;
-	entry.image->setUseTexture(false);
-	entry.name = filename;
-    
-    lock();
-    images_to_load_buffer.push_back(entry);
-    condition.signal();
-    unlock();
+	entry.priority = priority;
+	return addEntry(entry);
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url) {
-	nextID++;
+int ofxThreadedImageLoader::loadFromURL(ofImage& image, string url, int priority) {
 	ofImageLoaderEntry entry(image, OF_LOAD_FROM_URL);
 	entry.url = url;
-	entry.id = nextID;
-	entry.image->setUseTexture(false);	
-	entry.name = "image" + ofToString(entry.id);
+	entry.priority = priority;
+	return addEntry(entry);
+}
+
+//--------------------------------------------------------------
+int ofxThreadedImageLoader::addEntry(ofImageLoaderEntry & entry) {
+	entry.image->setUseTexture(false);
 
     lock();
-	images_to_load_buffer.push_back(entry);
+	entry.id = ++nextID;
+	insertByPriority(images_to_load_buffer, entry);
     condition.signal();
     unlock();
+    return entry.id;
 }
 
-
-// Reads from the queue and loads new images.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::threadedFunction() {
-    deque<ofImageLoaderEntry> images_to_load;
+bool ofxThreadedImageLoader::setPriority(int id, int priority) {
+	lock();
+	entry_iterator it = getEntry(images_to_load_buffer, id);
+	if(it == images_to_load_buffer.end()) {
+		unlock();
+		return false;
+	}
+	ofImageLoaderEntry entry = *it;
+	entry.priority = priority;
+	images_to_load_buffer.erase(it);
+	insertByPriority(images_to_load_buffer, entry);
+	unlock();
+	return true;
+}
 
-	while( isThreadRunning() ) {
-		lock();
-		if(images_to_load_buffer.empty()) condition.wait(mutex);
-		images_to_load.insert( images_to_load.end(),
-							images_to_load_buffer.begin(),
-							images_to_load_buffer.end() );
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::cancel(int id) {
+	lock();
+	entry_iterator it = getEntry(images_to_load_buffer, id);
+	bool found = it != images_to_load_buffer.end();
+	if(found) {
+		images_to_load_buffer.erase(it);
+	} else {
+		it = getEntry(images_to_update, id);
+		found = it != images_to_update.end();
+		if(found) {
+			images_to_update.erase(it);
+		}
+	}
+	unlock();
+	return found;
+}
 
-		images_to_load_buffer.clear();
-		unlock();
-        
-        
-        while( !images_to_load.empty() ) {
-            ofImageLoaderEntry  & entry = images_to_load.front();
-            
-            if(entry.type == OF_LOAD_FROM_DISK) {
-                if(! entry.image->loadImage(entry.filename) )  { 
-                    ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
-                }
-                
-                lock();
-                images_to_update.push_back(entry);
-                unlock();
-            }else if(entry.type == OF_LOAD_FROM_URL) {
-                lock();
-                images_async_loading.push_back(entry);
-                unlock();
-                
-                ofLoadURLAsync(entry.url, entry.name);
-            }
-
-    		images_to_load.pop_front();
-        }
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(ofImage & image) {
+	lock();
+	for(entry_iterator it = images_to_load_buffer.begin(); it != images_to_load_buffer.end();) {
+		if(it->image == &image) it = images_to_load_buffer.erase(it);
+		else it++;
+	}
+	for(entry_iterator it = images_to_update.begin(); it != images_to_update.end();) {
+		if(it->image == &image) it = images_to_update.erase(it);
+		else it++;
 	}
+	unlock();
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll() {
+	lock();
+	images_to_load_buffer.clear();
+	images_to_update.clear();
+	unlock();
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setMaxUploadsPerFrame(int maxUploads) {
+	maxUploadsPerFrame = maxUploads;
 }
 
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setMaxUploadTimePerFrame(float millis) {
+	maxUploadTimePerFrame = millis;
+}
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
-	if(response.status == 200) {
-		lock();
-		
-		// Get the loaded url from the async queue and move it into the update queue.
-		entry_iterator it = getEntryFromAsyncQueue(response.request.name);
-		if(it != images_async_loading.end()) {
-			(*it).image->loadImage(response.data);
-			images_to_update.push_back(*it);
-			images_async_loading.erase(it);
+int ofxThreadedImageLoader::getNumWorkers() {
+	return workers.size() + 1;
+}
+
+//--------------------------------------------------------------
+int ofxThreadedImageLoader::getNumQueued() {
+	lock();
+	int queued = images_to_load_buffer.size();
+	unlock();
+	return queued;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::threadedFunction() {
+	work(*this);
+}
+
+// Reads from the queue and loads new images. Runs in every worker
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::work(ofThread & thread) {
+	lock();
+	while( thread.isThreadRunning() ) {
+		if(images_to_load_buffer.empty()) {
+			condition.wait(mutex);
+			continue;
 		}
-		
+
+		ofImageLoaderEntry entry = images_to_load_buffer.front();
+		images_to_load_buffer.pop_front();
 		unlock();
-	}else{
-		// log error.
-		ofLogError("ofxThreadedImageLoader") << "couldn't load url, response status: " << response.status;
-		ofRemoveURLRequest(response.request.getID());
-		// remove the entry from the queue
+
+		bool loaded = false;
+		if(entry.type == OF_LOAD_FROM_DISK) {
+			loaded = entry.image->loadImage(entry.filename).get();
+			if(!loaded) {
+				ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			}
+		}else if(entry.type == OF_LOAD_FROM_URL) {
+			// the worker waits for the download so the image is also
+			// decoded here instead of in the main thread
+			ofHttpResponse response = ofLoadURL(entry.url)->response.get();
+			if(response.status == 200) {
+				loaded = entry.image->loadImage(response.data);
+			}else{
+				ofLogError("ofxThreadedImageLoader") << "couldn't load url: \"" << entry.url << "\", response status: " << response.status;
+			}
+		}
+
 		lock();
-		entry_iterator it = getEntryFromAsyncQueue(response.request.name);
-		if(it != images_async_loading.end()) {
-			images_async_loading.erase(it);
+		if(loaded) {
+			insertByPriority(images_to_update, entry);
 		}
-		unlock();
 	}
+	unlock();
 }
 
 
-// Check the update queue and update the texture
+// Check the update queue and update the textures
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    
-    // Load 1 image per update so we don't block the gl thread for too long
-    
+
+    // Limit the uploads per update so we don't block the gl thread for too long
+    unsigned long long start = ofGetElapsedTimeMicros();
+    int uploaded = 0;
+
     lock();
-	if (!images_to_update.empty()) {
+	while(!images_to_update.empty() && (maxUploadsPerFrame <= 0 || uploaded < maxUploadsPerFrame)) {
+		if(uploaded > 0 && maxUploadTimePerFrame > 0 && (ofGetElapsedTimeMicros() - start) >= maxUploadTimePerFrame * 1000) {
+			break;
+		}
 
 		ofImageLoaderEntry entry = images_to_update.front();
 
@@ -141,25 +220,35 @@ void ofxThreadedImageLoader::update(ofEventArgs & a){
 				,pix.getHeight()
 				,ofGetGlInternalFormat(pix)
 		);
-		
+
 		entry.image->setUseTexture(true);
 		entry.image->update();
 
 		images_to_update.pop_front();
+		uploaded++;
 	}
     unlock();
 }
 
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::insertByPriority(deque<ofImageLoaderEntry> & queue, const ofImageLoaderEntry & entry) {
+	// after every entry with the same priority so those keep their order
+	entry_iterator it = queue.end();
+	while(it != queue.begin() && (it - 1)->priority < entry.priority) {
+		it--;
+	}
+	queue.insert(it, entry);
+}
 
-// Find an entry in the aysnc queue.
+// Find an entry by id in one of the queues.
 //   * private, no lock protection, is private function
 //--------------------------------------------------------------
-ofxThreadedImageLoader::entry_iterator ofxThreadedImageLoader::getEntryFromAsyncQueue(string name) {
-	entry_iterator it = images_async_loading.begin();
-	for(;it != images_async_loading.end();it++) {
-		if((*it).name == name) {
+ofxThreadedImageLoader::entry_iterator ofxThreadedImageLoader::getEntry(deque<ofImageLoaderEntry> & queue, int id) {
+	entry_iterator it = queue.begin();
+	for(;it != queue.end();it++) {
+		if((*it).id == id) {
 			return it;
 		}
 	}
-	return images_async_loading.end();
+	return queue.end();
 }
@@ -4,7 +4,7 @@
 #include "ofThread.h"
 #include "ofImage.h"
 #include "ofURLFileLoader.h"
-#include "ofTypes.h" 
+#include "ofTypes.h"
 
 // must use poco condition not lock for this
 #include "Poco/Condition.h"
@@ -13,60 +13,90 @@ using namespace std;
 
 class ofxThreadedImageLoader : public ofThread {
 public:
-    ofxThreadedImageLoader();
+	// numWorkers threads decode images in parallel
+    ofxThreadedImageLoader(int numWorkers = 1);
     ~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, string file);
-	void loadFromURL(ofImage& image, string url);
+	// requests with a higher priority are loaded first, the ones with the same
+	// priority in the order they were requested. the returned id can be used
+	// to change the priority or cancel the request while it's still queued
+	int loadFromDisk(ofImage& image, string file, int priority = 0);
+	int loadFromURL(ofImage& image, string url, int priority = 0);
 
+	bool setPriority(int id, int priority);
 
+	// removes requests that didn't start loading yet and images waiting to be
+	// uploaded. returns false if the request is already being loaded
+	bool cancel(int id);
+	void cancel(ofImage & image);
+	void cancelAll();
+
+	// textures uploaded in each update, 0 for no limit. defaults to 1
+	void setMaxUploadsPerFrame(int maxUploads);
+	// stop uploading for this frame once this many milliseconds have been
+	// spent, at least one texture is always uploaded. 0 for no limit
+	void setMaxUploadTimePerFrame(float millis);
+
+	int getNumWorkers();
+	int getNumQueued();
 
 private:
 	void update(ofEventArgs & a);
     virtual void threadedFunction();
-	void urlResponse(ofHttpResponse & response);
 
     // Where to load form?
     enum ofLoaderType {
         OF_LOAD_FROM_DISK
         ,OF_LOAD_FROM_URL
     };
-    
-    
+
+
     // Entry to load.
     struct ofImageLoaderEntry {
         ofImageLoaderEntry() {
             image = NULL;
             type = OF_LOAD_FROM_DISK;
             id=0;
+            priority=0;
         }
-        
+
         ofImageLoaderEntry(ofImage & pImage, ofLoaderType nType) {
             image = &pImage;
             type = nType;
             id=0;
+            priority=0;
         }
         ofImage* image;
         ofLoaderType type;
         string filename;
         string url;
-        string name;
         int id;
+        int priority;
     };
 
+    // the rest of the workers, the loader thread itself is the first one
+    class Worker : public ofThread {
+    public:
+    	Worker(ofxThreadedImageLoader & loader);
+    private:
+    	void threadedFunction();
+    	ofxThreadedImageLoader & loader;
+    };
 
     typedef deque<ofImageLoaderEntry>::iterator entry_iterator;
-	entry_iterator      getEntryFromAsyncQueue(string name);
+    int                 addEntry(ofImageLoaderEntry & entry);
+    void                work(ofThread & thread);
+    void                insertByPriority(deque<ofImageLoaderEntry> & queue, const ofImageLoaderEntry & entry);
+	entry_iterator      getEntry(deque<ofImageLoaderEntry> & queue, int id);
 
 	int                 nextID;
 
     Poco::Condition     condition;
 
-    int                 lastUpdate;
+    int                 maxUploadsPerFrame;
+    float               maxUploadTimePerFrame;
 
-	deque<ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
+	vector<ofPtr<Worker> > workers;
 	deque<ofImageLoaderEntry> images_to_load_buffer;
     deque<ofImageLoaderEntry> images_to_update;
 };
-
-
@@ -9,6 +9,42 @@
 #include "of3dPrimitives.h"
 #include "ofGraphics.h"
 
+enum ofPrimitiveMeshType{
+	OF_PRIMITIVE_MESH_PLANE,
+	OF_PRIMITIVE_MESH_SPHERE,
+	OF_PRIMITIVE_MESH_ICOSPHERE,
+	OF_PRIMITIVE_MESH_CYLINDER,
+	OF_PRIMITIVE_MESH_CONE,
+	OF_PRIMITIVE_MESH_BOX
+};
+
+// meshes of the primitives by their parameters, only weak references so
+// they are deleted when no primitive uses them anymore
+typedef map<vector<float>, weak_ptr<ofMesh> > ofPrimitiveMeshCache;
+
+static ofPrimitiveMeshCache & primitiveMeshCache(){
+	static ofPrimitiveMeshCache * cache = new ofPrimitiveMeshCache;
+	return *cache;
+}
+
+static ofPtr<ofMesh> getCachedPrimitiveMesh(const vector<float> & key){
+	ofPrimitiveMeshCache::iterator it = primitiveMeshCache().find(key);
+	if(it==primitiveMeshCache().end()) return ofPtr<ofMesh>();
+	return it->second.lock();
+}
+
+static void setCachedPrimitiveMesh(const vector<float> & key, ofPtr<ofMesh> mesh){
+	ofPrimitiveMeshCache & cache = primitiveMeshCache();
+	// drop the entries of meshes that have been deleted once in a while
+	if(cache.size()>64 && cache.size()%64==0){
+		for(ofPrimitiveMeshCache::iterator it=cache.begin();it!=cache.end();){
+			if(it->second.expired()) cache.erase(it++);
+			else ++it;
+		}
+	}
+	cache[key] = mesh;
+}
+
 of3dPrimitive::of3dPrimitive()
 :usingVbo(true)
 ,mesh(new ofVboMesh)
@@ -25,6 +61,11 @@ of3dPrimitive::~of3dPrimitive() {
 of3dPrimitive::of3dPrimitive(const of3dPrimitive & mom){
     texCoords = mom.texCoords;
     usingVbo = mom.usingVbo;
+    meshKey = mom.meshKey;
+	if(mom.isMeshShared()){
+		mesh = mom.mesh;
+		return;
+	}
 	if(usingVbo){
 		mesh = ofPtr<ofMesh>(new ofVboMesh);
 	}else{
@@ -37,19 +78,82 @@ of3dPrimitive::of3dPrimitive(const of3dPrimitive & mom){
 of3dPrimitive & of3dPrimitive::operator=(const of3dPrimitive & mom){
 	if(&mom!=this){
 		texCoords = mom.texCoords;
-		setUseVbo(mom.usingVbo);
-		*mesh = *mom.mesh;
+		if(mom.isMeshShared()){
+			usingVbo = mom.usingVbo;
+			meshKey = mom.meshKey;
+			mesh = mom.mesh;
+		}else{
+			if(isMeshShared()){
+				unshareMesh();
+			}
+			setUseVbo(mom.usingVbo);
+			*mesh = *mom.mesh;
+		}
 	}
     return *this;
 }
 
+//----------------------------------------------------------
+void of3dPrimitive::setSharedMesh( vector<float> key, ofMesh (*generator)(const vector<float> & key) ){
+	key.push_back(usingVbo);
+	if(isMeshShared() && key==meshKey) return;
+	ofPtr<ofMesh> cached = getCachedPrimitiveMesh(key);
+	if(!cached){
+		if(usingVbo){
+			cached = ofPtr<ofMesh>(new ofVboMesh);
+		}else{
+			cached = ofPtr<ofMesh>(new ofMesh);
+		}
+		*cached = generator(key);
+		setCachedPrimitiveMesh(key, cached);
+	}
+	mesh = cached;
+	meshKey = key;
+}
+
+//----------------------------------------------------------
+void of3dPrimitive::unshareMesh(){
+	if(!isMeshShared()) return;
+	ofPtr<ofMesh> ownMesh;
+	if(usingVbo){
+		ownMesh = ofPtr<ofMesh>(new ofVboMesh);
+	}else{
+		ownMesh = ofPtr<ofMesh>(new ofMesh);
+	}
+	*ownMesh = *mesh;
+	mesh = ownMesh;
+	meshKey.clear();
+}
+
+//----------------------------------------------------------
+bool of3dPrimitive::isMeshShared() const{
+	return !meshKey.empty();
+}
+
 // GETTERS //
 //----------------------------------------------------------
 ofMesh* of3dPrimitive::getMeshPtr() {
+    unshareMesh();
     return mesh.get();
 }
 //----------------------------------------------------------
 ofMesh& of3dPrimitive::getMesh() {
+    unshareMesh();
+    return *mesh;
+}
+
+//----------------------------------------------------------
+const ofMesh* of3dPrimitive::getMeshPtr() const {
+    return mesh.get();
+}
+
+//----------------------------------------------------------
+const ofMesh& of3dPrimitive::getMesh() const {
+    return *mesh;
+}
+
+//----------------------------------------------------------
+ofMesh& of3dPrimitive::getSharedMesh() {
     return *mesh;
 }
 
@@ -65,8 +169,10 @@ ofVec4f& of3dPrimitive::getTexCoords() {
 
 //----------------------------------------------------------
 vector<ofIndexType> of3dPrimitive::getIndices( int startIndex, int endIndex ) {
+    // the non const getters would flag a shared mesh as changed
+    const ofMesh& sharedMesh = *mesh;
     vector<ofIndexType> indices;
-    indices.assign( getMesh().getIndices().begin()+startIndex, getMesh().getIndices().begin()+endIndex );
+    indices.assign( sharedMesh.getIndices().begin()+startIndex, sharedMesh.getIndices().begin()+endIndex );
     return indices;
 }
 
@@ -78,7 +184,7 @@ bool of3dPrimitive::hasScaling() {
 }
 //----------------------------------------------------------
 bool of3dPrimitive::hasNormalsEnabled() {
-    return getMesh().hasNormals();
+    return mesh->hasNormals();
 }
 
 //----------------------------------------------------------
@@ -150,6 +256,8 @@ void of3dPrimitive::normalizeAndApplySavedTexCoords() {
     // when a new mesh is created, it uses normalized tex coords, we need to reset them
     // but save the ones used previously //
     texCoords.set(0,0,1,1);
+    // the mesh can stay shared if they are the default ones
+    if(tcoords==texCoords) return;
     mapTexCoords(tcoords.x, tcoords.y, tcoords.z, tcoords.w);
 }
 
@@ -188,9 +296,10 @@ void of3dPrimitive::draw(ofPolyRenderMode renderType) {
 void of3dPrimitive::drawNormals(float length, bool bFaceNormals) {
     ofNode::transformGL();
     
-    if(getMesh().usingNormals()) {
-        vector<ofVec3f>& normals    = getMesh().getNormals();
-        vector<ofVec3f>& vertices   = getMesh().getVertices();
+    if(mesh->usingNormals()) {
+        const ofMesh& sharedMesh          = *mesh;
+        const vector<ofVec3f>& normals    = sharedMesh.getNormals();
+        const vector<ofVec3f>& vertices   = sharedMesh.getVertices();
         ofVec3f normal;
         ofVec3f vert;
         
@@ -238,7 +347,22 @@ void of3dPrimitive::drawAxes(float a_size) {
 
 //--------------------------------------------------------------
 void of3dPrimitive::setUseVbo(bool useVbo){
-	if(useVbo!=usingVbo){
+	if(useVbo!=usingVbo && isMeshShared()){
+		vector<float> key = meshKey;
+		key.back() = useVbo;
+		ofPtr<ofMesh> cached = getCachedPrimitiveMesh(key);
+		if(!cached){
+			if(useVbo){
+				cached = ofPtr<ofMesh>(new ofVboMesh);
+			}else{
+				cached = ofPtr<ofMesh>(new ofMesh);
+			}
+			*cached = *mesh;
+			setCachedPrimitiveMesh(key, cached);
+		}
+		mesh = cached;
+		meshKey = key;
+	}else if(useVbo!=usingVbo){
 		ofPtr<ofMesh> newMesh;
 		if(useVbo){
 			newMesh = ofPtr<ofMesh>(new ofVboMesh);
@@ -256,6 +380,11 @@ bool of3dPrimitive::isUsingVbo(){
 	return usingVbo;
 }
 
+//--------------------------------------------------------------
+static ofMesh planeMesh(const vector<float> & key){
+    return ofMesh::plane( key[1], key[2], key[3], key[4], (ofPrimitiveMode)key[5] );
+}
+
 // PLANE PRIMITIVE //
 //--------------------------------------------------------------
 ofPlanePrimitive::ofPlanePrimitive() {
@@ -279,7 +408,14 @@ void ofPlanePrimitive::set(float _width, float _height, int columns, int rows, o
     height = _height;
     resolution.set( columns, rows );
     
-    getMesh() = ofMesh::plane( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
+    vector<float> key(6);
+    key[0] = OF_PRIMITIVE_MESH_PLANE;
+    key[1] = getWidth();
+    key[2] = getHeight();
+    key[3] = getResolution().x;
+    key[4] = getResolution().y;
+    key[5] = mode;
+    setSharedMesh( key, planeMesh );
     
     normalizeAndApplySavedTexCoords();
     
@@ -322,14 +458,14 @@ void ofPlanePrimitive::setRows( int rows ) {
 //--------------------------------------------------------------
 void ofPlanePrimitive::setResolution( int columns, int rows ) {
     resolution.set( columns, rows );
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     
     set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
 }
 
 //--------------------------------------------------------------
 void ofPlanePrimitive::setMode(ofPrimitiveMode mode) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     
     if( mode != currMode )
         set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
@@ -364,6 +500,11 @@ float ofPlanePrimitive::getHeight() {
 
 
 
+//--------------------------------------------------------------
+static ofMesh sphereMesh(const vector<float> & key){
+    return ofMesh::sphere( key[1], key[2], (ofPrimitiveMode)key[3] );
+}
+
 // SPHERE PRIMITIVE //
 //----------------------------------------------------------
 ofSpherePrimitive::ofSpherePrimitive() {
@@ -389,7 +530,12 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
     radius     = _radius;
     resolution = res;
 
-    getMesh() = ofMesh::sphere( getRadius(), getResolution(), mode );
+    vector<float> key(4);
+    key[0] = OF_PRIMITIVE_MESH_SPHERE;
+    key[1] = getRadius();
+    key[2] = getResolution();
+    key[3] = mode;
+    setSharedMesh( key, sphereMesh );
     
     normalizeAndApplySavedTexCoords();
 }
@@ -397,14 +543,14 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
 //----------------------------------------------------------
 void ofSpherePrimitive::setResolution( int res ) {
     resolution             = res;
-    ofPrimitiveMode mode   = getMesh().getMode();
+    ofPrimitiveMode mode   = mesh->getMode();
     
     set(getRadius(), getResolution(), mode );
 }
 
 //----------------------------------------------------------
 void ofSpherePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set(getRadius(), getResolution(), mode );
 }
@@ -426,6 +572,11 @@ int ofSpherePrimitive::getResolution() {
 }
 
 
+//--------------------------------------------------------------
+static ofMesh icoSphereMesh(const vector<float> & key){
+    return ofMesh::icosphere( key[1], key[2] );
+}
+
 // ICO SPHERE //
 //----------------------------------------------------------
 ofIcoSpherePrimitive::ofIcoSpherePrimitive() {
@@ -457,7 +608,11 @@ void ofIcoSpherePrimitive::setResolution( int iterations ) {
     // store the number of iterations in the resolution //
     resolution = iterations;
     
-    getMesh() = ofMesh::icosphere( getRadius(), getResolution() );
+    vector<float> key(3);
+    key[0] = OF_PRIMITIVE_MESH_ICOSPHERE;
+    key[1] = getRadius();
+    key[2] = getResolution();
+    setSharedMesh( key, icoSphereMesh );
     normalizeAndApplySavedTexCoords();
 }
 
@@ -485,6 +640,11 @@ int ofIcoSpherePrimitive::getResolution() {
 
 
 
+//--------------------------------------------------------------
+static ofMesh cylinderMesh(const vector<float> & key){
+    return ofMesh::cylinder( key[1], key[2], key[3], key[4], key[5], key[6]!=0, (ofPrimitiveMode)key[7] );
+}
+
 //--------------------------------------------------------------
 ofCylinderPrimitive::ofCylinderPrimitive() {
     texCoords = ofVec4f(0,0,1,1);
@@ -541,7 +701,16 @@ void ofCylinderPrimitive::set(float _radius, float _height, int radiusSegments,
     vertices[2][1] = getResolution().x * getResolution().z;
     
     
-    getMesh() = ofMesh::cylinder( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
+    vector<float> key(8);
+    key[0] = OF_PRIMITIVE_MESH_CYLINDER;
+    key[1] = getRadius();
+    key[2] = getHeight();
+    key[3] = getResolution().x;
+    key[4] = getResolution().y;
+    key[5] = getResolution().z;
+    key[6] = getCapped();
+    key[7] = mode;
+    setSharedMesh( key, cylinderMesh );
     
     normalizeAndApplySavedTexCoords();
     
@@ -589,20 +758,20 @@ void ofCylinderPrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setResolution( int radiusSegments, int heightSegments, int capSegments ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusSegments, heightSegments, capSegments, getCapped(), mode );
 }
 
 //----------------------------------------------------------
 void ofCylinderPrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
 }
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setTopCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setTopCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
@@ -610,7 +779,7 @@ void ofCylinderPrimitive::setTopCapColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setCylinderColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMode(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
@@ -618,7 +787,7 @@ void ofCylinderPrimitive::setCylinderColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setBottomCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setBottomCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[2][0], strides[2][0]+strides[2][1], color );
@@ -631,17 +800,17 @@ vector<ofIndexType> ofCylinderPrimitive::getTopCapIndices() {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getTopCapMesh() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getTopCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[0][0], strides[0][0]+strides[0][1],
+    return mesh->getMeshForIndices( strides[0][0], strides[0][0]+strides[0][1],
                              vertices[0][0], vertices[0][0]+vertices[0][1] );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getCylinderIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -649,17 +818,17 @@ vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getCylinderMesh() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[1][0], strides[1][0]+strides[1][1],
+    return mesh->getMeshForIndices( strides[1][0], strides[1][0]+strides[1][1],
                              vertices[1][0], vertices[1][0]+vertices[1][1] );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[2][0], strides[2][0] + strides[2][1] );
@@ -667,11 +836,11 @@ vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getBottomCapMesh() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( strides[2][0], strides[2][0]+strides[2][1],
+    return mesh->getMeshForIndices( strides[2][0], strides[2][0]+strides[2][1],
                              vertices[2][0], vertices[2][0]+vertices[2][1] );
 }
 
@@ -714,6 +883,11 @@ bool ofCylinderPrimitive::getCapped() {
 
 
 
+//--------------------------------------------------------------
+static ofMesh coneMesh(const vector<float> & key){
+    return ofMesh::cone( key[1], key[2], key[3], key[4], key[5], (ofPrimitiveMode)key[6] );
+}
+
 // Cone Primitive //
 //--------------------------------------------------------------
 ofConePrimitive::ofConePrimitive() {
@@ -756,7 +930,15 @@ void ofConePrimitive::set( float _radius, float _height, int radiusSegments, int
     vertices[1][0] = vertices[0][0] + vertices[0][1];
     vertices[1][1] = getResolution().x * getResolution().z;
     
-    getMesh() = ofMesh::cone( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
+    vector<float> key(7);
+    key[0] = OF_PRIMITIVE_MESH_CONE;
+    key[1] = getRadius();
+    key[2] = getHeight();
+    key[3] = getResolution().x;
+    key[4] = getResolution().y;
+    key[5] = getResolution().z;
+    key[6] = mode;
+    setSharedMesh( key, coneMesh );
     
     normalizeAndApplySavedTexCoords();
     
@@ -786,13 +968,13 @@ void ofConePrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setResolution( int radiusRes, int heightRes, int capRes ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusRes, heightRes, capRes, mode );
 }
 
 //----------------------------------------------------------
 void ofConePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
 }
@@ -811,7 +993,7 @@ void ofConePrimitive::setHeight(float _height) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setTopColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setTopColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
@@ -819,7 +1001,7 @@ void ofConePrimitive::setTopColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
@@ -827,7 +1009,7 @@ void ofConePrimitive::setCapColor( ofColor color ) {
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getConeIndices() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices(strides[0][0], strides[0][0]+strides[0][1]);
@@ -840,16 +1022,16 @@ ofMesh ofConePrimitive::getConeMesh() {
     
     int startVertIndex  = vertices[0][0];
     int endVertIndex    = startVertIndex + vertices[0][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getCapIndices() {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -862,11 +1044,11 @@ ofMesh ofConePrimitive::getCapMesh() {
     
     int startVertIndex  = vertices[1][0];
     int endVertIndex    = startVertIndex + vertices[1][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
@@ -903,6 +1085,11 @@ float ofConePrimitive::getHeight() {
 
 
 
+//--------------------------------------------------------------
+static ofMesh boxMesh(const vector<float> & key){
+    return ofMesh::box( key[1], key[2], key[3], key[4], key[5], key[6] );
+}
+
 // BOX PRIMITIVE //
 //--------------------------------------------------------------
 ofBoxPrimitive::ofBoxPrimitive() {
@@ -968,7 +1155,15 @@ void ofBoxPrimitive::set( float width, float height, float depth, int resWidth,
     vertices[SIDE_BOTTOM][0] = vertices[SIDE_TOP][0] + vertices[SIDE_TOP][1];
     vertices[SIDE_BOTTOM][1] = resZ * resX;
     
-    getMesh() = ofMesh::box( getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z );
+    vector<float> key(7);
+    key[0] = OF_PRIMITIVE_MESH_BOX;
+    key[1] = getWidth();
+    key[2] = getHeight();
+    key[3] = getDepth();
+    key[4] = getResolution().x;
+    key[5] = getResolution().y;
+    key[6] = getResolution().z;
+    setSharedMesh( key, boxMesh );
     
     normalizeAndApplySavedTexCoords();
 }
@@ -1031,7 +1226,7 @@ ofMesh ofBoxPrimitive::getSideMesh( int sideIndex ) {
     int startVertIndex  = vertices[sideIndex][0];
     int endVertIndex    = startVertIndex + vertices[sideIndex][1];
     
-    return getMesh().getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
+    return mesh->getMeshForIndices( startIndex, endIndex, startVertIndex, endVertIndex );
 }
 
 //--------------------------------------------------------------
@@ -30,8 +30,17 @@ public:
     void mapTexCoordsFromTexture( ofTexture& inTexture );
     
     
+    // primitives created with the same parameters share one mesh and vbo,
+    // the non const getters make a copy for this primitive first so it can
+    // be modified without changing the others
     ofMesh* getMeshPtr();
     ofMesh& getMesh();
+    const ofMesh* getMeshPtr() const;
+    const ofMesh& getMesh() const;
+    // the mesh used to draw the primitive, can be shared with other
+    // primitives so it shouldn't be modified
+    ofMesh& getSharedMesh();
+    bool isMeshShared() const;
     
     ofVec4f* getTexCoordsPtr();
     ofVec4f& getTexCoords();
@@ -65,10 +74,16 @@ protected:
     
     // useful when creating a new model, since it uses normalized tex coords //
     void normalizeAndApplySavedTexCoords();
+
+    // uses the mesh in the cache for key or creates it with generator. key
+    // has to contain every parameter the mesh depends on
+    void setSharedMesh( vector<float> key, ofMesh (*generator)(const vector<float> & key) );
+    void unshareMesh();
     
     ofVec4f texCoords;
     bool usingVbo;
     ofPtr<ofMesh>  mesh;
+    vector<float> meshKey;
     ofMesh normalsMesh;
     
     vector<ofIndexType> getIndices( int startIndex, int endIndex );
@@ -216,6 +216,13 @@ ofVec3f ofCamera::screenToWorld(ofVec3f ScreenXYZ, ofRectangle viewport) const {
 
 }
 
+//----------------------------------------
+ofRay ofCamera::getPickRay(const ofVec2f & screen, ofRectangle viewport) const {
+	ofVec3f nearPoint = screenToWorld(ofVec3f(screen.x, screen.y, -1), viewport);
+	ofVec3f farPoint = screenToWorld(ofVec3f(screen.x, screen.y, 1), viewport);
+	return ofRay(nearPoint, farPoint - nearPoint);
+}
+
 //----------------------------------------
 ofVec3f ofCamera::worldToCamera(ofVec3f WorldXYZ, ofRectangle viewport) const {
 	return WorldXYZ * getModelViewProjectionMatrix(viewport);
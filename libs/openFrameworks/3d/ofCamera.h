@@ -17,6 +17,7 @@
 #include "ofRectangle.h"
 #include "ofAppRunner.h"
 #include "ofNode.h"
+#include "ofRay.h"
 
 // Use the public API of ofNode for all transformations
 //class ofCamera : public ofNodeWithTarget {
@@ -65,6 +66,10 @@ public:
 	ofVec3f screenToWorld(ofVec3f ScreenXYZ, ofRectangle viewport = ofGetCurrentViewport()) const;
 	ofVec3f worldToCamera(ofVec3f WorldXYZ, ofRectangle viewport = ofGetCurrentViewport()) const;
 	ofVec3f cameraToWorld(ofVec3f CameraXYZ, ofRectangle viewport = ofGetCurrentViewport()) const;
+
+	// the ray in world space through a point on the screen, from the near
+	// to the far clip plane. use it to pick things under the mouse
+	ofRay getPickRay(const ofVec2f & screen, ofRectangle viewport = ofGetCurrentViewport()) const;
 	
 	
 protected:
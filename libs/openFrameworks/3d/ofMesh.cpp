@@ -1,5 +1,7 @@
 #include "ofMesh.h"
+#include "ofMeshFile.h"
 #include "ofGraphics.h"
+#include "ofParallel.h"
 #include <map>
 using std::map;
 
@@ -776,6 +778,14 @@ void ofMesh::append(ofMesh & mesh){
 
 //--------------------------------------------------------------
 void ofMesh::load(string path){
+	if(ofMeshFile::isMeshFile(path)){
+		ofMeshFile file(path);
+		if(file.isOpen()){
+			file.getMesh(*this);
+		}
+		return;
+	}
+
 	ofFile is(path, ofFile::ReadOnly);
 	ofMesh& data = *this;
 
@@ -996,6 +1006,11 @@ void ofMesh::load(string path){
 }
 
 void ofMesh::save(string path, bool useBinary) const{
+	if(ofToLower(ofFilePath::getFileExt(path)) == "ofmesh"){
+		ofMeshFile::save(*this, path);
+		return;
+	}
+
 	ofFile os(path, ofFile::WriteOnly);
 	const ofMesh& data = *this;
 
@@ -1179,98 +1194,211 @@ ofMesh ofMesh::getMeshForIndices( int startIndex, int endIndex, int startVertInd
     return mesh;
 }
 
+//----------------------------------------------------------
+ofMeshMergeSettings::ofMeshMergeSettings()
+:epsilon(0)
+,compareNormals(false)
+,compareTexCoords(false)
+,compareColors(false)
+,attributeEpsilon(0){}
+
+namespace{
+// finds the points close to a position without comparing against all of
+// them. points go in a uniform grid with cells twice the search distance so
+// only the cell of a position and its 7 neighbours on the closer sides have
+// to be searched, with a distance of 0 the cells are the exact positions.
+// the cells are kept in an open addressing hash table so the grid can be as
+// big as the mesh, different cells with the same key only add candidates
+// since the caller checks every candidate anyway
+class PositionGrid{
+public:
+	PositionGrid(float distance, size_t maxPoints)
+	:cellSize(distance * 2){
+		size_t tableSize = 16;
+		while(tableSize < maxPoints * 2){
+			tableSize *= 2;
+		}
+		keys.resize(tableSize);
+		heads.resize(tableSize, -1);
+		mask = tableSize - 1;
+		next.reserve(maxPoints);
+	}
+
+	// the first point inserted close to p for which match(id) returns
+	// true, or -1
+	template<typename Match>
+	int find(const ofVec3f & p, Match match) const{
+		long long cell[3];
+		int side[3];
+		getCell(p, cell, side);
+		int numCells = cellSize > 0 ? 8 : 1;
+		for(int i = 0; i < numCells; i++){
+			unsigned long long key = getKey(cell[0] + (i & 1 ? side[0] : 0), cell[1] + (i & 2 ? side[1] : 0), cell[2] + (i & 4 ? side[2] : 0));
+			for(int id = heads[getSlot(key)]; id != -1; id = next[id]){
+				if(match(id)){
+					return id;
+				}
+			}
+		}
+		return -1;
+	}
+
+	// points get consecutive ids from 0 in the order they are inserted, at
+	// most maxPoints of them
+	int insert(const ofVec3f & p){
+		long long cell[3];
+		int side[3];
+		getCell(p, cell, side);
+		unsigned long long key = getKey(cell[0], cell[1], cell[2]);
+		size_t slot = getSlot(key);
+		keys[slot] = key;
+		int id = next.size();
+		next.push_back(heads[slot]);
+		heads[slot] = id;
+		return id;
+	}
+
+private:
+	void getCell(const ofVec3f & p, long long * cell, int * side) const{
+		for(int i = 0; i < 3; i++){
+			if(cellSize > 0){
+				float position = p[i] / cellSize;
+				cell[i] = (long long)floor(position);
+				side[i] = position - cell[i] < 0.5f ? -1 : 1;
+			}else{
+				// adding 0 turns -0 into 0 so both end in the same cell
+				float value = p[i] + 0.f;
+				int bits;
+				memcpy(&bits, &value, sizeof(bits));
+				cell[i] = bits;
+				side[i] = 0;
+			}
+		}
+	}
+
+	static unsigned long long getKey(long long x, long long y, long long z){
+		unsigned long long key = (unsigned long long)x * 0x9E3779B97F4A7C15ULL
+			^ (unsigned long long)y * 0xC2B2AE3D27D4EB4FULL
+			^ (unsigned long long)z * 0x165667B19E3779F9ULL;
+		key ^= key >> 29;
+		return key;
+	}
+
+	// the slot holding key or the empty one where it should go
+	size_t getSlot(unsigned long long key) const{
+		size_t slot = key & mask;
+		while(heads[slot] != -1 && keys[slot] != key){
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	float cellSize;
+	size_t mask;
+	// a slot is empty while its head is -1
+	vector<unsigned long long> keys;
+	vector<int> heads;
+	vector<int> next;
+};
+}
+
 //----------------------------------------------------------
 void ofMesh::mergeDuplicateVertices() {
-    
-    vector<ofVec3f> verts         = getVertices();
-    vector<ofIndexType> indices   = getIndices();
-    
-    //get indexes to share single point - TODO: try j < i
-    for(unsigned int i = 0; i < indices.size(); i++) {
-        for(unsigned int j = 0; j < indices.size(); j++ ) {
-            if(i==j) continue;
-            
-            ofIndexType i1  = indices[i];
-            ofIndexType i2  = indices[j];
-            ofVec3f v1      = verts[ i1 ];
-            ofVec3f v2      = verts[ i2 ];
-            
-            if( v1 == v2 && i1 != i2) {
-                indices[j] = i1;
-                break;
-            }
-        }
-    }
-    
-    //indices array now has list of unique points we need
-    //but we need to delete the old points we're not using and that means the index values will change
-    //so we are going to create a new list of points and new indexes - we will use a map to map old index values to the new ones
-    vector <ofPoint> newPoints;
-    vector <ofIndexType> newIndexes;
-    map <int, bool> ptCreated;
-    map <int, int> oldIndexNewIndex;
-    
-    vector<ofFloatColor> newColors;
-    vector<ofFloatColor>& colors    = getColors();
-    vector<ofVec2f> newTCoords;
-    vector<ofVec2f>& tcoords        = getTexCoords();
-    vector<ofVec3f> newNormals;
-    vector<ofVec3f>& normals        = getNormals();
-    
-    for(unsigned int i = 0; i < indices.size(); i++){
-        ptCreated[i] = false;
-    }
-    
-    for(unsigned int i = 0; i < indices.size(); i++){
-        ofIndexType index = indices[i];
-        ofPoint p = verts[ index ];
-        
-        if( ptCreated[index] == false ){
-            oldIndexNewIndex[index] = newPoints.size();
-            newPoints.push_back( p );
-            if(hasColors()) {
-                newColors.push_back(colors[index]);
-            }
-            if(hasTexCoords()) {
-                newTCoords.push_back(tcoords[index]);
-            }
-            if(hasNormals()) {
-                newNormals.push_back(normals[index]);
-            }
-            
-            ptCreated[index] = true;
-        }
-        
-        //ofLogNotice("ofMesh") << "[" << i << "]: old " << index << " --> " << oldIndexNewIndex[index];
-        newIndexes.push_back( oldIndexNewIndex[index] );
-    }
-    
-    verts.clear();
-    verts = newPoints;
-    
-    indices.clear();
-    indices = newIndexes;
-    
-    clearIndices();
-    addIndices(indices);
-    clearVertices();
-    addVertices( verts );
-    
-    if(hasColors()) {
-        clearColors();
-        addColors( newColors );
-    }
-    
-    if(hasTexCoords()) {
-        clearTexCoords();
-        addTexCoords( newTCoords );
-    }
-    
-    if(hasNormals()) {
-        clearNormals();
-        addNormals( newNormals );
-    }
-    
+	mergeDuplicateVertices(ofMeshMergeSettings());
+}
+
+//----------------------------------------------------------
+void ofMesh::mergeDuplicateVertices(const ofMeshMergeSettings & settings) {
+	if(vertices.empty()){
+		return;
+	}
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= vertices.size()){
+			ofLogError("ofMesh") << "mergeDuplicateVertices(): index " << i << " points to vertex " << indices[i] << " but there's only " << vertices.size();
+			return;
+		}
+	}
+
+	bool bHasColors     = hasColors();
+	bool bHasNormals    = hasNormals();
+	bool bHasTexcoords  = hasTexCoords();
+	bool bCompareColors     = bHasColors && settings.compareColors;
+	bool bCompareNormals    = bHasNormals && settings.compareNormals;
+	bool bCompareTexcoords  = bHasTexcoords && settings.compareTexCoords;
+	float epsilon2 = settings.epsilon * settings.epsilon;
+	float attributeEpsilon = settings.attributeEpsilon;
+	float attributeEpsilon2 = attributeEpsilon * attributeEpsilon;
+
+	// vertices not used by the indices are dropped
+	vector<bool> used;
+	if(hasIndices()){
+		used.resize(vertices.size(), false);
+		for(unsigned int i = 0; i < indices.size(); i++){
+			used[indices[i]] = true;
+		}
+	}
+
+	vector<ofVec3f> newVertices;
+	vector<ofFloatColor> newColors;
+	vector<ofVec3f> newNormals;
+	vector<ofVec2f> newTexCoords;
+	vector<ofIndexType> newIndex(vertices.size());
+
+	PositionGrid grid(settings.epsilon, vertices.size());
+	for(unsigned int i = 0; i < vertices.size(); i++){
+		if(!used.empty() && !used[i]){
+			continue;
+		}
+		const ofVec3f & v = vertices[i];
+		int merged = grid.find(v, [&](int j){
+			if(newVertices[j].squareDistance(v) > epsilon2){
+				return false;
+			}
+			if(bCompareNormals && newNormals[j].squareDistance(normals[i]) > attributeEpsilon2){
+				return false;
+			}
+			if(bCompareTexcoords && newTexCoords[j].squareDistance(texCoords[i]) > attributeEpsilon2){
+				return false;
+			}
+			if(bCompareColors){
+				const ofFloatColor & a = newColors[j];
+				const ofFloatColor & b = colors[i];
+				if(fabs(a.r - b.r) > attributeEpsilon || fabs(a.g - b.g) > attributeEpsilon
+					|| fabs(a.b - b.b) > attributeEpsilon || fabs(a.a - b.a) > attributeEpsilon){
+					return false;
+				}
+			}
+			return true;
+		});
+		if(merged == -1){
+			merged = grid.insert(v);
+			newVertices.push_back(v);
+			if(bHasColors) newColors.push_back(colors[i]);
+			if(bHasNormals) newNormals.push_back(normals[i]);
+			if(bHasTexcoords) newTexCoords.push_back(texCoords[i]);
+		}
+		newIndex[i] = merged;
+	}
+
+	if(hasIndices()){
+		for(unsigned int i = 0; i < indices.size(); i++){
+			indices[i] = newIndex[indices[i]];
+		}
+	}else{
+		indices = newIndex;
+	}
+
+	vertices.swap(newVertices);
+	colors.swap(newColors);
+	normals.swap(newNormals);
+	texCoords.swap(newTexCoords);
+
+	bVertsChanged = true;
+	bColorsChanged = true;
+	bNormalsChanged = true;
+	bTexCoordsChanged = true;
+	bIndicesChanged = true;
+	bFacesDirty = true;
 }
 
 //----------------------------------------------------------
@@ -1405,104 +1533,134 @@ void ofMesh::setFromTriangles( const vector<ofMeshFace>& tris, bool bUseFaceNorm
 
 //----------------------------------------------------------
 void ofMesh::smoothNormals( float angle ) {
-    
-    if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-        vector<ofMeshFace> triangles = getUniqueFaces();
-        vector<ofVec3f> verts;
-        for(unsigned int i = 0; i < triangles.size(); i++) {
-            for(unsigned int j = 0; j < 3; j++) {
-                verts.push_back( triangles[i].getVertex(j) );
-            }
-        }
-        
-        map<int, int> removeIds;
-        
-        float epsilon = .01f;
-        for(unsigned int i = 0; i < verts.size()-1; i++) {
-            for(unsigned int j = i+1; j < verts.size(); j++) {
-                if(i != j) {
-                    ofVec3f& v1 = verts[i];
-                    ofVec3f& v2 = verts[j];
-                    if( v1.distance(v2) <= epsilon ) {
-                        // average the location //
-                        verts[i] = (v1+v2)/2.f;
-                        verts[j] = verts[i];
-                        removeIds[j] = 1;
-                    }
-                }
-            }
-        }
-        
-        // string of vertex in 3d space to triangle index //
-        map<string, vector<int> > vertHash;
-        
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
-        
-        string xStr, yStr, zStr;
-        
-        for(unsigned int i = 0; i < verts.size(); i++ ) {
-            xStr = "x"+ofToString(verts[i].x==-0?0:verts[i].x);
-            yStr = "y"+ofToString(verts[i].y==-0?0:verts[i].y);
-            zStr = "z"+ofToString(verts[i].z==-0?0:verts[i].z);
-            string vstring = xStr+yStr+zStr;
-            if(vertHash.find(vstring) == vertHash.end()) {
-                for(unsigned int j = 0; j < triangles.size(); j++) {
-                    for(unsigned int k = 0; k < 3; k++) {
-                        if(verts[i].x == triangles[j].getVertex(k).x) {
-                            if(verts[i].y == triangles[j].getVertex(k).y) {
-                                if(verts[i].z == triangles[j].getVertex(k).z) {
-                                    vertHash[vstring].push_back( j );
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-//        for( map<string, vector<int> >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//            //for( map<string, int >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//            ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
-//        }
-        
-        
-        ofVec3f normal;
-        float angleCos = cos(angle * DEG_TO_RAD );
-        float numNormals=0;
-        ofVec3f f1, f2;
-        ofVec3f vert;
-        
-        for(unsigned int j = 0; j < triangles.size(); j++) {
-            for(unsigned int k = 0; k < 3; k++) {
-                vert = triangles[j].getVertex(k);
-                xStr = "x"+ofToString(vert.x==-0?0:vert.x);
-                yStr = "y"+ofToString(vert.y==-0?0:vert.y);
-                zStr = "z"+ofToString(vert.z==-0?0:vert.z);
-                
-                string vstring = xStr+yStr+zStr;
-                numNormals=0;
-                normal.set(0,0,0);
-                if(vertHash.find(vstring) != vertHash.end()) {
-                    for(unsigned int i = 0; i < vertHash[vstring].size(); i++) {
-                        f1 = triangles[j].getFaceNormal();
-                        f2 = triangles[vertHash[vstring][i]].getFaceNormal();
-                        if(f1.dot(f2) >= angleCos ) {
-                            normal += f2;
-                            numNormals+=1.f;
-                        }
-                    }
-                    //normal /= (float)vertHash[vstring].size();
-                    normal /= numNormals;
-                    
-                    triangles[j].setNormal(k, normal);
-                }
-            }
-        }
-        
-        //ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
-        setFromTriangles( triangles );
-        
-    }
+	if( getMode() != OF_PRIMITIVE_TRIANGLES || vertices.empty() ) {
+		return;
+	}
+	if(!hasIndices()){
+		setupIndicesAuto();
+	}
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= vertices.size()){
+			ofLogError("ofMesh") << "smoothNormals(): index " << i << " points to vertex " << indices[i] << " but there's only " << vertices.size();
+			return;
+		}
+	}
+	int numFaces = indices.size() / 3;
+
+	vector<ofVec3f> faceNormals(numFaces);
+	ofParallelFor(0, numFaces, [&](int begin, int end){
+		for(int face = begin; face < end; face++){
+			const ofVec3f & v0 = vertices[indices[face*3]];
+			faceNormals[face] = (vertices[indices[face*3+1]] - v0).getCrossed(vertices[indices[face*3+2]] - v0).getNormalized();
+		}
+	}, 4096);
+
+	// vertices at the same position share their faces even if they have
+	// different indices, like the seams of a uv mapped mesh
+	const float epsilon = .01f;
+	vector<int> positionGroup(vertices.size());
+	vector<ofVec3f> groupPositions;
+	PositionGrid grid(epsilon, vertices.size());
+	for(unsigned int i = 0; i < vertices.size(); i++){
+		const ofVec3f & v = vertices[i];
+		int group = grid.find(v, [&](int j){
+			return groupPositions[j].squareDistance(v) <= epsilon * epsilon;
+		});
+		if(group == -1){
+			group = grid.insert(v);
+			groupPositions.push_back(v);
+		}
+		positionGroup[i] = group;
+	}
+
+	// the faces around each position are groupFaces[groupStart[group]] to
+	// groupFaces[groupStart[group+1]]
+	vector<int> groupStart(groupPositions.size() + 1, 0);
+	for(unsigned int i = 0; i < indices.size(); i++){
+		groupStart[positionGroup[indices[i]] + 1]++;
+	}
+	for(unsigned int i = 1; i < groupStart.size(); i++){
+		groupStart[i] += groupStart[i-1];
+	}
+	vector<int> groupFaces(indices.size());
+	vector<int> groupEnd(groupStart.begin(), groupStart.end() - 1);
+	for(unsigned int i = 0; i < indices.size(); i++){
+		groupFaces[groupEnd[positionGroup[indices[i]]]++] = i / 3;
+	}
+
+	// every corner averages the faces around it that are within angle of its own
+	float angleCos = cos(angle * DEG_TO_RAD);
+	vector<ofVec3f> cornerNormals(indices.size());
+	ofParallelFor(0, numFaces, [&](int begin, int end){
+		for(int face = begin; face < end; face++){
+			const ofVec3f & faceNormal = faceNormals[face];
+			for(int k = 0; k < 3; k++){
+				int group = positionGroup[indices[face*3+k]];
+				ofVec3f normal;
+				for(int i = groupStart[group]; i < groupStart[group+1]; i++){
+					const ofVec3f & otherNormal = faceNormals[groupFaces[i]];
+					if(faceNormal.dot(otherNormal) >= angleCos){
+						normal += otherNormal;
+					}
+				}
+				cornerNormals[face*3+k] = normal.getNormalized();
+			}
+		}
+	}, 1024);
+
+	// corners of one vertex usually get the same normal, the ones across a
+	// crease get their own copy of the vertex. copies of a vertex are linked
+	// through nextCopy
+	bool bHasColors     = colors.size() == vertices.size();
+	bool bHasTexcoords  = texCoords.size() == vertices.size();
+	unsigned int numVertices = vertices.size();
+	normals.resize(numVertices);
+	vector<bool> hasNormal(numVertices, false);
+	vector<int> nextCopy(numVertices, -1);
+	for(unsigned int i = 0; i < indices.size(); i++){
+		ofIndexType index = indices[i];
+		const ofVec3f & normal = cornerNormals[i];
+		if(!hasNormal[index]){
+			normals[index] = normal;
+			hasNormal[index] = true;
+			continue;
+		}
+		int last = index;
+		int found = -1;
+		for(int copy = index; copy != -1; copy = nextCopy[copy]){
+			if(normals[copy] == normal){
+				found = copy;
+				break;
+			}
+			last = copy;
+		}
+		if(found == -1){
+			found = vertices.size();
+			ofVec3f vertex = vertices[index];
+			vertices.push_back(vertex);
+			normals.push_back(normal);
+			if(bHasColors){
+				ofFloatColor color = colors[index];
+				colors.push_back(color);
+			}
+			if(bHasTexcoords){
+				ofVec2f texCoord = texCoords[index];
+				texCoords.push_back(texCoord);
+			}
+			nextCopy.push_back(-1);
+			nextCopy[last] = found;
+		}
+		indices[i] = found;
+	}
+
+	if(vertices.size() != numVertices){
+		bVertsChanged = true;
+		if(bHasColors) bColorsChanged = true;
+		if(bHasTexcoords) bTexCoordsChanged = true;
+	}
+	bNormalsChanged = true;
+	bIndicesChanged = true;
+	bFacesDirty = true;
 }
 
 // PLANE MESH //
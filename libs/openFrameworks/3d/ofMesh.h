@@ -16,6 +16,23 @@ typedef TESSindex ofIndexType;
 
 class ofMeshFace;
 
+// what ofMesh::mergeDuplicateVertices considers the same vertex
+class ofMeshMergeSettings{
+public:
+	ofMeshMergeSettings();
+
+	// positions closer than this are merged, 0 merges only equal positions
+	float epsilon;
+
+	// by default only positions are compared and the merged vertex keeps the
+	// attributes of the first one. with these set, vertices are only merged
+	// if their normals, texcoords or colors are also within attributeEpsilon
+	bool compareNormals;
+	bool compareTexCoords;
+	bool compareColors;
+	float attributeEpsilon;
+};
+
 class ofMesh{
 public:
 	
@@ -125,6 +142,8 @@ public:
 	void drawFaces();
 	void draw();
 
+	// .ofmesh files are read and written with ofMeshFile, anything else is
+	// ply. useBinary only applies to ply
 	void load(string path);
 	void save(string path, bool useBinary = false) const;
     
@@ -148,11 +167,18 @@ public:
     void setColorForIndices( int startIndex, int endIndex, ofColor color );
     ofMesh getMeshForIndices( int startIndex, int endIndex ) const;
     ofMesh getMeshForIndices( int startIndex, int endIndex, int startVertIndex, int endVertIndex ) const;
+    // welds vertices at the same position into one and points the indices
+    // to it, vertices not used by any index are removed. meshes without
+    // indices get them. runs in linear time using a hash of the positions
     void mergeDuplicateVertices();
+    void mergeDuplicateVertices(const ofMeshMergeSettings & settings);
     // return a list of triangles that do not share vertices or indices //
     const vector<ofMeshFace> & getUniqueFaces() const;
     vector<ofVec3f> getFaceNormals( bool perVetex=false) const;
     void setFromTriangles( const vector<ofMeshFace>& tris, bool bUseFaceNormal=false );
+    // sets each vertex normal to the average of the faces around it that
+    // are within angle degrees of each other. vertices on sharper edges are
+    // split so each side gets its own normal, the mesh stays indexed
     void smoothNormals( float angle );
     
     static ofMesh plane(float width, float height, int columns=2, int rows=2, ofPrimitiveMode mode=OF_PRIMITIVE_TRIANGLE_STRIP);
@@ -0,0 +1,611 @@
+#include "ofMeshBVH.h"
+#include <algorithm>
+
+static const int maxLeafTriangles = 4;
+static const int numBins = 16;
+
+//----------------------------------------------------------
+ofMeshBVHHit::ofMeshBVHHit()
+:found(false)
+,triangle(-1)
+,distance(std::numeric_limits<float>::max()){}
+
+namespace{
+float getHalfArea(const ofVec3f & min, const ofVec3f & max){
+	ofVec3f size = max - min;
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+void growBounds(ofVec3f & min, ofVec3f & max, const ofVec3f & p){
+	min.x = MIN(min.x, p.x); min.y = MIN(min.y, p.y); min.z = MIN(min.z, p.z);
+	max.x = MAX(max.x, p.x); max.y = MAX(max.y, p.y); max.z = MAX(max.z, p.z);
+}
+
+void emptyBounds(ofVec3f & min, ofVec3f & max){
+	float big = std::numeric_limits<float>::max();
+	min.set(big, big, big);
+	max.set(-big, -big, -big);
+}
+
+// distance along the ray where it enters the box, or infinity if it misses it
+float intersectBox(const ofVec3f & min, const ofVec3f & max, const ofVec3f & origin, const ofVec3f & inverseDirection, float maxDistance){
+	float t0 = (min.x - origin.x) * inverseDirection.x;
+	float t1 = (max.x - origin.x) * inverseDirection.x;
+	float near = MIN(t0, t1), far = MAX(t0, t1);
+	t0 = (min.y - origin.y) * inverseDirection.y;
+	t1 = (max.y - origin.y) * inverseDirection.y;
+	near = MAX(near, MIN(t0, t1)); far = MIN(far, MAX(t0, t1));
+	t0 = (min.z - origin.z) * inverseDirection.z;
+	t1 = (max.z - origin.z) * inverseDirection.z;
+	near = MAX(near, MIN(t0, t1)); far = MIN(far, MAX(t0, t1));
+	if(near > far || far < 0 || near > maxDistance){
+		return std::numeric_limits<float>::infinity();
+	}
+	return MAX(near, 0.f);
+}
+
+// moller trumbore, both sides
+bool intersectTriangle(const ofRay & ray, const ofVec3f & a, const ofVec3f & b, const ofVec3f & c, float & distance, ofVec2f & barycentric){
+	ofVec3f ab = b - a;
+	ofVec3f ac = c - a;
+	ofVec3f p = ray.direction.getCrossed(ac);
+	float determinant = ab.dot(p);
+	if(fabs(determinant) < 1e-12f){
+		return false;
+	}
+	float inverse = 1.f / determinant;
+	ofVec3f t = ray.origin - a;
+	float u = t.dot(p) * inverse;
+	if(u < 0 || u > 1){
+		return false;
+	}
+	ofVec3f q = t.getCrossed(ab);
+	float v = ray.direction.dot(q) * inverse;
+	if(v < 0 || u + v > 1){
+		return false;
+	}
+	float d = ac.dot(q) * inverse;
+	if(d < 0){
+		return false;
+	}
+	distance = d;
+	barycentric.set(u, v);
+	return true;
+}
+
+// from Ericson, "Real-Time Collision Detection" 5.1.5
+ofVec3f getClosestPointOnTriangle(const ofVec3f & p, const ofVec3f & a, const ofVec3f & b, const ofVec3f & c, ofVec2f & barycentric){
+	ofVec3f ab = b - a, ac = c - a, ap = p - a;
+	float d1 = ab.dot(ap), d2 = ac.dot(ap);
+	if(d1 <= 0 && d2 <= 0){
+		barycentric.set(0, 0);
+		return a;
+	}
+	ofVec3f bp = p - b;
+	float d3 = ab.dot(bp), d4 = ac.dot(bp);
+	if(d3 >= 0 && d4 <= d3){
+		barycentric.set(1, 0);
+		return b;
+	}
+	float vc = d1 * d4 - d3 * d2;
+	if(vc <= 0 && d1 >= 0 && d3 <= 0){
+		float v = d1 / (d1 - d3);
+		barycentric.set(v, 0);
+		return a + ab * v;
+	}
+	ofVec3f cp = p - c;
+	float d5 = ab.dot(cp), d6 = ac.dot(cp);
+	if(d6 >= 0 && d5 <= d6){
+		barycentric.set(0, 1);
+		return c;
+	}
+	float vb = d5 * d2 - d1 * d6;
+	if(vb <= 0 && d2 >= 0 && d6 <= 0){
+		float w = d2 / (d2 - d6);
+		barycentric.set(0, w);
+		return a + ac * w;
+	}
+	float va = d3 * d6 - d5 * d4;
+	if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0){
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		barycentric.set(1 - w, w);
+		return b + (c - b) * w;
+	}
+	float denominator = 1.f / (va + vb + vc);
+	float v = vb * denominator;
+	float w = vc * denominator;
+	barycentric.set(v, w);
+	return a + ab * v + ac * w;
+}
+
+float getSquareDistanceToBox(const ofVec3f & p, const ofVec3f & min, const ofVec3f & max){
+	float dx = MAX(MAX(min.x - p.x, 0.f), p.x - max.x);
+	float dy = MAX(MAX(min.y - p.y, 0.f), p.y - max.y);
+	float dz = MAX(MAX(min.z - p.z, 0.f), p.z - max.z);
+	return dx * dx + dy * dy + dz * dz;
+}
+
+bool boxesOverlap(const ofVec3f & min0, const ofVec3f & max0, const ofVec3f & min1, const ofVec3f & max1){
+	return min0.x <= max1.x && max0.x >= min1.x
+		&& min0.y <= max1.y && max0.y >= min1.y
+		&& min0.z <= max1.z && max0.z >= min1.z;
+}
+
+// separating axis test with the box centered at the origin
+bool isSeparatingAxis(const ofVec3f & axis, const ofVec3f & a, const ofVec3f & b, const ofVec3f & c, const ofVec3f & halfSize){
+	float pa = axis.dot(a), pb = axis.dot(b), pc = axis.dot(c);
+	float radius = halfSize.x * fabs(axis.x) + halfSize.y * fabs(axis.y) + halfSize.z * fabs(axis.z);
+	return MIN(pa, MIN(pb, pc)) > radius || MAX(pa, MAX(pb, pc)) < -radius;
+}
+
+// from Akenine-Moller, "Fast 3D Triangle-Box Overlap Testing"
+bool triangleOverlapsBox(const ofVec3f & a, const ofVec3f & b, const ofVec3f & c, const ofVec3f & min, const ofVec3f & max){
+	ofVec3f triangleMin = a, triangleMax = a;
+	growBounds(triangleMin, triangleMax, b);
+	growBounds(triangleMin, triangleMax, c);
+	if(!boxesOverlap(triangleMin, triangleMax, min, max)){
+		return false;
+	}
+	ofVec3f center = (min + max) * .5;
+	ofVec3f halfSize = (max - min) * .5;
+	ofVec3f v0 = a - center, v1 = b - center, v2 = c - center;
+	ofVec3f edges[3] = {v1 - v0, v2 - v1, v0 - v2};
+	if(isSeparatingAxis(edges[0].getCrossed(edges[1]), v0, v1, v2, halfSize)){
+		return false;
+	}
+	const ofVec3f boxAxes[3] = {ofVec3f(1, 0, 0), ofVec3f(0, 1, 0), ofVec3f(0, 0, 1)};
+	for(int i = 0; i < 3; i++){
+		for(int j = 0; j < 3; j++){
+			if(isSeparatingAxis(edges[i].getCrossed(boxAxes[j]), v0, v1, v2, halfSize)){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+}
+
+//----------------------------------------------------------
+ofMeshBVH::ofMeshBVH()
+:bIndexed(false){}
+
+//----------------------------------------------------------
+bool ofMeshBVH::build(const ofMesh & mesh){
+	clear();
+	if(mesh.getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogError("ofMeshBVH") << "build(): only meshes with OF_PRIMITIVE_TRIANGLES are supported";
+		return false;
+	}
+	const vector<ofIndexType> & meshIndices = mesh.getIndices();
+	for(unsigned int i = 0; i < meshIndices.size(); i++){
+		if(meshIndices[i] >= (unsigned int)mesh.getNumVertices()){
+			ofLogError("ofMeshBVH") << "build(): index " << i << " points to vertex " << meshIndices[i] << " but there's only " << mesh.getNumVertices();
+			return false;
+		}
+	}
+
+	vertices = mesh.getVertices();
+	bIndexed = mesh.hasIndices();
+	if(bIndexed){
+		indices = meshIndices;
+	}
+	int numTriangles = (bIndexed ? indices.size() : vertices.size()) / 3;
+	if(numTriangles == 0){
+		clear();
+		return false;
+	}
+
+	vector<ofVec3f> centroids(numTriangles);
+	vector<ofVec3f> triangleMin(numTriangles);
+	vector<ofVec3f> triangleMax(numTriangles);
+	triangles.resize(numTriangles);
+	for(int t = 0; t < numTriangles; t++){
+		ofVec3f a, b, c;
+		getTriangle(t, a, b, c);
+		triangleMin[t] = triangleMax[t] = a;
+		growBounds(triangleMin[t], triangleMax[t], b);
+		growBounds(triangleMin[t], triangleMax[t], c);
+		centroids[t] = (triangleMin[t] + triangleMax[t]) * .5;
+		triangles[t] = t;
+	}
+
+	nodes.reserve(numTriangles * 2 / maxLeafTriangles + 1);
+	nodes.push_back(Node());
+	buildNode(0, 0, numTriangles, centroids, triangleMin, triangleMax);
+	return true;
+}
+
+//----------------------------------------------------------
+void ofMeshBVH::buildNode(int node, int start, int count, vector<ofVec3f> & centroids, vector<ofVec3f> & triangleMin, vector<ofVec3f> & triangleMax){
+	ofVec3f min, max, centroidMin, centroidMax;
+	emptyBounds(min, max);
+	emptyBounds(centroidMin, centroidMax);
+	for(int i = start; i < start + count; i++){
+		int t = triangles[i];
+		growBounds(min, max, triangleMin[t]);
+		growBounds(min, max, triangleMax[t]);
+		growBounds(centroidMin, centroidMax, centroids[t]);
+	}
+	nodes[node].min = min;
+	nodes[node].max = max;
+	nodes[node].start = start;
+	nodes[node].count = count;
+	if(count <= maxLeafTriangles){
+		return;
+	}
+
+	// the split between bins with the lowest surface area heuristic on any axis
+	float bestCost = std::numeric_limits<float>::max();
+	int bestAxis = -1;
+	int bestSplit = 0;
+	for(int axis = 0; axis < 3; axis++){
+		float extent = centroidMax[axis] - centroidMin[axis];
+		if(extent <= 0){
+			continue;
+		}
+		float binScale = numBins / extent;
+		int binCounts[numBins] = {0};
+		ofVec3f binMin[numBins], binMax[numBins];
+		for(int b = 0; b < numBins; b++){
+			emptyBounds(binMin[b], binMax[b]);
+		}
+		for(int i = start; i < start + count; i++){
+			int t = triangles[i];
+			int b = MIN(numBins - 1, int((centroids[t][axis] - centroidMin[axis]) * binScale));
+			binCounts[b]++;
+			growBounds(binMin[b], binMax[b], triangleMin[t]);
+			growBounds(binMin[b], binMax[b], triangleMax[t]);
+		}
+		// cost of everything right of each split, then sweep from the left
+		float rightCost[numBins];
+		ofVec3f sweepMin, sweepMax;
+		emptyBounds(sweepMin, sweepMax);
+		int sweepCount = 0;
+		for(int b = numBins - 1; b > 0; b--){
+			sweepCount += binCounts[b];
+			if(binCounts[b]){
+				growBounds(sweepMin, sweepMax, binMin[b]);
+				growBounds(sweepMin, sweepMax, binMax[b]);
+			}
+			rightCost[b] = sweepCount ? getHalfArea(sweepMin, sweepMax) * sweepCount : 0;
+		}
+		emptyBounds(sweepMin, sweepMax);
+		sweepCount = 0;
+		for(int b = 0; b < numBins - 1; b++){
+			sweepCount += binCounts[b];
+			if(binCounts[b]){
+				growBounds(sweepMin, sweepMax, binMin[b]);
+				growBounds(sweepMin, sweepMax, binMax[b]);
+			}
+			if(sweepCount == 0 || sweepCount == count){
+				continue;
+			}
+			float cost = getHalfArea(sweepMin, sweepMax) * sweepCount + rightCost[b + 1];
+			if(cost < bestCost){
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b + 1;
+			}
+		}
+	}
+
+	// all the centroids in the same place, nothing to split
+	if(bestAxis == -1){
+		return;
+	}
+	// splitting costs more than testing every triangle
+	float leafCost = getHalfArea(min, max) * count;
+	if(count <= maxLeafTriangles * 4 && bestCost >= leafCost){
+		return;
+	}
+
+	float binScale = numBins / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+	int * middle = std::partition(&triangles[start], &triangles[start] + count, [&](int t){
+		return MIN(numBins - 1, int((centroids[t][bestAxis] - centroidMin[bestAxis]) * binScale)) < bestSplit;
+	});
+	int leftCount = middle - &triangles[start];
+
+	int children = nodes.size();
+	nodes.push_back(Node());
+	nodes.push_back(Node());
+	nodes[node].start = children;
+	nodes[node].count = 0;
+	buildNode(children, start, leftCount, centroids, triangleMin, triangleMax);
+	buildNode(children + 1, start + leftCount, count - leftCount, centroids, triangleMin, triangleMax);
+}
+
+//----------------------------------------------------------
+bool ofMeshBVH::refit(const ofMesh & mesh){
+	if(!isBuilt()){
+		return build(mesh);
+	}
+	if(mesh.getNumVertices() != (int)vertices.size() || (bIndexed && mesh.getNumIndices() != (int)indices.size()) || (!bIndexed && mesh.hasIndices())){
+		ofLogError("ofMeshBVH") << "refit(): the mesh has a different number of vertices or indices, call build() instead";
+		return false;
+	}
+	vertices = mesh.getVertices();
+	if(bIndexed){
+		indices = mesh.getIndices();
+	}
+	// children always come after their parent
+	for(int node = nodes.size() - 1; node >= 0; node--){
+		updateBounds(node);
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+void ofMeshBVH::updateBounds(int node){
+	Node & n = nodes[node];
+	emptyBounds(n.min, n.max);
+	if(n.count > 0){
+		for(int i = n.start; i < n.start + n.count; i++){
+			ofVec3f a, b, c;
+			getTriangle(triangles[i], a, b, c);
+			growBounds(n.min, n.max, a);
+			growBounds(n.min, n.max, b);
+			growBounds(n.min, n.max, c);
+		}
+	}else{
+		for(int child = n.start; child < n.start + 2; child++){
+			growBounds(n.min, n.max, nodes[child].min);
+			growBounds(n.min, n.max, nodes[child].max);
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofMeshBVH::clear(){
+	nodes.clear();
+	triangles.clear();
+	vertices.clear();
+	indices.clear();
+	bIndexed = false;
+}
+
+//----------------------------------------------------------
+bool ofMeshBVH::isBuilt() const{
+	return !nodes.empty();
+}
+
+//----------------------------------------------------------
+int ofMeshBVH::getNumTriangles() const{
+	return triangles.size();
+}
+
+//----------------------------------------------------------
+int ofMeshBVH::getNumNodes() const{
+	return nodes.size();
+}
+
+//----------------------------------------------------------
+ofVec3f ofMeshBVH::getMin() const{
+	return nodes.empty() ? ofVec3f() : nodes[0].min;
+}
+
+//----------------------------------------------------------
+ofVec3f ofMeshBVH::getMax() const{
+	return nodes.empty() ? ofVec3f() : nodes[0].max;
+}
+
+//----------------------------------------------------------
+void ofMeshBVH::getTriangle(int triangle, ofVec3f & a, ofVec3f & b, ofVec3f & c) const{
+	if(bIndexed){
+		a = vertices[indices[triangle*3]];
+		b = vertices[indices[triangle*3+1]];
+		c = vertices[indices[triangle*3+2]];
+	}else{
+		a = vertices[triangle*3];
+		b = vertices[triangle*3+1];
+		c = vertices[triangle*3+2];
+	}
+}
+
+//----------------------------------------------------------
+ofMeshBVHHit ofMeshBVH::intersect(const ofRay & ray, float maxDistance) const{
+	ofMeshBVHHit hit;
+	if(nodes.empty()){
+		return hit;
+	}
+	ofVec3f inverseDirection(1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z);
+	float closest = maxDistance;
+
+	vector<int> stack;
+	stack.reserve(64);
+	if(intersectBox(nodes[0].min, nodes[0].max, ray.origin, inverseDirection, closest) <= closest){
+		stack.push_back(0);
+	}
+	while(!stack.empty()){
+		const Node & node = nodes[stack.back()];
+		stack.pop_back();
+		if(node.count > 0){
+			for(int i = node.start; i < node.start + node.count; i++){
+				ofVec3f a, b, c;
+				getTriangle(triangles[i], a, b, c);
+				float distance;
+				ofVec2f barycentric;
+				if(intersectTriangle(ray, a, b, c, distance, barycentric) && distance <= closest){
+					closest = distance;
+					hit.found = true;
+					hit.triangle = triangles[i];
+					hit.distance = distance;
+					hit.barycentric = barycentric;
+				}
+			}
+		}else{
+			// the nearer child goes on top so it's visited first
+			float left = intersectBox(nodes[node.start].min, nodes[node.start].max, ray.origin, inverseDirection, closest);
+			float right = intersectBox(nodes[node.start+1].min, nodes[node.start+1].max, ray.origin, inverseDirection, closest);
+			int first = node.start, second = node.start + 1;
+			if(right < left){
+				std::swap(left, right);
+				std::swap(first, second);
+			}
+			if(right <= closest){
+				stack.push_back(second);
+			}
+			if(left <= closest){
+				stack.push_back(first);
+			}
+		}
+	}
+	if(hit.found){
+		hit.position = ray.getPoint(hit.distance);
+	}
+	return hit;
+}
+
+//----------------------------------------------------------
+bool ofMeshBVH::intersectsAny(const ofRay & ray, float maxDistance) const{
+	if(nodes.empty()){
+		return false;
+	}
+	ofVec3f inverseDirection(1.f / ray.direction.x, 1.f / ray.direction.y, 1.f / ray.direction.z);
+	vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const Node & node = nodes[stack.back()];
+		stack.pop_back();
+		if(intersectBox(node.min, node.max, ray.origin, inverseDirection, maxDistance) > maxDistance){
+			continue;
+		}
+		if(node.count > 0){
+			for(int i = node.start; i < node.start + node.count; i++){
+				ofVec3f a, b, c;
+				getTriangle(triangles[i], a, b, c);
+				float distance;
+				ofVec2f barycentric;
+				if(intersectTriangle(ray, a, b, c, distance, barycentric) && distance <= maxDistance){
+					return true;
+				}
+			}
+		}else{
+			stack.push_back(node.start + 1);
+			stack.push_back(node.start);
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+ofMeshBVHHit ofMeshBVH::getNearestPoint(const ofVec3f & point, float maxDistance) const{
+	ofMeshBVHHit hit;
+	if(nodes.empty()){
+		return hit;
+	}
+	float closest = maxDistance < std::numeric_limits<float>::max() ? maxDistance * maxDistance : maxDistance;
+
+	vector<std::pair<float,int> > stack;
+	stack.reserve(64);
+	stack.push_back(std::make_pair(getSquareDistanceToBox(point, nodes[0].min, nodes[0].max), 0));
+	while(!stack.empty()){
+		std::pair<float,int> top = stack.back();
+		stack.pop_back();
+		// something closer was found since this was queued
+		if(top.first > closest){
+			continue;
+		}
+		const Node & node = nodes[top.second];
+		if(node.count > 0){
+			for(int i = node.start; i < node.start + node.count; i++){
+				ofVec3f a, b, c;
+				getTriangle(triangles[i], a, b, c);
+				ofVec2f barycentric;
+				ofVec3f onTriangle = getClosestPointOnTriangle(point, a, b, c, barycentric);
+				float distance = onTriangle.squareDistance(point);
+				if(distance <= closest){
+					closest = distance;
+					hit.found = true;
+					hit.triangle = triangles[i];
+					hit.position = onTriangle;
+					hit.barycentric = barycentric;
+				}
+			}
+		}else{
+			float left = getSquareDistanceToBox(point, nodes[node.start].min, nodes[node.start].max);
+			float right = getSquareDistanceToBox(point, nodes[node.start+1].min, nodes[node.start+1].max);
+			int first = node.start, second = node.start + 1;
+			if(right < left){
+				std::swap(left, right);
+				std::swap(first, second);
+			}
+			if(right <= closest){
+				stack.push_back(std::make_pair(right, second));
+			}
+			if(left <= closest){
+				stack.push_back(std::make_pair(left, first));
+			}
+		}
+	}
+	if(hit.found){
+		hit.distance = sqrt(closest);
+	}
+	return hit;
+}
+
+//----------------------------------------------------------
+vector<int> ofMeshBVH::getTrianglesInBox(const ofVec3f & min, const ofVec3f & max) const{
+	vector<int> found;
+	if(nodes.empty()){
+		return found;
+	}
+	vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const Node & node = nodes[stack.back()];
+		stack.pop_back();
+		if(!boxesOverlap(node.min, node.max, min, max)){
+			continue;
+		}
+		if(node.count > 0){
+			for(int i = node.start; i < node.start + node.count; i++){
+				ofVec3f a, b, c;
+				getTriangle(triangles[i], a, b, c);
+				if(triangleOverlapsBox(a, b, c, min, max)){
+					found.push_back(triangles[i]);
+				}
+			}
+		}else{
+			stack.push_back(node.start + 1);
+			stack.push_back(node.start);
+		}
+	}
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+//----------------------------------------------------------
+vector<int> ofMeshBVH::getTrianglesInSphere(const ofVec3f & center, float radius) const{
+	vector<int> found;
+	if(nodes.empty()){
+		return found;
+	}
+	float squareRadius = radius * radius;
+	vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const Node & node = nodes[stack.back()];
+		stack.pop_back();
+		if(getSquareDistanceToBox(center, node.min, node.max) > squareRadius){
+			continue;
+		}
+		if(node.count > 0){
+			for(int i = node.start; i < node.start + node.count; i++){
+				ofVec3f a, b, c;
+				getTriangle(triangles[i], a, b, c);
+				ofVec2f barycentric;
+				if(getClosestPointOnTriangle(center, a, b, c, barycentric).squareDistance(center) <= squareRadius){
+					found.push_back(triangles[i]);
+				}
+			}
+		}else{
+			stack.push_back(node.start + 1);
+			stack.push_back(node.start);
+		}
+	}
+	std::sort(found.begin(), found.end());
+	return found;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ofMesh.h"
+#include "ofRay.h"
+#include <limits>
+
+// a triangle of an ofMeshBVH query result
+class ofMeshBVHHit{
+public:
+	ofMeshBVHHit();
+
+	bool found;
+	// the index of the triangle in the mesh, its vertices are indices
+	// triangle*3 to triangle*3+2
+	int triangle;
+	// along the ray for intersect, to the point for getNearestPoint
+	float distance;
+	ofVec3f position;
+	// the weights of the second and third vertex of the triangle at
+	// position, the first one is 1 - u - v
+	ofVec2f barycentric;
+};
+
+// bounding volume hierarchy over the triangles of a mesh, answers ray casts
+// and proximity queries in about logarithmic time instead of testing every
+// triangle:
+//
+//	bvh.build(mesh);
+//	ofMeshBVHHit hit = bvh.intersect(cam.getPickRay(ofVec2f(mouseX, mouseY)));
+//
+// the tree is built with the surface area heuristic over binned centroids.
+// it keeps a copy of the vertex positions so the mesh can change after
+// build(). when only the vertices move, refit() updates the bounds without
+// rebuilding the tree, which is much faster but the queries slow down if the
+// triangles move far from where they were built
+class ofMeshBVH{
+public:
+	ofMeshBVH();
+
+	// the mesh has to be OF_PRIMITIVE_TRIANGLES, indexed or not
+	bool build(const ofMesh & mesh);
+	// mesh has to have the same number of vertices and indices as the one
+	// the tree was built for
+	bool refit(const ofMesh & mesh);
+	void clear();
+	bool isBuilt() const;
+
+	int getNumTriangles() const;
+	int getNumNodes() const;
+	// bounds of the whole mesh
+	ofVec3f getMin() const;
+	ofVec3f getMax() const;
+
+	// the closest triangle hit by the ray, both sides of a triangle count
+	ofMeshBVHHit intersect(const ofRay & ray, float maxDistance = std::numeric_limits<float>::max()) const;
+	// stops at the first triangle found, for visibility tests
+	bool intersectsAny(const ofRay & ray, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	// the closest point on the mesh to point
+	ofMeshBVHHit getNearestPoint(const ofVec3f & point, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	// the triangles that touch the box or sphere
+	vector<int> getTrianglesInBox(const ofVec3f & min, const ofVec3f & max) const;
+	vector<int> getTrianglesInSphere(const ofVec3f & center, float radius) const;
+
+private:
+	struct Node{
+		ofVec3f min;
+		// for leaves the first triangle in triangles, otherwise the
+		// first of the two children which are next to each other
+		int start;
+		ofVec3f max;
+		// 0 for inner nodes
+		int count;
+	};
+
+	void buildNode(int node, int start, int count, vector<ofVec3f> & centroids, vector<ofVec3f> & triangleMin, vector<ofVec3f> & triangleMax);
+	void updateBounds(int node);
+	void getTriangle(int triangle, ofVec3f & a, ofVec3f & b, ofVec3f & c) const;
+
+	vector<Node> nodes;
+	// triangle indices in the order of the leaves
+	vector<int> triangles;
+	vector<ofVec3f> vertices;
+	vector<ofIndexType> indices;
+	bool bIndexed;
+};
@@ -0,0 +1,488 @@
+#include "ofMeshDecimate.h"
+#include <algorithm>
+#include <queue>
+#include <limits>
+
+//----------------------------------------------------------
+ofMeshDecimateSettings::ofMeshDecimateSettings()
+:preserveBoundaries(true)
+,preserveSeams(true)
+,maxError(0){}
+
+//----------------------------------------------------------
+ofMeshLod::ofMeshLod()
+:error(0){}
+
+namespace{
+// sum of the squared distances to a set of planes, weighted by the area of
+// the triangles they come from
+struct Quadric{
+	Quadric()
+	:aa(0), ab(0), ac(0), ad(0), bb(0), bc(0), bd(0), cc(0), cd(0), dd(0), w(0){}
+
+	void addPlane(const ofVec3f & normal, double d, double weight){
+		double a = normal.x, b = normal.y, c = normal.z;
+		aa += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+		bb += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+		cc += weight * c * c; cd += weight * c * d;
+		dd += weight * d * d;
+		w += weight;
+	}
+
+	Quadric & operator+=(const Quadric & q){
+		aa += q.aa; ab += q.ab; ac += q.ac; ad += q.ad;
+		bb += q.bb; bc += q.bc; bd += q.bd;
+		cc += q.cc; cd += q.cd;
+		dd += q.dd;
+		w += q.w;
+		return *this;
+	}
+
+	// the mean distance to the planes
+	float getError(const ofVec3f & p) const{
+		double x = p.x, y = p.y, z = p.z;
+		double sum = aa*x*x + 2*ab*x*y + 2*ac*x*z + 2*ad*x
+			+ bb*y*y + 2*bc*y*z + 2*bd*y
+			+ cc*z*z + 2*cd*z
+			+ dd;
+		return w > 0 && sum > 0 ? sqrt(sum / w) : 0;
+	}
+
+	double aa, ab, ac, ad, bb, bc, bd, cc, cd, dd, w;
+};
+
+struct Collapse{
+	float error;
+	int from, to;
+	unsigned int fromVersion, toVersion;
+	bool operator>(const Collapse & other) const{
+		return error > other.error;
+	}
+};
+
+class Decimator{
+public:
+	Decimator(const ofMesh & _mesh, const ofMeshDecimateSettings & _settings)
+	:mesh(_mesh)
+	,settings(_settings)
+	,maxCollapseError(0)
+	,stopped(false)
+	,stamp(0){
+		const vector<ofVec3f> & vertices = mesh.getVertices();
+		if(mesh.hasIndices()){
+			corners.assign(mesh.getIndices().begin(), mesh.getIndices().begin() + mesh.getNumIndices() / 3 * 3);
+		}else{
+			for(int i = 0; i < mesh.getNumVertices() / 3 * 3; i++){
+				corners.push_back(i);
+			}
+		}
+		int numTriangles = corners.size() / 3;
+
+		// vertices at the same position are corners of one position, the
+		// ones that also have the same attributes are the same vertex
+		vector<int> sorted(vertices.size());
+		for(size_t i = 0; i < sorted.size(); i++){
+			sorted[i] = i;
+		}
+		std::sort(sorted.begin(), sorted.end(), [&](int a, int b){
+			const ofVec3f & va = vertices[a];
+			const ofVec3f & vb = vertices[b];
+			if(va.x != vb.x) return va.x < vb.x;
+			if(va.y != vb.y) return va.y < vb.y;
+			if(va.z != vb.z) return va.z < vb.z;
+			return a < b;
+		});
+		positionOf.resize(vertices.size());
+		vector<int> sameVertex(vertices.size());
+		vector<bool> seam;
+		size_t firstOfPosition = 0;
+		for(size_t i = 0; i < sorted.size(); i++){
+			int v = sorted[i];
+			if(i == 0 || vertices[v] != vertices[sorted[i-1]]){
+				positions.push_back(vertices[v]);
+				seam.push_back(false);
+				firstOfPosition = i;
+			}
+			positionOf[v] = positions.size() - 1;
+			sameVertex[v] = v;
+			for(size_t j = firstOfPosition; j < i; j++){
+				if(haveSameAttributes(sorted[j], v)){
+					sameVertex[v] = sameVertex[sorted[j]];
+					break;
+				}
+			}
+			if(sameVertex[v] == v && i != firstOfPosition){
+				seam.back() = true;
+			}
+		}
+		for(size_t i = 0; i < corners.size(); i++){
+			corners[i] = sameVertex[corners[i]];
+		}
+
+		int numPositions = positions.size();
+		trianglesOf.resize(numPositions);
+		quadrics.resize(numPositions);
+		alive.resize(numPositions, true);
+		versions.resize(numPositions, 0);
+		marks.resize(numPositions, -1);
+		deadTriangles.resize(numTriangles, false);
+		numAliveTriangles = 0;
+
+		vector<std::pair<int,int> > edges;
+		for(int t = 0; t < numTriangles; t++){
+			int p0 = getPosition(t, 0), p1 = getPosition(t, 1), p2 = getPosition(t, 2);
+			if(p0 == p1 || p1 == p2 || p2 == p0){
+				deadTriangles[t] = true;
+				continue;
+			}
+			numAliveTriangles++;
+			ofVec3f normal = (positions[p1] - positions[p0]).getCrossed(positions[p2] - positions[p0]);
+			double area = normal.length() * .5;
+			if(area > 0){
+				normal /= area * 2;
+				double d = -normal.dot(positions[p0]);
+				for(int k = 0; k < 3; k++){
+					quadrics[getPosition(t, k)].addPlane(normal, d, area);
+				}
+			}
+			for(int k = 0; k < 3; k++){
+				int a = getPosition(t, k), b = getPosition(t, (k + 1) % 3);
+				trianglesOf[a].push_back(t);
+				edges.push_back(std::make_pair(MIN(a, b), MAX(a, b)));
+			}
+		}
+
+		// edges used by only one triangle are on the boundary
+		std::sort(edges.begin(), edges.end());
+		locked.resize(numPositions, false);
+		for(size_t i = 0; i < edges.size();){
+			size_t j = i;
+			while(j < edges.size() && edges[j] == edges[i]){
+				j++;
+			}
+			if(j - i == 1 && settings.preserveBoundaries){
+				locked[edges[i].first] = true;
+				locked[edges[i].second] = true;
+			}
+			i = j;
+		}
+		if(settings.preserveSeams){
+			for(int p = 0; p < numPositions; p++){
+				locked[p] = locked[p] || seam[p];
+			}
+		}
+
+		for(size_t i = 0; i < edges.size(); i++){
+			if(i == 0 || edges[i] != edges[i-1]){
+				pushCollapse(edges[i].first, edges[i].second);
+			}
+		}
+	}
+
+	// collapses edges until there's targetTriangles triangles left or no
+	// more edges can collapse
+	void decimate(int targetTriangles){
+		while(numAliveTriangles > targetTriangles && !stopped && !collapses.empty()){
+			Collapse collapse = collapses.top();
+			collapses.pop();
+			if(!alive[collapse.from] || !alive[collapse.to] || versions[collapse.from] != collapse.fromVersion || versions[collapse.to] != collapse.toVersion){
+				continue;
+			}
+			// the collapses come out from the smallest error so the rest are
+			// all too big too
+			if(settings.maxError > 0 && collapse.error > settings.maxError){
+				stopped = true;
+				break;
+			}
+			if(tryCollapse(collapse.from, collapse.to)){
+				maxCollapseError = MAX(maxCollapseError, collapse.error);
+			}
+		}
+	}
+
+	ofMeshLod getLod() const{
+		ofMeshLod lod;
+		lod.error = maxCollapseError;
+		ofMesh & result = lod.mesh;
+		result.setMode(OF_PRIMITIVE_TRIANGLES);
+
+		bool hasNormals = mesh.getNumNormals() == mesh.getNumVertices();
+		bool hasColors = mesh.getNumColors() == mesh.getNumVertices();
+		bool hasTexCoords = mesh.getNumTexCoords() == mesh.getNumVertices();
+		vector<int> newIndex(mesh.getNumVertices(), -1);
+		vector<ofIndexType> & indices = result.getIndices();
+		indices.reserve(numAliveTriangles * 3);
+		for(size_t t = 0; t < deadTriangles.size(); t++){
+			if(deadTriangles[t]){
+				continue;
+			}
+			for(int k = 0; k < 3; k++){
+				int v = corners[t*3+k];
+				if(newIndex[v] == -1){
+					newIndex[v] = result.getNumVertices();
+					result.addVertex(mesh.getVertices()[v]);
+					if(hasNormals) result.addNormal(mesh.getNormals()[v]);
+					if(hasColors) result.addColor(mesh.getColors()[v]);
+					if(hasTexCoords) result.addTexCoord(mesh.getTexCoords()[v]);
+				}
+				indices.push_back(newIndex[v]);
+			}
+		}
+		return lod;
+	}
+
+private:
+	int getPosition(int triangle, int corner) const{
+		return positionOf[corners[triangle*3+corner]];
+	}
+
+	bool haveSameAttributes(int a, int b) const{
+		if(mesh.getNumNormals() == mesh.getNumVertices() && mesh.getNormals()[a] != mesh.getNormals()[b]) return false;
+		if(mesh.getNumColors() == mesh.getNumVertices()){
+			// ofColor's comparisons aren't const
+			const ofFloatColor & ca = mesh.getColors()[a];
+			const ofFloatColor & cb = mesh.getColors()[b];
+			if(ca.r != cb.r || ca.g != cb.g || ca.b != cb.b || ca.a != cb.a) return false;
+		}
+		if(mesh.getNumTexCoords() == mesh.getNumVertices() && mesh.getTexCoords()[a] != mesh.getTexCoords()[b]) return false;
+		return true;
+	}
+
+	// queues the cheapest direction of the edge between a and b
+	void pushCollapse(int a, int b){
+		Quadric q = quadrics[a];
+		q += quadrics[b];
+		Collapse collapse;
+		collapse.error = std::numeric_limits<float>::max();
+		if(!locked[a]){
+			collapse.error = q.getError(positions[b]);
+			collapse.from = a;
+			collapse.to = b;
+		}
+		if(!locked[b]){
+			float error = q.getError(positions[a]);
+			if(error < collapse.error){
+				collapse.error = error;
+				collapse.from = b;
+				collapse.to = a;
+			}
+		}
+		if(locked[a] && locked[b]){
+			return;
+		}
+		collapse.fromVersion = versions[collapse.from];
+		collapse.toVersion = versions[collapse.to];
+		collapses.push(collapse);
+	}
+
+	void removeDeadTriangles(int p){
+		vector<int> & triangles = trianglesOf[p];
+		size_t kept = 0;
+		for(size_t i = 0; i < triangles.size(); i++){
+			if(!deadTriangles[triangles[i]]){
+				triangles[kept++] = triangles[i];
+			}
+		}
+		triangles.resize(kept);
+	}
+
+	int getCorner(int triangle, int position) const{
+		for(int k = 0; k < 3; k++){
+			if(getPosition(triangle, k) == position){
+				return k;
+			}
+		}
+		return -1;
+	}
+
+	bool tryCollapse(int from, int to){
+		removeDeadTriangles(from);
+		removeDeadTriangles(to);
+		const vector<int> & fromTriangles = trianglesOf[from];
+
+		shared.clear();
+		moved.clear();
+		for(size_t i = 0; i < fromTriangles.size(); i++){
+			int t = fromTriangles[i];
+			if(getCorner(t, to) != -1){
+				shared.push_back(t);
+			}else{
+				moved.push_back(t);
+			}
+		}
+		// the edge is gone since this collapse was queued
+		if(shared.empty()){
+			return false;
+		}
+
+		// the vertices around both ends have to be the ones across the
+		// collapsed triangles or the collapse would pinch the surface
+		stamp++;
+		for(size_t i = 0; i < fromTriangles.size(); i++){
+			for(int k = 0; k < 3; k++){
+				marks[getPosition(fromTriangles[i], k)] = stamp;
+			}
+		}
+		int common = 0;
+		const vector<int> & toTriangles = trianglesOf[to];
+		for(size_t i = 0; i < toTriangles.size(); i++){
+			for(int k = 0; k < 3; k++){
+				int p = getPosition(toTriangles[i], k);
+				if(p != from && p != to && marks[p] == stamp){
+					marks[p] = -1;
+					common++;
+				}
+			}
+		}
+		if(common > (int)shared.size()){
+			return false;
+		}
+
+		// triangles that would flip
+		for(size_t i = 0; i < moved.size(); i++){
+			int t = moved[i];
+			ofVec3f p[3];
+			for(int k = 0; k < 3; k++){
+				p[k] = positions[getPosition(t, k)];
+			}
+			ofVec3f before = (p[1] - p[0]).getCrossed(p[2] - p[0]);
+			p[getCorner(t, from)] = positions[to];
+			ofVec3f after = (p[1] - p[0]).getCrossed(p[2] - p[0]);
+			if(before.dot(after) < 0 || (after.lengthSquared() == 0 && before.lengthSquared() > 0)){
+				return false;
+			}
+		}
+
+		// the vertex of to each vertex of from turns into, taken from the
+		// collapsed triangles so the attributes stay continuous
+		vertexMap.clear();
+		for(size_t i = 0; i < shared.size(); i++){
+			int t = shared[i];
+			int fromVertex = corners[t*3+getCorner(t, from)];
+			int toVertex = corners[t*3+getCorner(t, to)];
+			bool found = false;
+			for(size_t j = 0; j < vertexMap.size(); j++){
+				if(vertexMap[j].first == fromVertex){
+					found = true;
+					if(vertexMap[j].second != toVertex && settings.preserveSeams){
+						return false;
+					}
+				}
+			}
+			if(!found){
+				vertexMap.push_back(std::make_pair(fromVertex, toVertex));
+			}
+		}
+
+		for(size_t i = 0; i < shared.size(); i++){
+			deadTriangles[shared[i]] = true;
+			numAliveTriangles--;
+		}
+		for(size_t i = 0; i < moved.size(); i++){
+			int t = moved[i];
+			int & vertex = corners[t*3+getCorner(t, from)];
+			int toVertex = vertexMap[0].second;
+			for(size_t j = 0; j < vertexMap.size(); j++){
+				if(vertexMap[j].first == vertex){
+					toVertex = vertexMap[j].second;
+					break;
+				}
+			}
+			vertex = toVertex;
+			trianglesOf[to].push_back(t);
+		}
+		trianglesOf[from].clear();
+		quadrics[to] += quadrics[from];
+		alive[from] = false;
+		versions[to]++;
+		removeDeadTriangles(to);
+
+		// the edges around to changed cost
+		stamp++;
+		marks[to] = stamp;
+		const vector<int> & around = trianglesOf[to];
+		for(size_t i = 0; i < around.size(); i++){
+			for(int k = 0; k < 3; k++){
+				int p = getPosition(around[i], k);
+				if(marks[p] != stamp){
+					marks[p] = stamp;
+					pushCollapse(to, p);
+				}
+			}
+		}
+		return true;
+	}
+
+	const ofMesh & mesh;
+	ofMeshDecimateSettings settings;
+
+	// the vertex of every corner of every triangle
+	vector<int> corners;
+	vector<bool> deadTriangles;
+	int numAliveTriangles;
+
+	vector<int> positionOf;
+	vector<ofVec3f> positions;
+	vector<vector<int> > trianglesOf;
+	vector<Quadric> quadrics;
+	vector<bool> locked;
+	vector<bool> alive;
+	vector<unsigned int> versions;
+
+	std::priority_queue<Collapse, vector<Collapse>, std::greater<Collapse> > collapses;
+	float maxCollapseError;
+	bool stopped;
+
+	// scratch space for tryCollapse
+	vector<int> marks;
+	int stamp;
+	vector<int> shared, moved;
+	vector<std::pair<int,int> > vertexMap;
+};
+}
+
+//----------------------------------------------------------
+ofMeshLod ofDecimateMesh(const ofMesh & mesh, int targetTriangles){
+	return ofDecimateMesh(mesh, targetTriangles, ofMeshDecimateSettings());
+}
+
+//----------------------------------------------------------
+ofMeshLod ofDecimateMesh(const ofMesh & mesh, int targetTriangles, const ofMeshDecimateSettings & settings){
+	vector<int> budgets(1, targetTriangles);
+	vector<ofMeshLod> lods = ofGenerateMeshLods(mesh, budgets, settings);
+	if(lods.empty()){
+		ofMeshLod lod;
+		lod.mesh = mesh;
+		return lod;
+	}
+	return lods[0];
+}
+
+//----------------------------------------------------------
+vector<ofMeshLod> ofGenerateMeshLods(const ofMesh & mesh, vector<int> triangleBudgets){
+	return ofGenerateMeshLods(mesh, triangleBudgets, ofMeshDecimateSettings());
+}
+
+//----------------------------------------------------------
+vector<ofMeshLod> ofGenerateMeshLods(const ofMesh & mesh, vector<int> triangleBudgets, const ofMeshDecimateSettings & settings){
+	vector<ofMeshLod> lods;
+	if(mesh.getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogError("ofMeshDecimate") << "ofGenerateMeshLods(): only meshes with OF_PRIMITIVE_TRIANGLES can be decimated";
+		return lods;
+	}
+	const vector<ofIndexType> & indices = mesh.getIndices();
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= (unsigned int)mesh.getNumVertices()){
+			ofLogError("ofMeshDecimate") << "ofGenerateMeshLods(): index " << i << " points to vertex " << indices[i] << " but there's only " << mesh.getNumVertices();
+			return lods;
+		}
+	}
+
+	std::sort(triangleBudgets.begin(), triangleBudgets.end(), std::greater<int>());
+	Decimator decimator(mesh, settings);
+	for(size_t i = 0; i < triangleBudgets.size(); i++){
+		decimator.decimate(MAX(0, triangleBudgets[i]));
+		lods.push_back(decimator.getLod());
+	}
+	return lods;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ofMesh.h"
+
+// reduces the number of triangles of a mesh by collapsing its edges one by
+// one, always the one that changes the surface the least as measured by
+// quadric error metrics (Garland and Heckbert, "Surface Simplification Using
+// Quadric Error Metrics"). an edge collapses into one of its vertices so the
+// remaining vertices keep their positions, normals, colors and texcoords.
+//
+// only indexed OF_PRIMITIVE_TRIANGLES meshes can be decimated, and only
+// vertices shared between triangles can be removed: weld meshes that come
+// with a copy of each vertex per triangle with ofMesh::mergeDuplicateVertices
+// first
+
+class ofMeshDecimateSettings{
+public:
+	ofMeshDecimateSettings();
+
+	// vertices on the open edges of the mesh are never removed
+	bool preserveBoundaries;
+
+	// vertices where the texcoords, normals or colors are discontinuous,
+	// which are several vertices at the same position, are never removed.
+	// the vertices around them can still collapse into them
+	bool preserveSeams;
+
+	// stops before collapsing edges that would move the surface more than
+	// this, in the units of the mesh. 0 means no limit
+	float maxError;
+};
+
+class ofMeshLod{
+public:
+	ofMeshLod();
+
+	ofMesh mesh;
+	// about how far the decimated surface is from the original one at most,
+	// in the units of the mesh
+	float error;
+};
+
+// decimates mesh down to targetTriangles or as close as the settings allow
+ofMeshLod ofDecimateMesh(const ofMesh & mesh, int targetTriangles);
+ofMeshLod ofDecimateMesh(const ofMesh & mesh, int targetTriangles, const ofMeshDecimateSettings & settings);
+
+// decimates mesh once to every budget in triangleBudgets, from the biggest to
+// the smallest, each level continues from the previous one. the levels are
+// returned from the most to the least detailed
+vector<ofMeshLod> ofGenerateMeshLods(const ofMesh & mesh, vector<int> triangleBudgets);
+vector<ofMeshLod> ofGenerateMeshLods(const ofMesh & mesh, vector<int> triangleBudgets, const ofMeshDecimateSettings & settings);
@@ -0,0 +1,244 @@
+#include "ofMeshFile.h"
+#include <cstring>
+
+// written as 0x01020304, reads differently on a machine with the other byte order
+static const unsigned int byteOrderMark = 0x01020304;
+static const size_t blockAlignment = 16;
+
+//----------------------------------------------------------
+ofMeshFile::ofMeshFile(){
+	memset(&header, 0, sizeof(header));
+}
+
+//----------------------------------------------------------
+ofMeshFile::ofMeshFile(const string & path){
+	memset(&header, 0, sizeof(header));
+	open(path);
+}
+
+//----------------------------------------------------------
+const char * ofMeshFile::getMagic(){
+	return "ofmesh\0\0";
+}
+
+//----------------------------------------------------------
+size_t ofMeshFile::getElementSize(Block block, int indexSize){
+	switch(block){
+		case Vertices: return sizeof(ofVec3f);
+		case Colors: return sizeof(ofFloatColor);
+		case Normals: return sizeof(ofVec3f);
+		case TexCoords: return sizeof(ofVec2f);
+		case Indices: return indexSize;
+		default: return 0;
+	}
+}
+
+//----------------------------------------------------------
+bool ofMeshFile::isMeshFile(const string & path){
+	ofMappedFile mapped(path);
+	return mapped.isOpen() && mapped.size() >= (long)sizeof(Header) && memcmp(mapped.getData(), getMagic(), 8) == 0;
+}
+
+//----------------------------------------------------------
+bool ofMeshFile::open(const string & path){
+	close();
+	if(!file.open(path)){
+		ofLogError("ofMeshFile") << "open(): couldn't open \"" << path << "\"";
+		return false;
+	}
+	if(file.size() < (long)sizeof(Header) || memcmp(file.getData(), getMagic(), 8) != 0){
+		ofLogError("ofMeshFile") << "open(): \"" << path << "\" is not an .ofmesh file";
+		close();
+		return false;
+	}
+	memcpy(&header, file.getData(), sizeof(header));
+	if(header.byteOrder != byteOrderMark){
+		ofLogError("ofMeshFile") << "open(): \"" << path << "\" was saved with a different byte order";
+		close();
+		return false;
+	}
+	if(header.version != version){
+		ofLogError("ofMeshFile") << "open(): \"" << path << "\" is version " << header.version << ", only version " << version << " is supported";
+		close();
+		return false;
+	}
+	if(header.indexSize != 2 && header.indexSize != 4){
+		ofLogError("ofMeshFile") << "open(): \"" << path << "\" has indices of " << header.indexSize << " bytes";
+		close();
+		return false;
+	}
+
+	unsigned int counts[NumBlocks] = {header.numVertices, header.numColors, header.numNormals, header.numTexCoords, header.numIndices};
+	for(int i = 0; i < NumBlocks; i++){
+		unsigned long long offset = header.offsets[i];
+		unsigned long long length = (unsigned long long)counts[i] * getElementSize((Block)i, header.indexSize);
+		if(counts[i] > 0 && (offset % blockAlignment != 0 || offset < sizeof(Header) || offset + length > (unsigned long long)file.size())){
+			ofLogError("ofMeshFile") << "open(): \"" << path << "\" is truncated or corrupt";
+			close();
+			return false;
+		}
+	}
+
+	if(header.numIndices > 0 && header.indexSize != sizeof(ofIndexType)){
+		convertedIndices.resize(header.numIndices);
+		if(header.indexSize == 2){
+			const unsigned short * indices = (const unsigned short*)getBlock(Indices);
+			std::copy(indices, indices + header.numIndices, convertedIndices.begin());
+		}else{
+			const unsigned int * indices = (const unsigned int*)getBlock(Indices);
+			for(unsigned int i = 0; i < header.numIndices; i++){
+				if(indices[i] != (ofIndexType)indices[i]){
+					ofLogError("ofMeshFile") << "open(): \"" << path << "\" has indices too big for ofIndexType";
+					close();
+					return false;
+				}
+				convertedIndices[i] = indices[i];
+			}
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+void ofMeshFile::close(){
+	file.close();
+	memset(&header, 0, sizeof(header));
+	convertedIndices.clear();
+}
+
+//----------------------------------------------------------
+bool ofMeshFile::isOpen() const{
+	return file.isOpen();
+}
+
+//----------------------------------------------------------
+bool ofMeshFile::save(const ofMesh & mesh, const string & path){
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, getMagic(), 8);
+	header.version = version;
+	header.byteOrder = byteOrderMark;
+	header.mode = mesh.getMode();
+	header.indexSize = sizeof(ofIndexType);
+	header.numVertices = mesh.getNumVertices();
+	header.numColors = mesh.getNumColors();
+	header.numNormals = mesh.getNumNormals();
+	header.numTexCoords = mesh.getNumTexCoords();
+	header.numIndices = mesh.getNumIndices();
+
+	const char * blocks[NumBlocks] = {
+		(const char*)mesh.getVerticesPointer(),
+		(const char*)mesh.getColorsPointer(),
+		(const char*)mesh.getNormalsPointer(),
+		(const char*)mesh.getTexCoordsPointer(),
+		(const char*)mesh.getIndexPointer()
+	};
+	unsigned int counts[NumBlocks] = {header.numVertices, header.numColors, header.numNormals, header.numTexCoords, header.numIndices};
+	size_t lengths[NumBlocks];
+	unsigned long long offset = sizeof(Header);
+	for(int i = 0; i < NumBlocks; i++){
+		offset = (offset + blockAlignment - 1) / blockAlignment * blockAlignment;
+		lengths[i] = counts[i] * getElementSize((Block)i, header.indexSize);
+		header.offsets[i] = counts[i] > 0 ? offset : 0;
+		offset += lengths[i];
+	}
+
+	ofFile out(path, ofFile::WriteOnly, true);
+	out.write((const char*)&header, sizeof(header));
+	unsigned long long written = sizeof(Header);
+	const char padding[blockAlignment] = {0};
+	for(int i = 0; i < NumBlocks; i++){
+		if(counts[i] == 0){
+			continue;
+		}
+		out.write(padding, header.offsets[i] - written);
+		out.write(blocks[i], lengths[i]);
+		written = header.offsets[i] + lengths[i];
+	}
+	out.flush();
+	if(!out){
+		ofLogError("ofMeshFile") << "save(): couldn't write \"" << path << "\"";
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+void ofMeshFile::getMesh(ofMesh & mesh) const{
+	mesh.clear();
+	if(!isOpen()){
+		return;
+	}
+	mesh.setMode(getMode());
+	mesh.getVertices().assign(getVertices(), getVertices() + getNumVertices());
+	mesh.getColors().assign(getColors(), getColors() + getNumColors());
+	mesh.getNormals().assign(getNormals(), getNormals() + getNumNormals());
+	mesh.getTexCoords().assign(getTexCoords(), getTexCoords() + getNumTexCoords());
+	mesh.getIndices().assign(getIndices(), getIndices() + getNumIndices());
+}
+
+//----------------------------------------------------------
+const char * ofMeshFile::getBlock(Block block) const{
+	if(!isOpen() || header.offsets[block] == 0){
+		return NULL;
+	}
+	return file.getData() + header.offsets[block];
+}
+
+//----------------------------------------------------------
+ofPrimitiveMode ofMeshFile::getMode() const{
+	return (ofPrimitiveMode)header.mode;
+}
+
+//----------------------------------------------------------
+int ofMeshFile::getNumVertices() const{
+	return header.numVertices;
+}
+
+//----------------------------------------------------------
+int ofMeshFile::getNumColors() const{
+	return header.numColors;
+}
+
+//----------------------------------------------------------
+int ofMeshFile::getNumNormals() const{
+	return header.numNormals;
+}
+
+//----------------------------------------------------------
+int ofMeshFile::getNumTexCoords() const{
+	return header.numTexCoords;
+}
+
+//----------------------------------------------------------
+int ofMeshFile::getNumIndices() const{
+	return header.numIndices;
+}
+
+//----------------------------------------------------------
+const ofVec3f * ofMeshFile::getVertices() const{
+	return (const ofVec3f*)getBlock(Vertices);
+}
+
+//----------------------------------------------------------
+const ofFloatColor * ofMeshFile::getColors() const{
+	return (const ofFloatColor*)getBlock(Colors);
+}
+
+//----------------------------------------------------------
+const ofVec3f * ofMeshFile::getNormals() const{
+	return (const ofVec3f*)getBlock(Normals);
+}
+
+//----------------------------------------------------------
+const ofVec2f * ofMeshFile::getTexCoords() const{
+	return (const ofVec2f*)getBlock(TexCoords);
+}
+
+//----------------------------------------------------------
+const ofIndexType * ofMeshFile::getIndices() const{
+	if(!convertedIndices.empty()){
+		return &convertedIndices[0];
+	}
+	return (const ofIndexType*)getBlock(Indices);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ofMesh.h"
+#include "ofFileUtils.h"
+
+// reads meshes in the .ofmesh binary format. the file has a fixed header
+// followed by the vertices, colors, normals, texcoords and indices, each in
+// its own block aligned to 16 bytes and laid out like the vectors in ofMesh.
+// the file is mapped instead of read so the blocks can be copied to an ofMesh
+// or uploaded to an ofVbo straight from it without parsing anything:
+//
+//	ofMeshFile file("model.ofmesh");
+//	vbo.setMesh(file, GL_STATIC_DRAW);
+//
+// ofMesh::load recognizes these files and ofMesh::save writes them when the
+// path ends in .ofmesh. the data is little endian, the version in the header
+// changes whenever the layout does
+class ofMeshFile{
+public:
+	ofMeshFile();
+	ofMeshFile(const string & path);
+
+	bool open(const string & path);
+	void close();
+	bool isOpen() const;
+
+	static bool save(const ofMesh & mesh, const string & path);
+	// true if the file starts with an .ofmesh header
+	static bool isMeshFile(const string & path);
+
+	// copies the whole file to mesh
+	void getMesh(ofMesh & mesh) const;
+
+	ofPrimitiveMode getMode() const;
+	int getNumVertices() const;
+	int getNumColors() const;
+	int getNumNormals() const;
+	int getNumTexCoords() const;
+	int getNumIndices() const;
+
+	// these point into the mapped file and stay valid while it's open
+	const ofVec3f * getVertices() const;
+	const ofFloatColor * getColors() const;
+	const ofVec3f * getNormals() const;
+	const ofVec2f * getTexCoords() const;
+	// indices saved with a different ofIndexType size are converted when
+	// the file is opened
+	const ofIndexType * getIndices() const;
+
+	static const unsigned int version = 1;
+
+private:
+	struct Header{
+		char magic[8];
+		unsigned int version;
+		unsigned int byteOrder;
+		unsigned int mode;
+		unsigned int indexSize;
+		unsigned int numVertices;
+		unsigned int numColors;
+		unsigned int numNormals;
+		unsigned int numTexCoords;
+		unsigned int numIndices;
+		unsigned int reserved[3];
+		unsigned long long offsets[5];
+	};
+
+	enum Block{
+		Vertices,
+		Colors,
+		Normals,
+		TexCoords,
+		Indices,
+		NumBlocks
+	};
+
+	static const char * getMagic();
+	static size_t getElementSize(Block block, int indexSize);
+	const char * getBlock(Block block) const;
+
+	ofMappedFile file;
+	Header header;
+	vector<ofIndexType> convertedIndices;
+};
@@ -0,0 +1,389 @@
+#include "ofMeshOptimize.h"
+#include <algorithm>
+
+//----------------------------------------------------------
+ofMeshOptimizeSettings::ofMeshOptimizeSettings()
+:cacheSize(16)
+,optimizeOverdraw(true)
+,optimizeVertexFetch(true){}
+
+//----------------------------------------------------------
+ofMeshOptimizeResult::ofMeshOptimizeResult()
+:acmrBefore(0)
+,acmrAfter(0){}
+
+//----------------------------------------------------------
+static bool checkMesh(const ofMesh & mesh, const string & function){
+	if(mesh.getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogWarning("ofMeshOptimize") << function << "(): only meshes with OF_PRIMITIVE_TRIANGLES can be optimized";
+		return false;
+	}
+	const vector<ofIndexType> & indices = mesh.getIndices();
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= (unsigned int)mesh.getNumVertices()){
+			ofLogError("ofMeshOptimize") << function << "(): index " << i << " points to vertex " << indices[i] << " but there's only " << mesh.getNumVertices();
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+float ofGetMeshACMR(const ofMesh & mesh, int cacheSize){
+	int numTriangles = mesh.getNumIndices() / 3;
+	if(numTriangles == 0){
+		return mesh.getMode() == OF_PRIMITIVE_TRIANGLES && mesh.getNumVertices() >= 3 ? 3 : 0;
+	}
+	cacheSize = MAX(1, cacheSize);
+
+	// a vertex is in the cache if it was added in the last cacheSize misses
+	const vector<ofIndexType> & indices = mesh.getIndices();
+	vector<int> addedAt(mesh.getNumVertices(), -cacheSize - 1);
+	int misses = 0;
+	for(int i = 0; i < numTriangles * 3; i++){
+		ofIndexType index = indices[i];
+		if(index >= addedAt.size()){
+			continue;
+		}
+		if(misses - addedAt[index] > cacheSize){
+			addedAt[index] = misses;
+			misses++;
+		}
+	}
+	return float(misses) / numTriangles;
+}
+
+namespace{
+struct Tipsify{
+	Tipsify(const vector<ofIndexType> & _indices, int numVertices, int _cacheSize)
+	:indices(_indices)
+	,cacheSize(_cacheSize)
+	,numTriangles(_indices.size() / 3)
+	,liveTriangles(numVertices, 0)
+	,cacheTime(numVertices, 0)
+	,emitted(numTriangles, false)
+	,time(_cacheSize + 1)
+	,cursor(0){
+		// the triangles around each vertex are adjacency[adjacencyStart[v]]
+		// to adjacency[adjacencyStart[v+1]]
+		for(int i = 0; i < numTriangles * 3; i++){
+			liveTriangles[indices[i]]++;
+		}
+		adjacencyStart.resize(numVertices + 1, 0);
+		for(int v = 0; v < numVertices; v++){
+			adjacencyStart[v+1] = adjacencyStart[v] + liveTriangles[v];
+		}
+		adjacency.resize(numTriangles * 3);
+		vector<int> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+		for(int i = 0; i < numTriangles * 3; i++){
+			adjacency[fill[indices[i]]++] = i / 3;
+		}
+	}
+
+	// the triangles in their new order and the positions in it where the
+	// order had to jump to a part of the mesh not in the cache
+	void run(vector<int> & order, vector<int> & clusterStarts){
+		order.clear();
+		order.reserve(numTriangles);
+		clusterStarts.clear();
+		int vertex = skipDeadEnd();
+		bool jumped = true;
+		while(vertex >= 0){
+			if(jumped){
+				clusterStarts.push_back(order.size());
+			}
+			candidates.clear();
+			// emit every triangle around the current vertex
+			for(int i = adjacencyStart[vertex]; i < adjacencyStart[vertex+1]; i++){
+				int triangle = adjacency[i];
+				if(emitted[triangle]){
+					continue;
+				}
+				for(int k = 0; k < 3; k++){
+					int v = indices[triangle*3+k];
+					deadEnd.push_back(v);
+					candidates.push_back(v);
+					liveTriangles[v]--;
+					if(time - cacheTime[v] > cacheSize){
+						cacheTime[v] = time;
+						time++;
+					}
+				}
+				emitted[triangle] = true;
+				order.push_back(triangle);
+			}
+			vertex = getNextVertex(jumped);
+		}
+	}
+
+private:
+	// the candidate that will still be in the cache after its remaining
+	// triangles are emitted and has been there the longest, or if there's
+	// none, a vertex with triangles left that was used recently
+	int getNextVertex(bool & jumped){
+		int best = -1;
+		int bestPriority = -1;
+		for(size_t i = 0; i < candidates.size(); i++){
+			int v = candidates[i];
+			if(liveTriangles[v] > 0){
+				int priority = 0;
+				if(time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize){
+					priority = time - cacheTime[v];
+				}
+				if(priority > bestPriority){
+					bestPriority = priority;
+					best = v;
+				}
+			}
+		}
+		jumped = best == -1;
+		if(best == -1){
+			best = skipDeadEnd();
+		}
+		return best;
+	}
+
+	int skipDeadEnd(){
+		while(!deadEnd.empty()){
+			int v = deadEnd.back();
+			deadEnd.pop_back();
+			if(liveTriangles[v] > 0){
+				return v;
+			}
+		}
+		while(cursor < (int)liveTriangles.size()){
+			if(liveTriangles[cursor] > 0){
+				return cursor;
+			}
+			cursor++;
+		}
+		return -1;
+	}
+
+	const vector<ofIndexType> & indices;
+	int cacheSize;
+	int numTriangles;
+	vector<int> liveTriangles;
+	vector<int> cacheTime;
+	vector<bool> emitted;
+	vector<int> adjacencyStart;
+	vector<int> adjacency;
+	vector<int> deadEnd;
+	vector<int> candidates;
+	int time;
+	int cursor;
+};
+
+// splits the clusters further at the points where the misses since the
+// start of the cluster are already as low as the average of the whole order,
+// starting the next cluster there with an empty cache costs little and gives
+// the overdraw sort smaller pieces to work with
+void splitClusters(const vector<ofIndexType> & indices, const vector<int> & order, int numVertices, int cacheSize, vector<int> & clusterStarts){
+	vector<int> addedAt(numVertices, -cacheSize - 1);
+	int misses = 0;
+	for(size_t i = 0; i < order.size() * 3; i++){
+		ofIndexType v = indices[order[i/3]*3+i%3];
+		if(misses - addedAt[v] > cacheSize){
+			addedAt[v] = misses++;
+		}
+	}
+	float averageMisses = float(misses) / order.size();
+
+	vector<int> split;
+	std::fill(addedAt.begin(), addedAt.end(), -cacheSize - 1);
+	// misses counts a whole cache of fake misses at every split so it starts
+	// empty
+	misses = 0;
+	int clusterMisses = 0;
+	int clusterStart = 0;
+	size_t next = 0;
+	for(size_t t = 0; t < order.size(); t++){
+		if(next < clusterStarts.size() && clusterStarts[next] == (int)t){
+			misses += cacheSize;
+			clusterMisses = 0;
+			clusterStart = t;
+			split.push_back(t);
+			next++;
+		}
+		for(int k = 0; k < 3; k++){
+			ofIndexType v = indices[order[t]*3+k];
+			if(misses - addedAt[v] > cacheSize){
+				addedAt[v] = misses++;
+				clusterMisses++;
+			}
+		}
+		int clusterSize = t + 1 - clusterStart;
+		bool nextIsStart = next < clusterStarts.size() && clusterStarts[next] == (int)t + 1;
+		if(!nextIsStart && t + 1 < order.size() && clusterSize >= cacheSize && clusterMisses <= averageMisses * clusterSize){
+			misses += cacheSize;
+			clusterMisses = 0;
+			clusterStart = t + 1;
+			split.push_back(t + 1);
+		}
+	}
+	clusterStarts.swap(split);
+}
+
+struct Cluster{
+	int start, end;
+	float facing;
+	bool operator<(const Cluster & other) const{
+		return facing > other.facing;
+	}
+};
+}
+
+//----------------------------------------------------------
+void ofOptimizeMeshVertexCache(ofMesh & mesh, int cacheSize, bool optimizeOverdraw){
+	if(!checkMesh(mesh, "ofOptimizeMeshVertexCache")){
+		return;
+	}
+	if(!mesh.hasIndices()){
+		mesh.setupIndicesAuto();
+	}
+	cacheSize = MAX(3, cacheSize);
+	const ofMesh & constMesh = mesh;
+	const vector<ofIndexType> & indices = constMesh.getIndices();
+	int numTriangles = indices.size() / 3;
+	if(numTriangles < 2){
+		return;
+	}
+
+	vector<int> order;
+	vector<int> clusterStarts;
+	Tipsify(indices, mesh.getNumVertices(), cacheSize).run(order, clusterStarts);
+
+	// the order jumps between clusters anyway so they can be drawn in any
+	// order for the same cache misses, the ones at the outside of the mesh
+	// facing away from its center are drawn first since they are the most
+	// likely to hide the others
+	if(optimizeOverdraw){
+		splitClusters(indices, order, mesh.getNumVertices(), cacheSize, clusterStarts);
+	}
+	if(optimizeOverdraw && clusterStarts.size() > 1){
+		const vector<ofVec3f> & vertices = constMesh.getVertices();
+		ofVec3f meshCenter;
+		float meshArea = 0;
+		vector<Cluster> clusters(clusterStarts.size());
+		vector<ofVec3f> clusterCenters(clusters.size());
+		vector<ofVec3f> clusterNormals(clusters.size());
+		for(size_t c = 0; c < clusters.size(); c++){
+			clusters[c].start = clusterStarts[c];
+			clusters[c].end = c + 1 < clusterStarts.size() ? clusterStarts[c+1] : numTriangles;
+			float clusterArea = 0;
+			for(int i = clusters[c].start; i < clusters[c].end; i++){
+				int triangle = order[i];
+				const ofVec3f & v0 = vertices[indices[triangle*3]];
+				const ofVec3f & v1 = vertices[indices[triangle*3+1]];
+				const ofVec3f & v2 = vertices[indices[triangle*3+2]];
+				// the length of the cross product is twice the area
+				ofVec3f normal = (v1 - v0).getCrossed(v2 - v0);
+				float area = normal.length();
+				clusterCenters[c] += (v0 + v1 + v2) * (area / 3);
+				clusterNormals[c] += normal;
+				clusterArea += area;
+			}
+			meshCenter += clusterCenters[c];
+			meshArea += clusterArea;
+			if(clusterArea > 0){
+				clusterCenters[c] /= clusterArea;
+			}
+		}
+		if(meshArea > 0){
+			meshCenter /= meshArea;
+		}
+		for(size_t c = 0; c < clusters.size(); c++){
+			clusters[c].facing = (clusterCenters[c] - meshCenter).dot(clusterNormals[c].getNormalized());
+		}
+		std::stable_sort(clusters.begin(), clusters.end());
+
+		vector<int> sorted;
+		sorted.reserve(numTriangles);
+		for(size_t c = 0; c < clusters.size(); c++){
+			sorted.insert(sorted.end(), order.begin() + clusters[c].start, order.begin() + clusters[c].end);
+		}
+		order.swap(sorted);
+	}
+
+	vector<ofIndexType> reordered(indices.size());
+	for(int i = 0; i < numTriangles; i++){
+		reordered[i*3] = indices[order[i]*3];
+		reordered[i*3+1] = indices[order[i]*3+1];
+		reordered[i*3+2] = indices[order[i]*3+2];
+	}
+	// an incomplete last triangle stays at the end
+	for(size_t i = numTriangles * 3; i < indices.size(); i++){
+		reordered[i] = indices[i];
+	}
+	mesh.getIndices().swap(reordered);
+}
+
+//----------------------------------------------------------
+template<typename T>
+static void remapAttribute(vector<T> & attribute, const vector<int> & newIndex){
+	if(attribute.size() != newIndex.size()){
+		return;
+	}
+	vector<T> remapped(attribute.size());
+	for(size_t i = 0; i < attribute.size(); i++){
+		remapped[newIndex[i]] = attribute[i];
+	}
+	attribute.swap(remapped);
+}
+
+//----------------------------------------------------------
+void ofOptimizeMeshVertexFetch(ofMesh & mesh){
+	if(!checkMesh(mesh, "ofOptimizeMeshVertexFetch") || !mesh.hasIndices()){
+		return;
+	}
+
+	// vertices get numbered in the order they are first used, the ones no
+	// triangle uses go at the end
+	int numVertices = mesh.getNumVertices();
+	vector<int> newIndex(numVertices, -1);
+	int next = 0;
+	vector<ofIndexType> & indices = mesh.getIndices();
+	for(size_t i = 0; i < indices.size(); i++){
+		if(newIndex[indices[i]] == -1){
+			newIndex[indices[i]] = next++;
+		}
+		indices[i] = newIndex[indices[i]];
+	}
+	for(int v = 0; v < numVertices; v++){
+		if(newIndex[v] == -1){
+			newIndex[v] = next++;
+		}
+	}
+
+	remapAttribute(mesh.getVertices(), newIndex);
+	if(mesh.hasNormals()){
+		remapAttribute(mesh.getNormals(), newIndex);
+	}
+	if(mesh.hasColors()){
+		remapAttribute(mesh.getColors(), newIndex);
+	}
+	if(mesh.hasTexCoords()){
+		remapAttribute(mesh.getTexCoords(), newIndex);
+	}
+}
+
+//----------------------------------------------------------
+ofMeshOptimizeResult ofOptimizeMesh(ofMesh & mesh){
+	return ofOptimizeMesh(mesh, ofMeshOptimizeSettings());
+}
+
+//----------------------------------------------------------
+ofMeshOptimizeResult ofOptimizeMesh(ofMesh & mesh, const ofMeshOptimizeSettings & settings){
+	ofMeshOptimizeResult result;
+	if(!checkMesh(mesh, "ofOptimizeMesh")){
+		return result;
+	}
+	result.acmrBefore = ofGetMeshACMR(mesh, settings.cacheSize);
+	ofOptimizeMeshVertexCache(mesh, settings.cacheSize, settings.optimizeOverdraw);
+	if(settings.optimizeVertexFetch){
+		ofOptimizeMeshVertexFetch(mesh);
+	}
+	result.acmrAfter = ofGetMeshACMR(mesh, settings.cacheSize);
+	ofLogVerbose("ofMeshOptimize") << "ofOptimizeMesh(): acmr " << result.acmrBefore << " -> " << result.acmrAfter;
+	return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ofMesh.h"
+
+// reorders the triangles and vertices of indexed triangle meshes so the gpu
+// transforms each vertex fewer times and reads the vertex buffers in order.
+// the mesh looks the same, only the order of its triangles and vertices
+// changes. meshes where the triangles don't share vertices, like the ones
+// without indices, have nothing to reuse, weld them first with
+// ofMesh::mergeDuplicateVertices.
+//
+// the triangle order follows tipsify (Sander, Nehab and Barczak, "Fast
+// Triangle Reordering for Vertex Locality and Reduced Overdraw"), which runs
+// in linear time and is close to the slower greedy orderings
+
+class ofMeshOptimizeSettings{
+public:
+	ofMeshOptimizeSettings();
+
+	// post transform cache size the order is optimized for. most gpus keep
+	// at least 16 vertices, some of the older mobile ones fewer
+	int cacheSize;
+
+	// draws the outside facing parts of the mesh first so the ones behind
+	// them fail the depth test instead of being shaded and overwritten
+	bool optimizeOverdraw;
+
+	// renumbers the vertices in the order the triangles use them
+	bool optimizeVertexFetch;
+};
+
+class ofMeshOptimizeResult{
+public:
+	ofMeshOptimizeResult();
+
+	// average cache misses per triangle, 3 is the worst and about 0.5 the
+	// best possible for a regular mesh
+	float acmrBefore;
+	float acmrAfter;
+};
+
+ofMeshOptimizeResult ofOptimizeMesh(ofMesh & mesh);
+ofMeshOptimizeResult ofOptimizeMesh(ofMesh & mesh, const ofMeshOptimizeSettings & settings);
+
+// the steps of ofOptimizeMesh on their own
+void ofOptimizeMeshVertexCache(ofMesh & mesh, int cacheSize = 16, bool optimizeOverdraw = true);
+void ofOptimizeMeshVertexFetch(ofMesh & mesh);
+
+// average cache misses per triangle with a fifo cache of cacheSize vertices
+float ofGetMeshACMR(const ofMesh & mesh, int cacheSize = 16);
@@ -0,0 +1,15 @@
+#include "ofRay.h"
+
+//----------------------------------------------------------
+ofRay::ofRay()
+:direction(0, 0, -1){}
+
+//----------------------------------------------------------
+ofRay::ofRay(const ofVec3f & _origin, const ofVec3f & _direction)
+:origin(_origin)
+,direction(_direction.getNormalized()){}
+
+//----------------------------------------------------------
+ofVec3f ofRay::getPoint(float distance) const{
+	return origin + direction * distance;
+}
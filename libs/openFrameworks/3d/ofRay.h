@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ofVec3f.h"
+
+// a half line from origin along direction, used for picking with
+// ofCamera::getPickRay and ofMeshBVH::intersect
+class ofRay{
+public:
+	ofRay();
+	// direction is normalized
+	ofRay(const ofVec3f & origin, const ofVec3f & direction);
+
+	// the point at distance from the origin
+	ofVec3f getPoint(float distance) const;
+
+	ofVec3f origin;
+	ofVec3f direction;
+};
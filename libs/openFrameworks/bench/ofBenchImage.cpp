@@ -0,0 +1,343 @@
+// times the image pipeline: encoding and decoding with ofSaveImage /
+// ofLoadImage and the ofPixels_ operations used every frame, at a few common
+// resolutions. the results are written as json so runs from different
+// versions can be compared:
+//
+//	of_bench_image [--quick] [--filter name] [output.json]
+//
+// without an output file the json goes to stdout. --quick runs only the
+// smallest resolutions with fewer iterations, --filter only the benchmarks
+// whose name contains the given string
+
+#include "ofMain.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace{
+
+struct Resolution{
+	const char * name;
+	int width, height;
+};
+
+const Resolution resolutions[] = {
+	{"vga", 640, 480},
+	{"720p", 1280, 720},
+	{"1080p", 1920, 1080},
+	{"4k", 3840, 2160},
+};
+
+struct Result{
+	string name;
+	string params;
+	int width, height, channels;
+	int iterations;
+	double minMicros, medianMicros, meanMicros;
+};
+
+struct Settings{
+	Settings()
+	:quick(false){}
+
+	bool quick;
+	string filter;
+};
+
+Settings settings;
+vector<Result> results;
+
+bool isEnabled(const string & name){
+	return settings.filter.empty() || name.find(settings.filter) != string::npos;
+}
+
+// runs func until it has taken at least minMillis or maxIterations runs,
+// after one untimed warm up run
+void bench(const string & name, const string & params, int width, int height, int channels, const function<void()> & func){
+	if(!isEnabled(name)){
+		return;
+	}
+	const double minMillis = settings.quick ? 50 : 500;
+	const int maxIterations = settings.quick ? 10 : 200;
+
+	func();
+
+	vector<double> times;
+	double total = 0;
+	while((int)times.size() < maxIterations && (total < minMillis * 1000 || times.size() < 3)){
+		unsigned long long start = ofGetSystemTimeMicros();
+		func();
+		double elapsed = ofGetSystemTimeMicros() - start;
+		times.push_back(elapsed);
+		total += elapsed;
+	}
+	std::sort(times.begin(), times.end());
+
+	Result result;
+	result.name = name;
+	result.params = params;
+	result.width = width;
+	result.height = height;
+	result.channels = channels;
+	result.iterations = times.size();
+	result.minMicros = times.front();
+	result.medianMicros = times[times.size() / 2];
+	result.meanMicros = total / times.size();
+	results.push_back(result);
+
+	ofLogNotice("of_bench_image") << name << " " << params << " " << width << "x" << height << "x" << channels
+		<< ": " << ofToString(result.medianMicros / 1000., 3) << "ms";
+}
+
+// something with gradients and noise so the encoders don't get an easy case
+void fillTestImage(ofPixels & pixels, int width, int height, int channels){
+	pixels.allocate(width, height, channels);
+	unsigned int seed = 1;
+	for(int y = 0; y < height; y++){
+		unsigned char * row = pixels.getPixels() + (size_t)y * width * channels;
+		for(int x = 0; x < width; x++){
+			for(int k = 0; k < channels; k++){
+				seed = seed * 1103515245 + 12345;
+				int value = (x * (k + 1) + y * (3 - k)) / 4 + ((seed >> 16) & 15);
+				row[x * channels + k] = value & 255;
+			}
+		}
+	}
+}
+
+string escapeJson(const string & str){
+	string escaped;
+	const char * hex = "0123456789abcdef";
+	for(size_t i = 0; i < str.size(); i++){
+		unsigned char c = str[i];
+		switch(c){
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\r': escaped += "\\r"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if(c < 0x20){
+					// any other control character has to be a \u escape
+					escaped += "\\u00";
+					escaped += hex[c >> 4];
+					escaped += hex[c & 15];
+				}else{
+					escaped += c;
+				}
+		}
+	}
+	return escaped;
+}
+
+// ofGetVersionInfo ends with a new line
+string getVersion(){
+	string version = ofGetVersionInfo();
+	while(!version.empty() && isspace((unsigned char)version[version.size() - 1])){
+		version.erase(version.size() - 1);
+	}
+	return version;
+}
+
+string getSimdLevelName(ofSimdLevel level){
+	switch(level){
+		case OF_SIMD_SSE2: return "sse2";
+		case OF_SIMD_SSSE3: return "ssse3";
+		case OF_SIMD_AVX2: return "avx2";
+		case OF_SIMD_WASM128: return "wasm128";
+		default: return "none";
+	}
+}
+
+string toJson(){
+	std::stringstream json;
+	json << "{\n";
+	json << "\t\"version\": \"" << escapeJson(getVersion()) << "\",\n";
+	json << "\t\"timestamp\": \"" << ofGetTimestampString("%Y-%m-%dT%H:%M:%S") << "\",\n";
+	json << "\t\"simd\": \"" << getSimdLevelName(ofGetSimdLevel()) << "\",\n";
+	json << "\t\"threads\": " << ofGetParallelThreads() << ",\n";
+	json << "\t\"quick\": " << (settings.quick ? "true" : "false") << ",\n";
+	json << "\t\"results\": [\n";
+	for(size_t i = 0; i < results.size(); i++){
+		const Result & r = results[i];
+		json << "\t\t{\"name\": \"" << escapeJson(r.name) << "\", \"params\": \"" << escapeJson(r.params) << "\""
+			<< ", \"width\": " << r.width << ", \"height\": " << r.height << ", \"channels\": " << r.channels
+			<< ", \"iterations\": " << r.iterations
+			<< ", \"min_us\": " << ofToString(r.minMicros, 1)
+			<< ", \"median_us\": " << ofToString(r.medianMicros, 1)
+			<< ", \"mean_us\": " << ofToString(r.meanMicros, 1) << "}";
+		json << (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	json << "\t]\n";
+	json << "}\n";
+	return json.str();
+}
+
+//----------------------------------------------------------
+void benchCodecs(const Resolution & resolution, const ofPixels & source){
+	const char * formats[] = {"png", "jpg", "tif"};
+	for(int i = 0; i < 3; i++){
+		string format = formats[i];
+		string path = ofToDataPath("of_bench_image." + format, true);
+		ofPixels pixels = source;
+		int w = resolution.width, h = resolution.height, c = pixels.getNumChannels();
+
+		bench("save", format, w, h, c, [&]{
+			ofSaveImage(pixels, path);
+		});
+
+		ofBuffer encoded;
+		bench("encode", format, w, h, c, [&]{
+			ofSaveImage(pixels, encoded, format == "png" ? OF_IMAGE_FORMAT_PNG : format == "jpg" ? OF_IMAGE_FORMAT_JPEG : OF_IMAGE_FORMAT_TIFF);
+		});
+
+		// make sure there's something to load even if save was filtered out
+		ofSaveImage(pixels, path);
+		ofPixels loaded;
+		bench("load", format, w, h, c, [&]{
+			ofLoadImage(loaded, path).get();
+		});
+
+		ofImageLoadSettings half;
+		half.scaleDenom = 2;
+		bench("load_scaled", format + " 1/2", w, h, c, [&]{
+			ofLoadImage(loaded, path, half);
+		});
+
+		ofFile::removeFile(path, false);
+	}
+}
+
+//----------------------------------------------------------
+void benchResize(const Resolution & resolution, const ofPixels & source){
+	const ofInterpolationMethod methods[] = {OF_INTERPOLATE_NEAREST_NEIGHBOR, OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_BICUBIC, OF_INTERPOLATE_AREA, OF_INTERPOLATE_LANCZOS};
+	const char * names[] = {"nearest", "bilinear", "bicubic", "area", "lanczos"};
+	ofPixels pixels = source;
+	int w = resolution.width, h = resolution.height, c = pixels.getNumChannels();
+	for(int i = 0; i < 5; i++){
+		ofPixels half, twice;
+		half.allocate(w / 2, h / 2, c);
+		bench("resize", string(names[i]) + " 1/2", w, h, c, [&]{
+			pixels.resizeTo(half, methods[i]);
+		});
+		// upscaling from half the size so the destination is as big as the source
+		ofPixels small;
+		pixels.resizeTo(half, OF_INTERPOLATE_AREA);
+		half.swap(small);
+		twice.allocate(w, h, c);
+		bench("resize", string(names[i]) + " 2x", w, h, c, [&]{
+			small.resizeTo(twice, methods[i]);
+		});
+	}
+}
+
+//----------------------------------------------------------
+void benchTransforms(const Resolution & resolution, const ofPixels & source){
+	ofPixels pixels = source;
+	ofPixels dst;
+	int w = resolution.width, h = resolution.height, c = pixels.getNumChannels();
+
+	bench("rotate90", "cw", w, h, c, [&]{
+		pixels.rotate90To(dst, 1);
+	});
+	bench("rotate90", "ccw", w, h, c, [&]{
+		pixels.rotate90To(dst, 3);
+	});
+	bench("rotate90", "in place", w, h, c, [&]{
+		pixels.rotate90(1);
+	});
+	bench("mirror", "horizontal", w, h, c, [&]{
+		pixels.mirror(false, true);
+	});
+	bench("mirror", "vertical", w, h, c, [&]{
+		pixels.mirror(true, false);
+	});
+	bench("mirror", "both", w, h, c, [&]{
+		pixels.mirrorTo(dst, true, true);
+	});
+}
+
+//----------------------------------------------------------
+void benchConversions(const Resolution & resolution, const ofPixels & source){
+	int w = resolution.width, h = resolution.height, c = source.getNumChannels();
+	const ofImageType types[] = {OF_IMAGE_GRAYSCALE, OF_IMAGE_COLOR, OF_IMAGE_COLOR_ALPHA};
+	const char * names[] = {"gray", "rgb", "rgba"};
+	for(int i = 0; i < 3; i++){
+		if(types[i] == source.getImageType()){
+			continue;
+		}
+		ofPixels pixels;
+		bench("setImageType", string(names[c == 1 ? 0 : c - 2]) + " to " + names[i], w, h, c, [&]{
+			pixels = source;
+			pixels.setImageType(types[i]);
+		});
+	}
+
+	ofFloatPixels floatPixels;
+	ofShortPixels shortPixels;
+	ofPixels pixels;
+	bench("copy", "u8 to float", w, h, c, [&]{
+		floatPixels = source;
+	});
+	bench("copy", "u8 to u16", w, h, c, [&]{
+		shortPixels = source;
+	});
+	bench("copy", "float to u8", w, h, c, [&]{
+		pixels = floatPixels;
+	});
+	bench("copy", "u16 to u8", w, h, c, [&]{
+		pixels = shortPixels;
+	});
+	bench("copy", "float to u16", w, h, c, [&]{
+		shortPixels = floatPixels;
+	});
+}
+
+}
+
+//----------------------------------------------------------
+int main(int argc, char ** argv){
+	string outputPath;
+	for(int i = 1; i < argc; i++){
+		string arg = argv[i];
+		if(arg == "--quick"){
+			settings.quick = true;
+		}else if(arg == "--filter" && i + 1 < argc){
+			settings.filter = argv[++i];
+		}else{
+			outputPath = arg;
+		}
+	}
+
+	// the json goes to stdout, keep the log out of it
+	if(outputPath.empty()){
+		ofSetLogLevel(OF_LOG_WARNING);
+	}
+
+	int numResolutions = settings.quick ? 2 : sizeof(resolutions) / sizeof(resolutions[0]);
+	const int channels[] = {1, 3, 4};
+	for(int i = 0; i < numResolutions; i++){
+		for(int j = 0; j < 3; j++){
+			ofPixels source;
+			fillTestImage(source, resolutions[i].width, resolutions[i].height, channels[j]);
+			benchCodecs(resolutions[i], source);
+			benchResize(resolutions[i], source);
+			benchTransforms(resolutions[i], source);
+			benchConversions(resolutions[i], source);
+		}
+	}
+
+	string json = toJson();
+	if(outputPath.empty()){
+		std::cout << json;
+	}else{
+		std::ofstream out(outputPath.c_str());
+		out << json;
+		if(!out){
+			ofLogError("of_bench_image") << "couldn't write results to \"" << outputPath << "\"";
+			return 1;
+		}
+	}
+	return 0;
+}
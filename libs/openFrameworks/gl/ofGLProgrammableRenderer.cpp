@@ -23,6 +23,7 @@ static const string COLOR_UNIFORM="globalColor";
 static const string USE_TEXTURE_UNIFORM="usingTexture";
 static const string USE_COLORS_UNIFORM="usingColors";
 static const string BITMAP_STRING_UNIFORM="bitmapText";
+static const string DISTANCE_FIELD_UNIFORM="distanceFieldText";
 
 
 const string ofGLProgrammableRenderer::TYPE="ProgrammableGL";
@@ -57,6 +58,7 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(bool useShapeColor)
     bSmoothHinted = false;
 
 	bitmapStringEnabled = false;
+	distanceFieldEnabled = false;
     verticesEnabled = true;
     colorsEnabled = false;
     texCoordsEnabled = false;
@@ -193,7 +195,7 @@ void ofGLProgrammableRenderer::draw(ofMesh & vertexData, ofPolyRenderMode render
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw( of3dPrimitive& model, ofPolyRenderMode renderType) {
-	model.getMesh().draw(renderType);
+	model.getSharedMesh().draw(renderType);
 }
 
 //----------------------------------------------------------
@@ -246,11 +248,15 @@ void ofGLProgrammableRenderer::draw(ofPath & shape){
 		if(shape.getUseShapeColor()){
 			setColor( shape.getStrokeColor() * ofGetStyle().color, shape.getStrokeColor().a/255. * ofGetStyle().color.a);
 		}
-		setLineWidth( shape.getStrokeWidth() );
-		vector<ofPolyline> & outlines = shape.getOutline();
-		for(int i=0; i<(int)outlines.size(); i++)
-			draw(outlines[i]);
-		setLineWidth(lineWidth);
+		if(shape.usesStrokeMesh()){
+			draw(shape.getStrokeMesh());
+		}else{
+			setLineWidth( shape.getStrokeWidth() );
+			vector<ofPolyline> & outlines = shape.getOutline();
+			for(int i=0; i<(int)outlines.size(); i++)
+				draw(outlines[i]);
+			setLineWidth(lineWidth);
+		}
 	}
 	if(shape.getUseShapeColor()){
 		setColor(prevColor);
@@ -835,6 +841,16 @@ void ofGLProgrammableRenderer::setAlphaBitmapText(bool bitmapText){
 	}
 }
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setDistanceFieldText(bool distanceFieldText){
+	bool wasDistanceFieldEnabled = distanceFieldEnabled;
+	distanceFieldEnabled = distanceFieldText;
+
+	if(wasDistanceFieldEnabled!=distanceFieldText){
+		if(currentShader) currentShader->setUniform1f(DISTANCE_FIELD_UNIFORM,distanceFieldText);
+	}
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setAttributes(bool vertices, bool color, bool tex, bool normals){
 	bool wasColorsEnabled = colorsEnabled;
@@ -926,6 +942,9 @@ void ofGLProgrammableRenderer::beginDefaultShader(){
 		if(bitmapStringEnabled){
 			nextShader = &bitmapStringShader();
 
+		}else if(distanceFieldEnabled){
+			nextShader = &distanceFieldShader();
+
 		}else if(colorsEnabled && texCoordsEnabled){
 			switch(currentTextureTarget){
 	#ifndef TARGET_OPENGLES
@@ -1405,6 +1424,30 @@ static string bitmapStringFragmentShader =  STRINGIFY(
 		}
 );
 
+// the distance to the outline is in alpha, 0.5 on the edge. without standard
+// derivatives the edge can't follow the scale and is smoothed by a fixed amount
+static string distanceFieldFragmentShader =
+		"#extension GL_OES_standard_derivatives : enable\n"
+		"#ifdef GL_OES_standard_derivatives\n"
+		"#define SMOOTHING(d) (fwidth(d)*0.7)\n"
+		"#else\n"
+		"#define SMOOTHING(d) 0.1\n"
+		"#endif\n"
+		STRINGIFY(
+		precision mediump float;
+
+		uniform sampler2D src_tex_unit0;
+		uniform vec4 globalColor;
+
+		varying vec2 texCoordVarying;
+
+		void main(){
+			float dist = texture2D(src_tex_unit0, texCoordVarying).a;
+			float smoothing = SMOOTHING(dist);
+			gl_FragColor = vec4(globalColor.rgb, globalColor.a * smoothstep(0.5-smoothing, 0.5+smoothing, dist));
+		}
+);
+
 
 
 // changing shaders in raspberry pi is very expensive so we use only one shader there
@@ -1446,6 +1489,7 @@ static string uniqueFragmentShader = STRINGIFY(
 
 		uniform float usingTexture;
 		uniform float bitmapText;
+		uniform float distanceFieldText;
 
 		varying vec4 colorVarying;
 		varying vec2 texCoordVarying;
@@ -1456,6 +1500,8 @@ static string uniqueFragmentShader = STRINGIFY(
 		        tex = texture2D(src_tex_unit0, texCoordVarying);
 				if(bitmapText>.5 && tex.a < 0.5){
 					discard;
+				}else if(distanceFieldText>.5){
+					gl_FragColor = vec4(colorVarying.rgb, colorVarying.a * smoothstep(0.4, 0.6, tex.a));
 				}else{
 		            gl_FragColor = colorVarying*tex;
                 }
@@ -1659,6 +1705,26 @@ static string bitmapStringFragmentShader = "#version 150\n" STRINGIFY(
 	}
 );
 
+// ----------------------------------------------------------------------
+
+static string distanceFieldFragmentShader = "#version 150\n" STRINGIFY(
+
+	uniform sampler2D src_tex_unit0;
+	uniform vec4 globalColor = vec4(1.0);
+
+	in vec2 texCoordVarying;
+
+	out vec4 fragColor;
+
+	void main()
+	{
+		// the distance to the outline is in alpha, 0.5 on the edge
+		float dist = texture(src_tex_unit0, texCoordVarying).a;
+		float smoothing = fwidth(dist)*0.7;
+		fragColor = vec4(globalColor.rgb, globalColor.a * smoothstep(0.5-smoothing, 0.5+smoothing, dist));
+	}
+);
+
 // ----------------------------------------------------------------------
 // changing shaders in raspberry pi is very expensive so we use only one shader there
 // in desktop openGL these are not used but we declare it to avoid more ifdefs
@@ -1696,6 +1762,7 @@ static string uniqueFragmentShader = "#version 150\n" STRINGIFY(
 		uniform sampler2D src_tex_unit0;
 		uniform float usingTexture;
 		uniform float bitmapText;
+		uniform float distanceFieldText;
         
 		in vec4 colorVarying;
 		in vec2 texCoordVarying;
@@ -1708,6 +1775,8 @@ static string uniqueFragmentShader = "#version 150\n" STRINGIFY(
 		        tex = texture(src_tex_unit0, texCoordVarying);
 				if(bitmapText>.5 && tex.a < 0.5){
 					discard;
+				}else if(distanceFieldText>.5){
+					fragColor = vec4(colorVarying.rgb, colorVarying.a * smoothstep(0.4, 0.6, tex.a));
 				}else{
 		            fragColor = colorVarying*tex;
                 }
@@ -1774,6 +1843,9 @@ void ofGLProgrammableRenderer::setup(){
 		setup( bitmapStringShader(), bitmapStringVertexShader,
 		                             bitmapStringFragmentShader );
 
+		setup( distanceFieldShader(), bitmapStringVertexShader,
+		                              distanceFieldFragmentShader );
+
 	}
 
 #ifdef TARGET_OPENGLES
@@ -1830,6 +1902,11 @@ ofShader & ofGLProgrammableRenderer::bitmapStringShader(){
 	return *shader;
 }
 
+ofShader & ofGLProgrammableRenderer::distanceFieldShader(){
+	static ofShader * shader = new ofShader;
+	return *shader;
+}
+
 #if defined(TARGET_OPENGLES) && defined(OF_BUFFER_IN_GL)
 ofGLProgrammableRenderer::glBuffers::glBuffers() noexcept {
 	glGenBuffers( size(), data() );
@@ -152,6 +152,7 @@ public:
 
 	void setAttributes(bool vertices, bool color, bool tex, bool normals);
 	void setAlphaBitmapText(bool bitmapText);
+	void setDistanceFieldText(bool distanceFieldText);
 
 	ofShader & defaultTexColor();
 	ofShader & defaultTexNoColor();
@@ -160,6 +161,7 @@ public:
 	ofShader & defaultNoTexColor();
 	ofShader & defaultNoTexNoColor();
 	ofShader & bitmapStringShader();
+	ofShader & distanceFieldShader();
 	ofShader & defaultUniqueShader();
     
 private:
@@ -249,7 +251,7 @@ private:
 	
 	ofShader * currentShader;
 
-	bool verticesEnabled, colorsEnabled, texCoordsEnabled, normalsEnabled, bitmapStringEnabled;
+	bool verticesEnabled, colorsEnabled, texCoordsEnabled, normalsEnabled, bitmapStringEnabled, distanceFieldEnabled;
 	bool usingCustomShader, settingDefaultShader;
 	int currentTextureTarget;
 
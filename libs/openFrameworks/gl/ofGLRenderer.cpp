@@ -143,7 +143,7 @@ void ofGLRenderer::draw( of3dPrimitive& model, ofPolyRenderMode renderType) {
         if(!normalsEnabled) glEnable( GL_NORMALIZE );
     }*/
 
-    model.getMesh().draw(renderType);
+    model.getSharedMesh().draw(renderType);
 
     /*if(model.hasScaling() && model.hasNormalsEnabled()) {
         if(!normalsEnabled) glDisable( GL_NORMALIZE );
@@ -184,11 +184,15 @@ void ofGLRenderer::draw(ofPath & shape){
 		if(shape.getUseShapeColor()){
 			setColor( shape.getStrokeColor(), shape.getStrokeColor().a);
 		}
-		setLineWidth( shape.getStrokeWidth() );
-		vector<ofPolyline> & outlines = shape.getOutline();
-		for(int i=0; i<(int)outlines.size(); i++)
-			draw(outlines[i]);
-		setLineWidth(lineWidth);
+		if(shape.usesStrokeMesh()){
+			draw(shape.getStrokeMesh());
+		}else{
+			setLineWidth( shape.getStrokeWidth() );
+			vector<ofPolyline> & outlines = shape.getOutline();
+			for(int i=0; i<(int)outlines.size(); i++)
+				draw(outlines[i]);
+			setLineWidth(lineWidth);
+		}
 	}
 	if(shape.getUseShapeColor()){
 		setColor(prevColor);
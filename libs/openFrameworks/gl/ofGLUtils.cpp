@@ -273,6 +273,46 @@ int ofGetGlTypeFromInternal(int glInternalFormat){
 	}
 }
 
+//---------------------------------
+int ofGetGlFormatFromNumChannels(int numChannels) {
+	switch(numChannels) {
+		case 4:
+			return GL_RGBA;
+			break;
+		case 3:
+			return GL_RGB;
+			break;
+		case 2:
+#ifndef TARGET_OPENGLES
+			if(ofGetGLProgrammableRenderer()){
+				return GL_RG;
+			}else{
+#endif
+				return GL_LUMINANCE_ALPHA;
+#ifndef TARGET_OPENGLES
+			}
+#endif
+			break;
+
+		case 1:
+#ifndef TARGET_OPENGLES
+			if(ofGetGLProgrammableRenderer()){
+				return GL_RED;
+			}else{
+#endif
+				return GL_LUMINANCE;
+#ifndef TARGET_OPENGLES
+			}
+#endif
+			break;
+
+		default:
+			ofLogError("ofGLUtils") << "ofGetGlFormatAndType(): internal format not recognized, returning GL_RGBA";
+			return GL_RGBA;
+			break;
+	}
+}
+
 //---------------------------------
 int ofGetGlType(const ofPixels & pixels) {
 	return GL_UNSIGNED_BYTE;
@@ -288,6 +328,21 @@ int ofGetGlType(const ofFloatPixels & pixels) {
 	return GL_FLOAT;
 }
 
+//---------------------------------
+int ofGetGlType(const ofPixelsView & pixels) {
+	return GL_UNSIGNED_BYTE;
+}
+
+//---------------------------------
+int ofGetGlType(const ofShortPixelsView & pixels) {
+	return GL_UNSIGNED_SHORT;
+}
+
+//---------------------------------
+int ofGetGlType(const ofFloatPixelsView & pixels) {
+	return GL_FLOAT;
+}
+
 //---------------------------------
 ofImageType ofGetImageTypeFromGLType(int glType){
 	switch(glType){
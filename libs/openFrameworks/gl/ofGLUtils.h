@@ -45,50 +45,24 @@ int ofGetGlTypeFromInternal(int glInternalFormat);
 ofPtr<ofGLProgrammableRenderer> ofGetGLProgrammableRenderer();
 ofPtr<ofBaseGLRenderer> ofGetGLRenderer();
 
+int ofGetGlFormatFromNumChannels(int numChannels);
+
 template<class T>
 int ofGetGlFormat(const ofPixels_<T> & pixels) {
-	switch(pixels.getNumChannels()) {
-		case 4:
-			return GL_RGBA;
-			break;
-		case 3:
-			return GL_RGB;
-			break;
-		case 2:
-#ifndef TARGET_OPENGLES
-			if(ofGetGLProgrammableRenderer()){
-				return GL_RG;
-			}else{
-#endif
-				return GL_LUMINANCE_ALPHA;
-#ifndef TARGET_OPENGLES
-			}
-#endif
-			break;
-
-		case 1:
-#ifndef TARGET_OPENGLES
-			if(ofGetGLProgrammableRenderer()){
-				return GL_RED;
-			}else{
-#endif
-				return GL_LUMINANCE;
-#ifndef TARGET_OPENGLES
-			}
-#endif
-			break;
-
-		default:
-			ofLogError("ofGLUtils") << "ofGetGlFormatAndType(): internal format not recognized, returning GL_RGBA";
-			return GL_RGBA;
-			break;
-	}
+	return ofGetGlFormatFromNumChannels(pixels.getNumChannels());
 }
 
+template<class T>
+int ofGetGlFormat(const ofPixelsView_<T> & pixels) {
+	return ofGetGlFormatFromNumChannels(pixels.getNumChannels());
+}
 
 int ofGetGlType(const ofPixels & pixels);
 int ofGetGlType(const ofShortPixels & pixels);
 int ofGetGlType(const ofFloatPixels & pixels);
+int ofGetGlType(const ofPixelsView & pixels);
+int ofGetGlType(const ofShortPixelsView & pixels);
+int ofGetGlType(const ofFloatPixelsView & pixels);
 
 ofImageType ofGetImageTypeFromGLType(int glType);
 
@@ -475,6 +475,67 @@ void ofTexture::loadData(const ofFloatPixels & pix, int glFormat){
 }
 
 
+//----------------------------------------------------------
+void ofTexture::loadData(const ofPixelsView & pix){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), ofGetGlFormat(pix), ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofShortPixelsView & pix){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), ofGetGlFormat(pix), ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofFloatPixelsView & pix){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), ofGetGlFormat(pix), ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofPixelsView & pix, int glFormat){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), glFormat, ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofShortPixelsView & pix, int glFormat){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), glFormat, ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofFloatPixelsView & pix, int glFormat){
+	loadData(pix.getPixels(), pix.getWidth(), pix.getHeight(), pix.getStride(), pix.getBytesPerChannel(), glFormat, ofGetGlType(pix));
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const void * data, int w, int h, int stride, int bytesPerChannel, int glFormat, int glType){
+	int numChannels = ofGetNumChannelsFromGLFormat(glFormat);
+	int bytesPerPixel = bytesPerChannel * numChannels;
+	if(stride == w * bytesPerPixel){
+		ofSetPixelStorei(w,bytesPerChannel,numChannels);
+		loadData(data, w, h, glFormat, glType);
+		return;
+	}
+
+#ifndef TARGET_OPENGLES
+	if(stride % bytesPerPixel == 0){
+		// let gl skip the end of each row instead of packing them
+		ofSetPixelStorei(stride / bytesPerPixel,bytesPerChannel,numChannels);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / bytesPerPixel);
+		loadData(data, w, h, glFormat, glType);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		return;
+	}
+#endif
+
+	// no row length in es 2, pack the rows before uploading
+	int rowSize = w * bytesPerPixel;
+	vector<unsigned char> packed(rowSize * h);
+	for(int y=0;y<h;y++){
+		memcpy(&packed[y * rowSize], (const unsigned char*)data + y * stride, rowSize);
+	}
+	ofSetPixelStorei(w,bytesPerChannel,numChannels);
+	loadData(&packed[0], w, h, glFormat, glType);
+}
+
 //----------------------------------------------------------
 void ofTexture::loadData(const void * data, int w, int h, int glFormat, int glType){
 
@@ -134,6 +134,15 @@ class ofTexture : public ofBaseDraws {
 	void loadData(const ofPixels & pix, int glFormat);
 	void loadData(const ofShortPixels & pix, int glFormat);
 	void loadData(const ofFloatPixels & pix, int glFormat);
+
+	// views can point to a region of bigger pixels, the rows are uploaded
+	// in place using GL_UNPACK_ROW_LENGTH when available
+	void loadData(const ofPixelsView & pix);
+	void loadData(const ofShortPixelsView & pix);
+	void loadData(const ofFloatPixelsView & pix);
+	void loadData(const ofPixelsView & pix, int glFormat);
+	void loadData(const ofShortPixelsView & pix, int glFormat);
+	void loadData(const ofFloatPixelsView & pix, int glFormat);
 	
 	// in openGL3+ use 1 channel GL_R as luminance instead of red channel
 	void setRGToRGBASwizzles(bool rToRGBSwizzles);
@@ -193,6 +202,7 @@ class ofTexture : public ofBaseDraws {
 
 protected:
 	void loadData(const void * data, int w, int h, int glFormat, int glType);
+	void loadData(const void * data, int w, int h, int stride, int bytesPerChannel, int glFormat, int glType);
 	void enableTextureTarget();
 	void disableTextureTarget();
 
@@ -282,6 +282,39 @@ void ofVbo::setMesh(const ofMesh & mesh, int usage, bool useColors, bool useText
 	}
 }
 
+//--------------------------------------------------------------
+void ofVbo::setMesh(const ofMeshFile & file, int usage){
+	if(file.getNumVertices() == 0){
+		ofLogWarning("ofVbo") << "setMesh(): ignoring mesh file with no vertices";
+		return;
+	}
+	setVertexData(file.getVertices(),file.getNumVertices(),usage);
+	if(file.getNumColors()){
+		setColorData(file.getColors(),file.getNumColors(),usage);
+		enableColors();
+	}else{
+		disableColors();
+	}
+	if(file.getNumNormals()){
+		setNormalData(file.getNormals(),file.getNumNormals(),usage);
+		enableNormals();
+	}else{
+		disableNormals();
+	}
+	if(file.getNumTexCoords()){
+		setTexCoordData(file.getTexCoords(),file.getNumTexCoords(),usage);
+		enableTexCoords();
+	}else{
+		disableTexCoords();
+	}
+	if(file.getNumIndices()){
+		setIndexData(file.getIndices(),file.getNumIndices(),usage);
+		enableIndices();
+	}else{
+		disableIndices();
+	}
+}
+
 //--------------------------------------------------------------
 void ofVbo::setVertexData(const ofVec3f * verts, int total, int usage) {
 	setVertexData(&verts[0].x,3,total,usage,sizeof(ofVec3f));
@@ -6,6 +6,7 @@
 #include "ofColor.h"
 #include "ofUtils.h"
 #include "ofMesh.h"
+#include "ofMeshFile.h"
 #include "ofGLUtils.h"
 #include <map>
 
@@ -37,6 +38,8 @@ public:
 
 	void setMesh(const ofMesh & mesh, int usage);
 	void setMesh(const ofMesh & mesh, int usage, bool useColors, bool useTextures, bool useNormals);
+	// uploads straight from the mapped file
+	void setMesh(const ofMeshFile & file, int usage);
 	
 	void setVertexData(const ofVec3f * verts, int total, int usage);
 	void setVertexData(const ofVec2f * verts, int total, int usage);
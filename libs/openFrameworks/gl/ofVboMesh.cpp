@@ -7,6 +7,8 @@ ofVboMesh::ofVboMesh(){
 	vboNumColors = 0;
 	vboNumTexCoords = 0;
 	vboNumNormals = 0;
+	lodRadius = 0;
+	lodPixelError = 1;
 }
 
 ofVboMesh::ofVboMesh(const ofMesh & mom)
@@ -18,6 +20,8 @@ ofVboMesh::ofVboMesh(const ofMesh & mom)
 	vboNumColors = 0;
 	vboNumTexCoords = 0;
 	vboNumNormals = 0;
+	lodRadius = 0;
+	lodPixelError = 1;
 }
 
 void ofVboMesh::operator=(const ofMesh & mom)
@@ -216,3 +220,106 @@ void ofVboMesh::updateVbo(){
 		}
 	}
 }
+
+void ofVboMesh::generateLods(const vector<int> & triangleBudgets){
+	generateLods(triangleBudgets, ofMeshDecimateSettings());
+}
+
+void ofVboMesh::generateLods(const vector<int> & triangleBudgets, const ofMeshDecimateSettings & settings){
+	setLods(ofGenerateMeshLods(*this, triangleBudgets, settings));
+}
+
+void ofVboMesh::setLods(const vector<ofMeshLod> & _lods){
+	clearLods();
+	for(size_t i = 0; i < _lods.size(); i++){
+		ofPtr<ofVboMesh> lod(new ofVboMesh(_lods[i].mesh));
+		lod->setUsage(usage);
+		lods.push_back(lod);
+		lodErrors.push_back(_lods[i].error);
+	}
+
+	// the bounding sphere of the full mesh gives the distance to the camera
+	const vector<ofVec3f> & vertices = ((const ofMesh&)*this).getVertices();
+	if(vertices.empty()){
+		return;
+	}
+	ofVec3f min = vertices[0], max = vertices[0];
+	for(size_t i = 1; i < vertices.size(); i++){
+		min.x = MIN(min.x, vertices[i].x); max.x = MAX(max.x, vertices[i].x);
+		min.y = MIN(min.y, vertices[i].y); max.y = MAX(max.y, vertices[i].y);
+		min.z = MIN(min.z, vertices[i].z); max.z = MAX(max.z, vertices[i].z);
+	}
+	lodCenter = (min + max) * .5;
+	lodRadius = 0;
+	for(size_t i = 0; i < vertices.size(); i++){
+		lodRadius = MAX(lodRadius, vertices[i].squareDistance(lodCenter));
+	}
+	lodRadius = sqrt(lodRadius);
+}
+
+void ofVboMesh::clearLods(){
+	lods.clear();
+	lodErrors.clear();
+	lodCenter.set(0, 0, 0);
+	lodRadius = 0;
+}
+
+int ofVboMesh::getNumLods() const{
+	return lods.size() + 1;
+}
+
+ofVboMesh & ofVboMesh::getLod(int level){
+	if(level <= 0 || level > (int)lods.size()){
+		return *this;
+	}
+	return *lods[level - 1];
+}
+
+float ofVboMesh::getLodError(int level) const{
+	if(level <= 0 || level > (int)lods.size()){
+		return 0;
+	}
+	return lodErrors[level - 1];
+}
+
+int ofVboMesh::getLodLevel(const ofCamera & camera, const ofMatrix4x4 & modelMatrix, ofRectangle viewport) const{
+	if(lods.empty()){
+		return 0;
+	}
+
+	// the errors are in mesh units, modelMatrix can scale them
+	float scale = MAX(MAX(ofVec3f(modelMatrix(0,0), modelMatrix(0,1), modelMatrix(0,2)).length(),
+		ofVec3f(modelMatrix(1,0), modelMatrix(1,1), modelMatrix(1,2)).length()),
+		ofVec3f(modelMatrix(2,0), modelMatrix(2,1), modelMatrix(2,2)).length());
+
+	// pixels per unit at the closest point of the bounding sphere
+	float pixelsPerUnit;
+	if(camera.getOrtho()){
+		pixelsPerUnit = 1;
+	}else{
+		ofVec3f center = lodCenter * modelMatrix;
+		float distance = center.distance(camera.getGlobalPosition()) - lodRadius * scale;
+		distance = MAX(distance, MAX(camera.getNearClip(), 0.0001f));
+		pixelsPerUnit = camera.getImagePlaneDistance(viewport) / distance;
+	}
+
+	int level = 0;
+	for(int i = 1; i <= (int)lods.size(); i++){
+		if(lodErrors[i - 1] * scale * pixelsPerUnit <= lodPixelError){
+			level = i;
+		}
+	}
+	return level;
+}
+
+void ofVboMesh::setLodPixelError(float pixels){
+	lodPixelError = pixels;
+}
+
+float ofVboMesh::getLodPixelError() const{
+	return lodPixelError;
+}
+
+void ofVboMesh::drawLod(const ofCamera & camera, const ofMatrix4x4 & modelMatrix, ofPolyRenderMode drawMode){
+	getLod(getLodLevel(camera, modelMatrix)).draw(drawMode);
+}
@@ -2,6 +2,8 @@
 
 #include "ofMesh.h"
 #include "ofVbo.h"
+#include "ofMeshDecimate.h"
+#include "ofCamera.h"
 
 class ofVboMesh: public ofMesh{
 public:
@@ -30,10 +32,37 @@ public:
 	void drawInstanced(ofPolyRenderMode drawMode, int primCount);
 	
 	ofVbo & getVbo();
-	
+
+	// levels of detail drawn instead of the mesh when it's small on screen.
+	// level 0 is the mesh itself, the rest are ordered from the most to the
+	// least detailed. the levels don't follow later changes to the mesh,
+	// generate them again after modifying it
+	void generateLods(const vector<int> & triangleBudgets);
+	void generateLods(const vector<int> & triangleBudgets, const ofMeshDecimateSettings & settings);
+	void setLods(const vector<ofMeshLod> & lods);
+	void clearLods();
+	int getNumLods() const;
+	ofVboMesh & getLod(int level);
+	float getLodError(int level) const;
+
+	// the least detailed level whose error projects to at most
+	// setLodPixelError pixels when drawn with camera and modelMatrix
+	int getLodLevel(const ofCamera & camera, const ofMatrix4x4 & modelMatrix = ofMatrix4x4(), ofRectangle viewport = ofGetCurrentViewport()) const;
+	void setLodPixelError(float pixels);
+	float getLodPixelError() const;
+
+	// draws the level picked by getLodLevel
+	void drawLod(const ofCamera & camera, const ofMatrix4x4 & modelMatrix = ofMatrix4x4(), ofPolyRenderMode drawMode = OF_MESH_FILL);
+
 private:
 	void updateVbo();
 	ofVbo vbo;
 	int usage;
 	int vboNumVerts, vboNumIndices, vboNumNormals, vboNumTexCoords, vboNumColors;
+
+	vector<ofPtr<ofVboMesh> > lods;
+	vector<float> lodErrors;
+	ofVec3f lodCenter;
+	float lodRadius;
+	float lodPixelError;
 };
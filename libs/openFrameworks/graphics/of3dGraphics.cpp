@@ -152,7 +152,7 @@ void ofDrawPlane(float x, float y, float z, float width, float height) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(width,height,1);
 	m.translate(x,y,z);
-    ofMesh & plane = getCached3dPrimitive( OF_3D_PRIMITIVE_PLANE ).getMesh();
+    ofMesh & plane = getCached3dPrimitive( OF_3D_PRIMITIVE_PLANE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( plane );
@@ -168,7 +168,7 @@ void ofDrawPlane(ofPoint& position, float width, float height) {
 void ofDrawPlane( float width, float height ) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(width,height,1);
-    ofMesh & plane = getCached3dPrimitive( OF_3D_PRIMITIVE_PLANE ).getMesh();
+    ofMesh & plane = getCached3dPrimitive( OF_3D_PRIMITIVE_PLANE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( plane );
@@ -194,7 +194,7 @@ void ofDrawSphere(float x, float y, float z, float radius) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,radius,radius);
 	m.translate(x,y,z);
-	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_SPHERE ).getMesh();
+	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_SPHERE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( sphere );
@@ -215,7 +215,7 @@ void ofDrawSphere(const ofPoint& position, float radius) {
 void ofDrawSphere(float radius) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,radius,radius);
-	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_SPHERE ).getMesh();
+	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_SPHERE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( sphere );
@@ -262,7 +262,7 @@ void ofDrawIcoSphere(float x, float y, float z, float radius) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,radius,radius);
 	m.translate(x,y,z);
-	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_ICO_SPHERE ).getMesh();
+	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_ICO_SPHERE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( sphere );
@@ -283,7 +283,7 @@ void ofDrawIcoSphere(const ofPoint& position, float radius) {
 void ofDrawIcoSphere(float radius) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,radius,radius);
-	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_ICO_SPHERE ).getMesh();
+	ofMesh& sphere = getCached3dPrimitive( OF_3D_PRIMITIVE_ICO_SPHERE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( sphere );
@@ -314,7 +314,7 @@ void ofDrawCylinder(float x, float y, float z, float radius, float height) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,height,radius);
 	m.translate(x,y,z);
-	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CYLINDER ).getMesh();
+	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CYLINDER ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( mesh );
@@ -330,7 +330,7 @@ void ofDrawCylinder(const ofPoint& position, float radius, float height) {
 void ofDrawCylinder(float radius, float height) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,height,radius);
-	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CYLINDER ).getMesh();
+	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CYLINDER ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( mesh );
@@ -357,7 +357,7 @@ void ofDrawCone(float x, float y, float z, float radius, float height) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,height,radius);
 	m.translate(x,y,z);
-	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CONE ).getMesh();
+	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CONE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( mesh );
@@ -378,7 +378,7 @@ void ofDrawCone(const ofPoint& position, float radius, float height) {
 void ofDrawCone(float radius, float height) {
 	static ofMatrix4x4 m;
 	m.makeScaleMatrix(radius,height,radius);
-	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CONE ).getMesh();
+	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_CONE ).getSharedMesh();
     ofPushMatrix();
     ofMultMatrix(m);
     renderCached3dPrimitive( mesh );
@@ -435,10 +435,10 @@ void ofDrawBox( float x, float y, float z, float width, float height, float dept
     ofPushMatrix();
     ofMultMatrix(m);
     if(ofGetFill() == OF_FILLED) {
-    	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX ).getMesh();
+    	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX ).getSharedMesh();
         renderCached3dPrimitive( mesh );
     } else {
-        ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX_WIREFRAME ).getMesh();
+        ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX_WIREFRAME ).getSharedMesh();
         renderCached3dPrimitive( mesh );
     }
     ofPopMatrix();
@@ -471,10 +471,10 @@ void ofDrawBox( float width, float height, float depth ) {
     ofPushMatrix();
     ofMultMatrix(m);
     if(ofGetFill() == OF_FILLED) {
-    	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX ).getMesh();
+    	ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX ).getSharedMesh();
         renderCached3dPrimitive( mesh );
     } else {
-        ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX_WIREFRAME ).getMesh();
+        ofMesh& mesh = getCached3dPrimitive( OF_3D_PRIMITIVE_BOX_WIREFRAME ).getSharedMesh();
         renderCached3dPrimitive( mesh );
     }
     ofPopMatrix();
@@ -220,8 +220,26 @@ void ofCairoRenderer::draw(ofPath & shape){
 			c.a = shape.getStrokeColor().a;
 			cairo_set_source_rgba(cr, (float)c.r/255.0, (float)c.g/255.0, (float)c.b/255.0, (float)c.a/255.0);
 		}
+		const ofStroker & stroker = shape.getStroker();
+		cairo_save(cr);
 		cairo_set_line_width( cr, shape.getStrokeWidth() );
+		switch(stroker.getJoin()){
+		case OF_STROKE_JOIN_MITER: cairo_set_line_join(cr, CAIRO_LINE_JOIN_MITER); break;
+		case OF_STROKE_JOIN_ROUND: cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND); break;
+		case OF_STROKE_JOIN_BEVEL: cairo_set_line_join(cr, CAIRO_LINE_JOIN_BEVEL); break;
+		}
+		switch(stroker.getCap()){
+		case OF_STROKE_CAP_BUTT: cairo_set_line_cap(cr, CAIRO_LINE_CAP_BUTT); break;
+		case OF_STROKE_CAP_ROUND: cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND); break;
+		case OF_STROKE_CAP_SQUARE: cairo_set_line_cap(cr, CAIRO_LINE_CAP_SQUARE); break;
+		}
+		cairo_set_miter_limit(cr, stroker.getMiterLimit());
+		if(stroker.isDashed()){
+			vector<double> dashes(stroker.getDashes().begin(), stroker.getDashes().end());
+			cairo_set_dash(cr, &dashes[0], dashes.size(), stroker.getDashOffset());
+		}
 		cairo_stroke( cr );
+		cairo_restore(cr);
 		cairo_set_line_width( cr, lineWidth );
 	}
 
@@ -399,7 +417,7 @@ void ofCairoRenderer::draw( of3dPrimitive& model, ofPolyRenderMode renderType  )
         //glScalef( scale.x, scale.y, scale.z);
     }
 
-    ofMesh& mesh = model.getMesh();
+    ofMesh& mesh = model.getSharedMesh();
     draw( mesh, renderType, mesh.usingColors(), mesh.usingTextures(), mesh.usingNormals() );
 
     if(model.hasScaling()) {
@@ -0,0 +1,280 @@
+#include "ofGlyphAtlas.h"
+#include "ofLog.h"
+#include <climits>
+
+//----------------------------------------------------------
+ofGlyphAtlas::ofGlyphAtlas(){
+	batch = 1;
+	nextEpoch = 1;
+	generation = 0;
+	minFilter = GL_LINEAR;
+	magFilter = GL_LINEAR;
+	setup();
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::setup(int _initialSize, int _maxSize, int _maxPages){
+	if(_maxSize<_initialSize || _initialSize<=0 || _maxPages<1){
+		ofLogError("ofGlyphAtlas") << "setup(): invalid sizes " << _initialSize << ", " << _maxSize << " or pages " << _maxPages;
+		return;
+	}
+	initialSize = _initialSize;
+	maxSize = _maxSize;
+	maxPages = _maxPages;
+	clear();
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::clear(){
+	pages.clear();
+	generation++;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::resetPage(Page & page, int size){
+	page.size = size;
+	page.pixels.allocate(size,size,4);
+	page.pixels.set(0,255);
+	page.pixels.set(1,255);
+	page.pixels.set(2,255);
+	page.pixels.set(3,0);
+	page.skyline.assign(1,SkylineNode());
+	page.skyline[0].x = 0;
+	page.skyline[0].y = 0;
+	page.skyline[0].width = size;
+	page.lastUsed = 0;
+	page.epoch = nextEpoch++;
+	page.dirty = true;
+	generation++;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::growPage(Page & page){
+	if(page.size*2>maxSize) return false;
+	ofPixels pixels;
+	pixels.allocate(page.size*2,page.size*2,4);
+	pixels.set(0,255);
+	pixels.set(1,255);
+	pixels.set(2,255);
+	pixels.set(3,0);
+	page.pixels.pasteInto(pixels,0,0);
+	page.pixels.swap(pixels);
+
+	// the new space to the right is empty from the top, the one below
+	// is already free under the skyline
+	SkylineNode node;
+	node.x = page.size;
+	node.y = 0;
+	node.width = page.size;
+	if(page.skyline.back().y==0){
+		page.skyline.back().width += node.width;
+	}else{
+		page.skyline.push_back(node);
+	}
+	page.size *= 2;
+	page.dirty = true;
+	generation++;
+	return true;
+}
+
+//----------------------------------------------------------
+// the lowest y the rectangle can be placed at starting at node or -1
+int ofGlyphAtlas::fitsAt(const Page & page, int node, int width, int height) const{
+	int x = page.skyline[node].x;
+	if(x+width>page.size) return -1;
+	int y = page.skyline[node].y;
+	int widthLeft = width;
+	for(int i=node;widthLeft>0;i++){
+		y = std::max(y,page.skyline[i].y);
+		if(y+height>page.size) return -1;
+		widthLeft -= page.skyline[i].width;
+	}
+	return y;
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::findPosition(const Page & page, int width, int height, int & node, int & x, int & y) const{
+	int bestBottom = INT_MAX;
+	int bestWidth = INT_MAX;
+	node = -1;
+	for(int i=0;i<(int)page.skyline.size();i++){
+		int nodeY = fitsAt(page,i,width,height);
+		if(nodeY<0) continue;
+		int bottom = nodeY + height;
+		if(bottom<bestBottom || (bottom==bestBottom && page.skyline[i].width<bestWidth)){
+			bestBottom = bottom;
+			bestWidth = page.skyline[i].width;
+			node = i;
+			x = page.skyline[i].x;
+			y = nodeY;
+		}
+	}
+	return node>=0;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::insert(Page & page, int node, int x, int y, int width, int height){
+	SkylineNode newNode;
+	newNode.x = x;
+	newNode.y = y + height;
+	newNode.width = width;
+	vector<SkylineNode> & skyline = page.skyline;
+	skyline.insert(skyline.begin()+node,newNode);
+
+	// cut the nodes now under the new one
+	for(int i=node+1;i<(int)skyline.size();){
+		int prevEnd = skyline[i-1].x + skyline[i-1].width;
+		if(skyline[i].x>=prevEnd) break;
+		int shrink = prevEnd - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		if(skyline[i].width>0) break;
+		skyline.erase(skyline.begin()+i);
+	}
+
+	for(int i=0;i<(int)skyline.size()-1;){
+		if(skyline[i].y==skyline[i+1].y){
+			skyline[i].width += skyline[i+1].width;
+			skyline.erase(skyline.begin()+i+1);
+		}else{
+			i++;
+		}
+	}
+}
+
+//----------------------------------------------------------
+bool ofGlyphAtlas::add(int width, int height, int & page, int & x, int & y){
+	if(width<=0 || height<=0 || width>maxSize || height>maxSize){
+		ofLogError("ofGlyphAtlas") << "add(): can't fit " << width << "x" << height << " in pages of " << maxSize;
+		return false;
+	}
+
+	int node;
+	for(int i=0;i<(int)pages.size();i++){
+		do{
+			if(findPosition(pages[i],width,height,node,x,y)){
+				page = i;
+				insert(pages[i],node,x,y,width,height);
+				touch(page);
+				return true;
+			}
+		}while(growPage(pages[i]));
+	}
+
+	// every page is full, add one or reuse the least recently used one
+	page = -1;
+	if((int)pages.size()>=maxPages){
+		unsigned long oldest = batch;
+		for(int i=0;i<(int)pages.size();i++){
+			if(pages[i].lastUsed<oldest){
+				oldest = pages[i].lastUsed;
+				page = i;
+			}
+		}
+		if(page<0){
+			ofLogVerbose("ofGlyphAtlas") << "add(): every page is in use by this batch, adding page " << pages.size()+1;
+		}
+	}
+	int size = initialSize;
+	while(size<width || size<height){
+		size *= 2;
+	}
+	size = std::min(size,maxSize);
+	if(page>=0){
+		resetPage(pages[page],std::max(size,pages[page].size));
+	}else{
+		page = pages.size();
+		pages.push_back(Page());
+		resetPage(pages.back(),size);
+	}
+	findPosition(pages[page],width,height,node,x,y);
+	insert(pages[page],node,x,y,width,height);
+	touch(page);
+	return true;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::setPixels(int page, int x, int y, ofPixels & pixels){
+	if(page<0 || page>=(int)pages.size() || pixels.getNumChannels()!=4){
+		ofLogError("ofGlyphAtlas") << "setPixels(): no page " << page << " or pixels aren't rgba";
+		return;
+	}
+	pixels.pasteInto(pages[page].pixels,x,y);
+	pages[page].dirty = true;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::touch(int page){
+	pages[page].lastUsed = batch;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::nextBatch(){
+	// pages over the limit only last while every batch uses them
+	while((int)pages.size()>maxPages && pages.back().lastUsed<batch){
+		pages.pop_back();
+		generation++;
+	}
+	batch++;
+}
+
+//----------------------------------------------------------
+unsigned int ofGlyphAtlas::getPageEpoch(int page) const{
+	if(page<0 || page>=(int)pages.size()) return 0;
+	return pages[page].epoch;
+}
+
+//----------------------------------------------------------
+unsigned int ofGlyphAtlas::getGeneration() const{
+	return generation;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getNumPages() const{
+	return pages.size();
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getPageSize(int page) const{
+	return pages[page].size;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getMaxSize() const{
+	return maxSize;
+}
+
+//----------------------------------------------------------
+int ofGlyphAtlas::getMaxPages() const{
+	return maxPages;
+}
+
+//----------------------------------------------------------
+ofPixels & ofGlyphAtlas::getPixels(int page){
+	return pages[page].pixels;
+}
+
+//----------------------------------------------------------
+ofTexture & ofGlyphAtlas::getTexture(int page){
+	Page & p = pages[page];
+	if(p.dirty){
+		if(!p.texture.bAllocated() || p.texture.getWidth()!=p.size){
+			p.texture.allocate(p.pixels,false);
+			p.texture.setTextureMinMagFilter(minFilter,magFilter);
+		}
+		p.texture.loadData(p.pixels);
+		p.dirty = false;
+	}
+	return p.texture;
+}
+
+//----------------------------------------------------------
+void ofGlyphAtlas::setTextureMinMagFilter(GLint _minFilter, GLint _magFilter){
+	minFilter = _minFilter;
+	magFilter = _magFilter;
+	for(int i=0;i<(int)pages.size();i++){
+		if(pages[i].texture.bAllocated()){
+			pages[i].texture.setTextureMinMagFilter(minFilter,magFilter);
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "ofPixels.h"
+#include "ofTexture.h"
+
+// packs small bitmaps like font glyphs into square texture pages that are
+// filled as they're needed:
+//
+//	int page, x, y;
+//	if(atlas.add(glyph.getWidth(), glyph.getHeight(), page, x, y)){
+//		atlas.setPixels(page, x, y, glyph);
+//	}
+//	atlas.getTexture(page).bind();
+//
+// rectangles are placed with the skyline bottom left heuristic. a full page
+// doubles its size until maxSize, then a new page is added until maxPages,
+// after that the least recently used page is cleared and reused. pages used
+// since the last call to nextBatch() are never cleared, a batch that needs
+// more than maxPages adds pages beyond the limit until a batch doesn't use
+// them.
+//
+// positions are in pixels so they stay valid when a page grows, but clearing
+// a page invalidates everything on it. whoever adds rectangles keeps the
+// epoch of their page and adds them again once it changes. the pixels are
+// rgba, the textures are uploaded the next time they're requested
+class ofGlyphAtlas{
+public:
+	ofGlyphAtlas();
+
+	// clears every page
+	void setup(int initialSize=256, int maxSize=2048, int maxPages=4);
+	void clear();
+
+	// finds room for a width x height rectangle, returns false if it doesn't
+	// fit in a page of maxSize
+	bool add(int width, int height, int & page, int & x, int & y);
+	// copies pixels, which have to be rgba, to the rectangle at x, y
+	void setPixels(int page, int x, int y, ofPixels & pixels);
+
+	// marks the page as used by the current batch
+	void touch(int page);
+	void nextBatch();
+
+	// changes every time the page is cleared, unique for the whole atlas
+	unsigned int getPageEpoch(int page) const;
+	// changes every time any page grows or is cleared, so anything with
+	// normalized texture coordinates has to be built again
+	unsigned int getGeneration() const;
+
+	int getNumPages() const;
+	int getPageSize(int page) const;
+	int getMaxSize() const;
+	int getMaxPages() const;
+	ofPixels & getPixels(int page);
+	// uploads the page first if it changed
+	ofTexture & getTexture(int page);
+
+	void setTextureMinMagFilter(GLint minFilter, GLint magFilter);
+
+private:
+	struct SkylineNode{
+		int x, y, width;
+	};
+
+	struct Page{
+		ofPixels pixels;
+		ofTexture texture;
+		vector<SkylineNode> skyline;
+		int size;
+		unsigned long lastUsed;
+		unsigned int epoch;
+		bool dirty;
+	};
+
+	void resetPage(Page & page, int size);
+	bool growPage(Page & page);
+	bool findPosition(const Page & page, int width, int height, int & node, int & x, int & y) const;
+	int fitsAt(const Page & page, int node, int width, int height) const;
+	void insert(Page & page, int node, int x, int y, int width, int height);
+
+	vector<Page> pages;
+	int initialSize;
+	int maxSize;
+	int maxPages;
+	unsigned long batch;
+	unsigned int nextEpoch;
+	unsigned int generation;
+	GLint minFilter, magFilter;
+};
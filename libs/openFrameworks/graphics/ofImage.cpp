@@ -78,15 +78,15 @@ void ofInitFreeImage(bool deinit=false){
 }
 
 template <typename T>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels_<T>& pix);
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView_<T>& pix);
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView& pix) {
 	return FIT_BITMAP;
 }
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofShortPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_UINT16;
 		case 3: return FIT_RGB16;
@@ -97,7 +97,7 @@ FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
 	}
 }
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_FLOAT;
 		case 3: return FIT_RGBF;
@@ -109,39 +109,59 @@ FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
 }
 
 //----------------------------------------------------
+// swapRB swaps the first and third channels of the bitmap, which is how
+// FreeImage expects 8bit pixels on little endian
 template<typename PixelType>
-FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
-	PixelType* pixels = pix.getPixels();
+FIBITMAP* getBmpFromPixels(const ofPixelsView_<PixelType> &pix, bool swapRB){
 	unsigned int width = pix.getWidth();
 	unsigned int height = pix.getHeight();
-	unsigned int bpp = pix.getBitsPerPixel();
+	unsigned int bpp = pix.getBytesPerPixel() * 8;
 	
 	FREE_IMAGE_TYPE freeImageType = getFreeImageType(pix);
 	FIBITMAP* bmp = FreeImage_AllocateT(freeImageType, width, height, bpp);
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
 	if(bmpBits != NULL) {
-		int srcStride = width * pix.getBytesPerPixel();
+		int rowSize = width * pix.getBytesPerPixel();
 		int dstStride = FreeImage_GetPitch(bmp);
-		unsigned char* src = (unsigned char*) pixels;
-		unsigned char* dst = bmpBits;
+		// ofPixels are top left, FIBITMAP is bottom left
+		unsigned char* dst = bmpBits + (height - 1) * dstStride;
 		for(int i = 0; i < (int)height; i++) {
-			memcpy(dst, src, srcStride);
-			src += srcStride;
-			dst += dstStride;
+			memcpy(dst, pix.getRow(i), rowSize);
+			if(swapRB){
+				ofSwapPixelsRB((unsigned char*)dst, pix.getNumChannels(), width);
+			}
+			dst -= dstStride;
 		}
 	} else {
 		ofLogError("ofImage") << "getBmpFromPixels(): unable to get FIBITMAP from ofPixels";
 	}
 	
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-	
 	return bmp;
 }
 
 //----------------------------------------------------
 template<typename PixelType>
-void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLittleEndian = true) {
+FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
+	return getBmpFromPixels(pix.getView(), false);
+}
+
+//----------------------------------------------------
+// number of channels of the pixels the bitmap is copied into, images with a
+// palette or less than 8 bits per pixel are expanded to rgb or rgba
+template<typename PixelType>
+static int getBmpNumChannels(FIBITMAP * bmp){
+	if(FreeImage_GetColorType(bmp) == FIC_PALETTE || FreeImage_GetBPP(bmp) < 8) {
+		return FreeImage_IsTransparent(bmp) ? 4 : 3;
+	}
+	return (FreeImage_GetBPP(bmp) / sizeof(PixelType)) / 8;
+}
+
+//----------------------------------------------------
+// copies the bitmap straight into the memory the view points to, which needs
+// to have the same size. the rows are flipped while copying and the channels
+// converted if the view has a different number of them
+template<typename PixelType>
+bool putBmpIntoPixels(FIBITMAP * bmp, const ofPixelsView_<PixelType> &pix, bool swapForLittleEndian = true) {
 	// some images use a palette, or <8 bpp, so convert them to raster 8-bit channels
 	FIBITMAP* bmpConverted = NULL;
 	if(FreeImage_GetColorType(bmp) == FIC_PALETTE || FreeImage_GetBPP(bmp) < 8) {
@@ -153,31 +173,98 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 		bmp = bmpConverted;
 	}
 
-	unsigned int width = FreeImage_GetWidth(bmp);
-	unsigned int height = FreeImage_GetHeight(bmp);
-	unsigned int bpp = FreeImage_GetBPP(bmp);
-	unsigned int channels = (bpp / sizeof(PixelType)) / 8;
+	int width = FreeImage_GetWidth(bmp);
+	int height = FreeImage_GetHeight(bmp);
+	int channels = (FreeImage_GetBPP(bmp) / sizeof(PixelType)) / 8;
 	unsigned int pitch = FreeImage_GetPitch(bmp);
-
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-	
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != NULL) {
-		pix.setFromAlignedPixels((PixelType*) bmpBits, width, height, channels, pitch);
-	} else {
+
+	bool swapRB = false;
+#ifdef TARGET_LITTLE_ENDIAN
+	swapRB = swapForLittleEndian && sizeof(PixelType) == 1;
+#endif
+
+	bool copied = false;
+	if(bmpBits == NULL) {
 		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
+	} else if(width != pix.getWidth() || height != pix.getHeight()) {
+		ofLogError("ofImage") << "putBmpIntoPixels(): image is " << width << "x" << height
+			<< ", doesn't fit in " << pix.getWidth() << "x" << pix.getHeight() << " pixels";
+	} else {
+		// ofPixels are top left, FIBITMAP is bottom left
+		int rowSize = width * pix.getBytesPerPixel();
+		for(int y = 0; y < height; y++) {
+			const PixelType * src = (const PixelType *) (bmpBits + (height - 1 - y) * pitch);
+			PixelType * dst = pix.getRow(y);
+			if(channels == pix.getNumChannels()) {
+				memcpy(dst, src, rowSize);
+			} else {
+				ofConvertPixelChannels(src, channels, dst, pix.getNumChannels(), width, (PixelType)ofColor_<PixelType>::limit());
+			}
+			if(swapRB) {
+				ofSwapPixelsRB(dst, pix.getNumChannels(), width);
+			}
+		}
+		copied = true;
 	}
-	
+
 	if(bmpConverted != NULL) {
 		FreeImage_Unload(bmpConverted);
 	}
+	return copied;
+}
 
-#ifdef TARGET_LITTLE_ENDIAN
-	if(swapForLittleEndian && sizeof(PixelType) == 1) {
-		pix.swapRgb();
+//----------------------------------------------------
+template<typename PixelType>
+void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLittleEndian = true) {
+	// reuses the memory of pix if it already has the right size
+	pix.allocate(FreeImage_GetWidth(bmp), FreeImage_GetHeight(bmp), getBmpNumChannels<PixelType>(bmp));
+	putBmpIntoPixels(bmp, pix.getView(), swapForLittleEndian);
+}
+
+//----------------------------------------------------
+// decodes from memory without copying it, FreeImage only reads from it
+static FIBITMAP * loadBmpFromMemory(const unsigned char * data, long size, int flags = 0){
+	FIMEMORY* hmem = FreeImage_OpenMemory((BYTE*) data, size);
+	if (hmem == NULL){
+		ofLogError("ofImage") << "loadImage(): couldn't load image from memory, opening FreeImage memory failed";
+		return NULL;
 	}
-#endif
+
+	//get the file type!
+	FIBITMAP* bmp = NULL;
+	FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(hmem);
+	if( fif == FIF_UNKNOWN ){
+		ofLogError("ofImage") << "loadImage(): couldn't load image from memory, unable to guess image format";
+	}else{
+		//make the image!!
+		bmp = FreeImage_LoadFromMemory(fif, hmem, flags);
+	}
+
+	FreeImage_CloseMemory(hmem);
+	return bmp;
+}
+
+//----------------------------------------------------
+// maps the file and decodes straight from the mapping, falls back to letting
+// FreeImage read the file if it can't be mapped
+static FIBITMAP * loadBmpFromFile(string fileName){
+	fileName = ofToDataPath(fileName);
+	ofMappedFile mapped(fileName);
+	if(mapped.isOpen()){
+		return loadBmpFromMemory((const unsigned char*) mapped.getData(), mapped.size());
+	}
+
+	FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
+	fif = FreeImage_GetFileType(fileName.c_str(), 0);
+	if(fif == FIF_UNKNOWN) {
+		// or guess via filename
+		fif = FreeImage_GetFIFFromFilename(fileName.c_str());
+	}
+	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
+		return FreeImage_Load(fif, fileName.c_str(), 0);
+	}
+	return NULL;
 }
 
 namespace {
@@ -187,35 +274,14 @@ namespace {
 	loadImageLocal( ofPixels_<PixelType> & pix, string fileName ) {
 		ofInitFreeImage();
 
-		fileName = ofToDataPath(fileName);
-		bool bLoaded = false;
-		FIBITMAP * bmp = NULL;
-
-		FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
-		fif = FreeImage_GetFileType(fileName.c_str(), 0);
-		if(fif == FIF_UNKNOWN) {
-			// or guess via filename
-			fif = FreeImage_GetFIFFromFilename(fileName.c_str());
-		}
-		if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
-			bmp = FreeImage_Load(fif, fileName.c_str(), 0);
-
-			if (bmp != NULL){
-				bLoaded = true;
-			}
-		}
-
-		//-----------------------------
-
-		if ( bLoaded ){
-			putBmpIntoPixels(bmp,pix);
-		}
-
-		if (bmp != NULL){
-			FreeImage_Unload(bmp);
+		FIBITMAP * bmp = loadBmpFromFile(fileName);
+		if (bmp == NULL){
+			return false;
 		}
 
-		return bLoaded;
+		putBmpIntoPixels(bmp,pix);
+		FreeImage_Unload(bmp);
+		return true;
 	}
 }
 
@@ -238,47 +304,124 @@ loadImage( ofPixels_<PixelType> & pix, string fileName ){
 template<typename PixelType>
 static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 	ofInitFreeImage();
-	bool bLoaded = false;
-	FIBITMAP* bmp = NULL;
-	FIMEMORY* hmem = NULL;
-	
-	hmem = FreeImage_OpenMemory((unsigned char*) buffer.getBinaryBuffer(), buffer.size());
-	if (hmem == NULL){
-		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer, opening FreeImage memory failed";
+	FIBITMAP* bmp = loadBmpFromMemory((const unsigned char*) buffer.getBinaryBuffer(), buffer.size());
+	if (bmp == NULL){
 		return false;
 	}
 
-	//get the file type!
-	FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(hmem);
-	if( fif == -1 ){
-		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer, unable to guess image format from memory";
+	putBmpIntoPixels(bmp,pix);
+	FreeImage_Unload(bmp);
+	return true;
+}
+
+//----------------------------------------------------
+// reads only the header when the format supports it
+static bool getImageSize(const unsigned char * data, long size, int & width, int & height){
+	FIBITMAP * header = loadBmpFromMemory(data, size, FIF_LOAD_NOPIXELS);
+	if(header == NULL){
 		return false;
-		FreeImage_CloseMemory(hmem);
 	}
+	width = FreeImage_GetWidth(header);
+	height = FreeImage_GetHeight(header);
+	FreeImage_Unload(header);
+	return true;
+}
 
+//----------------------------------------------------
+template<typename PixelType>
+static bool loadImage(ofPixels_<PixelType> & pix, string fileName, const ofImageLoadSettings & settings){
+	ofInitFreeImage();
 
-	//make the image!!
-	bmp = FreeImage_LoadFromMemory(fif, hmem, 0);
-	
-	if( bmp != NULL ){
-		bLoaded = true;
+	if(settings.scaleDenom < 1 || (settings.scaleDenom & (settings.scaleDenom - 1)) != 0){
+		ofLogError("ofImage") << "loadImage(): scaleDenom has to be a power of two, got " << settings.scaleDenom;
+		return false;
 	}
-	
-	//-----------------------------
-	
-	if (bLoaded){
-		putBmpIntoPixels(bmp,pix);
+
+	ofMappedFile mapped(fileName);
+	ofBuffer buffer;
+	const unsigned char * data = (const unsigned char *) mapped.getData();
+	long size = mapped.size();
+	if(!mapped.isOpen()){
+		buffer = ofBufferFromFile(fileName, true);
+		data = (const unsigned char *) buffer.getBinaryBuffer();
+		size = buffer.size();
 	}
 
-	if (bmp != NULL){
-		FreeImage_Unload(bmp);
+	int fullWidth, fullHeight;
+	if(size == 0 || !getImageSize(data, size, fullWidth, fullHeight)){
+		ofLogError("ofImage") << "loadImage(): couldn't load \"" << fileName << "\"";
+		return false;
 	}
-	
-	if( hmem != NULL ){
+
+	// size and region at the requested scale
+	int width = (fullWidth + settings.scaleDenom - 1) / settings.scaleDenom;
+	int height = (fullHeight + settings.scaleDenom - 1) / settings.scaleDenom;
+	ofRectangle bounds(0, 0, width, height);
+	ofRectangle region = settings.region.isEmpty() ? bounds : settings.region.getIntersection(bounds);
+	int left = region.x;
+	int top = region.y;
+	int right = ceil(region.getRight());
+	int bottom = ceil(region.getBottom());
+	if(right <= left || bottom <= top){
+		ofLogError("ofImage") << "loadImage(): region " << settings.region << " is outside of the image";
+		return false;
+	}
+
+	// jpegs are decoded with dct scaling to the smallest size bigger or equal
+	// than the requested one, other formats are decoded at full size
+	int flags = 0;
+	FIMEMORY * hmem = FreeImage_OpenMemory((BYTE*) data, size);
+	if(hmem != NULL){
+		if(FreeImage_GetFileTypeFromMemory(hmem) == FIF_JPEG && settings.scaleDenom > 1){
+			flags = MIN(MAX(width, height), 0xFFFF) << 16;
+		}
 		FreeImage_CloseMemory(hmem);
 	}
+	FIBITMAP * bmp = loadBmpFromMemory(data, size, flags);
+	if(bmp == NULL){
+		return false;
+	}
+
+	// crop the region at the decoded size, then scale it to the requested one
+	float decodedScale = FreeImage_GetWidth(bmp) / float(width);
+	int decodedLeft = left * decodedScale;
+	int decodedTop = top * decodedScale;
+	int decodedRight = MIN(ceil(right * decodedScale), FreeImage_GetWidth(bmp));
+	int decodedBottom = MIN(ceil(bottom * decodedScale), FreeImage_GetHeight(bmp));
+	if(decodedLeft != 0 || decodedTop != 0 || decodedRight != (int)FreeImage_GetWidth(bmp) || decodedBottom != (int)FreeImage_GetHeight(bmp)){
+		FIBITMAP * cropped = FreeImage_Copy(bmp, decodedLeft, decodedTop, decodedRight, decodedBottom);
+		FreeImage_Unload(bmp);
+		bmp = cropped;
+		if(bmp == NULL){
+			ofLogError("ofImage") << "loadImage(): couldn't crop \"" << fileName << "\"";
+			return false;
+		}
+	}
 
-	return bLoaded;
+	if((int)FreeImage_GetWidth(bmp) == right - left && (int)FreeImage_GetHeight(bmp) == bottom - top){
+		putBmpIntoPixels(bmp, pix);
+	}else{
+		ofPixels_<PixelType> decoded;
+		putBmpIntoPixels(bmp, decoded);
+		pix.allocate(right - left, bottom - top, decoded.getNumChannels());
+		decoded.resizeTo(pix, OF_INTERPOLATE_AREA);
+	}
+	FreeImage_Unload(bmp);
+	return true;
+}
+
+//----------------------------------------------------
+template<typename PixelType>
+static bool loadImage(const ofPixelsView_<PixelType> & pix, string fileName){
+	ofInitFreeImage();
+	FIBITMAP * bmp = loadBmpFromFile(fileName);
+	if (bmp == NULL){
+		return false;
+	}
+
+	bool loaded = putBmpIntoPixels(bmp,pix);
+	FreeImage_Unload(bmp);
+	return loaded;
 }
 
 
@@ -316,6 +459,52 @@ bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer){
 }
 
 
+//----------------------------------------------------
+ofImageLoadSettings::ofImageLoadSettings()
+:scaleDenom(1){}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofFloatPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofShortPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
+}
+
+//----------------------------------------------------
+bool ofGetImageSize(string path, int & width, int & height){
+	ofInitFreeImage();
+	ofMappedFile mapped(path);
+	if(mapped.isOpen()){
+		return getImageSize((const unsigned char *) mapped.getData(), mapped.size(), width, height);
+	}
+	ofBuffer buffer = ofBufferFromFile(path, true);
+	return buffer.size() > 0 && getImageSize((const unsigned char *) buffer.getBinaryBuffer(), buffer.size(), width, height);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(const ofPixelsView & pix, string path){
+	return loadImage(pix,path);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(const ofFloatPixelsView & pix, string path){
+	return loadImage(pix,path);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(const ofShortPixelsView & pix, string path){
+	return loadImage(pix,path);
+}
+
+
 //----------------------------------------------------------------
 future<bool>
 ofLoadImage(ofTexture & tex, string path){
@@ -345,30 +534,23 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer){
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel) {
+static bool saveImage(const ofPixelsView_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel) {
 	ofInitFreeImage();
 	if (pix.isAllocated() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save \"" << fileName << "\", pixels are not allocated";
-		return;
+		return false;
 	}
 
 	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
+	FIBITMAP * bmp	= getBmpFromPixels(pix, sizeof(PixelType) == 1);
+	#else
+	FIBITMAP * bmp	= getBmpFromPixels(pix, false);
 	#endif
 	
 	ofFilePath::createEnclosingDirectory(fileName);
 	fileName = ofToDataPath(fileName);
 	FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
+	bool saved = false;
 	fif = FreeImage_GetFileType(fileName.c_str(), 0);
 	if(fif == FIF_UNKNOWN) {
 		// or guess via filename
@@ -384,7 +566,7 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 				case OF_IMAGE_QUALITY_HIGH: quality = JPEG_QUALITYGOOD; break;
 				case OF_IMAGE_QUALITY_BEST: quality = JPEG_QUALITYSUPERB; break;
 			}
-			FreeImage_Save(fif, bmp, fileName.c_str(), quality);
+			saved = FreeImage_Save(fif, bmp, fileName.c_str(), quality);
 		} else {
 			if(qualityLevel != OF_IMAGE_QUALITY_BEST) {
 				ofLogWarning("ofImage") << "saveImage(): ofImageCompressionType only applies to JPEGs,"
@@ -400,12 +582,12 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 					// this will create a 256-color palette from the image
 					convertedBmp = FreeImage_ColorQuantize(bmp, FIQ_NNQUANT);
 				}
-				FreeImage_Save(fif, convertedBmp, fileName.c_str());
+				saved = FreeImage_Save(fif, convertedBmp, fileName.c_str());
 				if (convertedBmp != NULL){
 					FreeImage_Unload(convertedBmp);
 				}
 			} else {
-				FreeImage_Save(fif, bmp, fileName.c_str());
+				saved = FreeImage_Save(fif, bmp, fileName.c_str());
 			}
 		}
 	}
@@ -413,26 +595,42 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 	if (bmp != NULL){
 		FreeImage_Unload(bmp);
 	}
+	return saved;
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(ofPixels & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix.getView(),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
-void ofSaveImage(ofPixels & pix, string fileName, ofImageQualityType qualityLevel){
-	saveImage(pix,fileName,qualityLevel);
+bool ofSaveImage(ofFloatPixels & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix.getView(),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
-void ofSaveImage(ofFloatPixels & pix, string fileName, ofImageQualityType qualityLevel) {
-	saveImage(pix,fileName,qualityLevel);
+bool ofSaveImage(ofShortPixels & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix.getView(),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
-void ofSaveImage(ofShortPixels & pix, string fileName, ofImageQualityType qualityLevel) {
-	saveImage(pix,fileName,qualityLevel);
+bool ofSaveImage(const ofPixelsView & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(const ofFloatPixelsView & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(const ofShortPixelsView & pix, string fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix,fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+static void saveImage(const ofPixelsView_<PixelType> & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	// thanks to alvaro casinelli for the implementation
 
 	ofInitFreeImage();
@@ -443,24 +641,18 @@ static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageForm
 	}
 
 	if(format==OF_IMAGE_FORMAT_JPEG && pix.getNumChannels()==4){
-		ofPixels pix3 = pix;
+		ofPixels_<PixelType> pix4;
+		pix4.setFromView(pix);
+		ofPixels pix3 = pix4;
 		pix3.setNumChannels(3);
-		saveImage(pix3,buffer,format,qualityLevel);
+		saveImage(pix3.getView(),buffer,format,qualityLevel);
 		return;
 	}
 
 	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
+	FIBITMAP * bmp	= getBmpFromPixels(pix, sizeof(PixelType) == 1);
+	#else
+	FIBITMAP * bmp	= getBmpFromPixels(pix, false);
 	#endif
 
 	if (bmp)  // bitmap successfully created
@@ -521,14 +713,26 @@ static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageForm
 
 //----------------------------------------------------------------
 void ofSaveImage(ofPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	saveImage(pix,buffer,format,qualityLevel);
+	saveImage(pix.getView(),buffer,format,qualityLevel);
 }
 
 void ofSaveImage(ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	saveImage(pix,buffer,format,qualityLevel);
+	saveImage(pix.getView(),buffer,format,qualityLevel);
 }
 
 void ofSaveImage(ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix.getView(),buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix,buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix,buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	saveImage(pix,buffer,format,qualityLevel);
 }
 
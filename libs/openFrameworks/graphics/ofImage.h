@@ -65,18 +65,53 @@ bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer);
 future<bool> ofLoadImage(ofShortPixels & pix, string path) OF_WARN_UNUSED;
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer);
 
+// decode only part of an image. scaleDenom 1, 2, 4, 8... decodes at that
+// fraction of the size, jpegs use dct scaling so they are never decoded at
+// full size. region is in the coordinates of the scaled image, an empty one
+// loads all of it
+class ofImageLoadSettings{
+public:
+	ofImageLoadSettings();
+
+	int scaleDenom;
+	ofRectangle region;
+};
+
+bool ofLoadImage(ofPixels & pix, string path, const ofImageLoadSettings & settings);
+bool ofLoadImage(ofFloatPixels & pix, string path, const ofImageLoadSettings & settings);
+bool ofLoadImage(ofShortPixels & pix, string path, const ofImageLoadSettings & settings);
+
+// size of the image without decoding it
+bool ofGetImageSize(string path, int & width, int & height);
+
+// decode into the memory the view points to, which has to match the size of
+// the image. the channels are converted if they differ
+bool ofLoadImage(const ofPixelsView & pix, string path);
+bool ofLoadImage(const ofFloatPixelsView & pix, string path);
+bool ofLoadImage(const ofShortPixelsView & pix, string path);
+
 future<bool> ofLoadImage(ofTexture & tex, string path) OF_WARN_UNUSED;
 bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer);
 
-void ofSaveImage(ofPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(ofPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 
-void ofSaveImage(ofFloatPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(ofFloatPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 
-void ofSaveImage(ofShortPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(ofShortPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 
+// views save only the region they point to without copying it first
+bool ofSaveImage(const ofPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
+bool ofSaveImage(const ofFloatPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
+bool ofSaveImage(const ofShortPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
 // when we exit, we shut down ofImage
 void ofCloseFreeImage();
 
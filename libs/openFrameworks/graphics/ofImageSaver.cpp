@@ -0,0 +1,368 @@
+#include "ofImageSaver.h"
+
+#if defined(TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+	#define OF_IMAGE_SAVER_NO_THREADS
+#endif
+
+#include <deque>
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+void ofInitFreeImage(bool deinit);
+
+class ofImageSaver::Impl{
+public:
+	struct Job{
+		function<bool()> save;
+		string path;
+		shared_ptr<promise<bool> > result;
+	};
+
+	Impl(int numThreads, int maxQueued)
+	:numThreads(std::max(1, numThreads))
+	,maxQueued(std::max(1, maxQueued))
+	,numRunning(0)
+	,exiting(false){}
+
+	~Impl(){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		stopThreads();
+#endif
+	}
+
+	future<bool> add(const Job & job){
+		future<bool> result = job.result->get_future();
+#ifdef OF_IMAGE_SAVER_NO_THREADS
+		run(job);
+#else
+		startThreads();
+		std::unique_lock<std::mutex> lck(mutex);
+		// backpressure, the caller waits until an encoder takes an image
+		while((int)jobs.size() >= maxQueued){
+			notFull.wait(lck);
+		}
+		jobs.push_back(job);
+		lck.unlock();
+		notEmpty.notify_one();
+#endif
+		return result;
+	}
+
+	void waitForAll(){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+		while(!jobs.empty() || numRunning > 0){
+			idle.wait(lck);
+		}
+#endif
+	}
+
+	int getNumPending(){
+#ifdef OF_IMAGE_SAVER_NO_THREADS
+		return 0;
+#else
+		std::unique_lock<std::mutex> lck(mutex);
+		return jobs.size() + numRunning;
+#endif
+	}
+
+	// results waiting to be notified in update
+	std::deque<ofImageSavedEventArgs> takeFinished(){
+		std::deque<ofImageSavedEventArgs> done;
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+#endif
+		done.swap(finished);
+		return done;
+	}
+
+	void setNumThreads(int _numThreads){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+#endif
+		numThreads = std::max(1, _numThreads);
+	}
+
+	int getNumThreads(){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+#endif
+		return numThreads;
+	}
+
+	void setMaxQueued(int _maxQueued){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			maxQueued = std::max(1, _maxQueued);
+		}
+		notFull.notify_all();
+#else
+		maxQueued = std::max(1, _maxQueued);
+#endif
+	}
+
+	int getMaxQueued(){
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+#endif
+		return maxQueued;
+	}
+
+private:
+	void run(const Job & job){
+		bool saved = job.save();
+		job.result->set_value(saved);
+
+		ofImageSavedEventArgs args;
+		args.path = job.path;
+		args.saved = saved;
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+		std::unique_lock<std::mutex> lck(mutex);
+#endif
+		finished.push_back(args);
+	}
+
+#ifndef OF_IMAGE_SAVER_NO_THREADS
+	void work(){
+		while(true){
+			Job job;
+			{
+				std::unique_lock<std::mutex> lck(mutex);
+				while(!exiting && jobs.empty()){
+					notEmpty.wait(lck);
+				}
+				// the queue is written before exiting so no image is lost
+				if(jobs.empty()){
+					return;
+				}
+				job = jobs.front();
+				jobs.pop_front();
+				numRunning++;
+			}
+			notFull.notify_one();
+
+			run(job);
+
+			{
+				std::unique_lock<std::mutex> lck(mutex);
+				numRunning--;
+				if(jobs.empty() && numRunning == 0){
+					idle.notify_all();
+				}
+			}
+		}
+	}
+
+	// starts the encoders the first time and after the number of threads changes
+	void startThreads(){
+		std::unique_lock<std::mutex> threadsLck(threadsMutex);
+		int wanted = getNumThreads();
+		if((int)threads.size() == wanted){
+			return;
+		}
+		stopThreads();
+		for(int i=0;i<wanted;i++){
+			threads.push_back(std::thread(&Impl::work, this));
+		}
+	}
+
+	void stopThreads(){
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			exiting = true;
+		}
+		notEmpty.notify_all();
+		for(size_t i=0;i<threads.size();i++){
+			threads[i].join();
+		}
+		threads.clear();
+		std::unique_lock<std::mutex> lck(mutex);
+		exiting = false;
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex threadsMutex;
+	std::mutex mutex;
+	std::condition_variable notEmpty, notFull, idle;
+#endif
+
+	std::deque<Job> jobs;
+	std::deque<ofImageSavedEventArgs> finished;
+	int numThreads;
+	int maxQueued;
+	int numRunning;
+	bool exiting;
+};
+
+//----------------------------------------------------------
+ofImageSaver::ofImageSaver(int numThreads, int maxQueued)
+:impl(new Impl(numThreads, maxQueued)){
+	ofAddListener(ofEvents().update, this, &ofImageSaver::update);
+	ofAddListener(ofEvents().exit, this, &ofImageSaver::exit);
+}
+
+//----------------------------------------------------------
+ofImageSaver::~ofImageSaver(){
+	ofRemoveListener(ofEvents().update, this, &ofImageSaver::update);
+	ofRemoveListener(ofEvents().exit, this, &ofImageSaver::exit);
+}
+
+//----------------------------------------------------------
+template<typename PixelType>
+future<bool> ofImageSaver::add(ofPtr<ofPixels_<PixelType> > pixels, const string & path, ofImageQualityType quality){
+	if(!pixels->isAllocated()){
+		ofLogError("ofImageSaver") << "save(): trying to save unallocated pixels to \"" << path << "\"";
+		return make_ready_future(false);
+	}
+	Impl::Job job;
+	job.path = path;
+	job.result = make_shared<promise<bool> >();
+	// the path is resolved here, the data path could change before it's saved
+	string absolutePath = ofToDataPath(path, true);
+	job.save = [pixels, absolutePath, quality]{
+		return ofSaveImage(*pixels, absolutePath, quality);
+	};
+	// freeimage is initialized on first use, do it here before two encoders race to it
+	ofInitFreeImage(false);
+	return impl->add(job);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofPixels & pixels, string path, ofImageQualityType quality){
+	return add(ofPtr<ofPixels>(new ofPixels(pixels)), path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(ofPixels && pixels, string path, ofImageQualityType quality){
+	ofPtr<ofPixels> taken(new ofPixels);
+	taken->swap(pixels);
+	return add(taken, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofFloatPixels & pixels, string path, ofImageQualityType quality){
+	return add(ofPtr<ofFloatPixels>(new ofFloatPixels(pixels)), path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofShortPixels & pixels, string path, ofImageQualityType quality){
+	return add(ofPtr<ofShortPixels>(new ofShortPixels(pixels)), path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofPixelsView & pixels, string path, ofImageQualityType quality){
+	ofPtr<ofPixels> copy(new ofPixels);
+	copy->setFromView(pixels);
+	return add(copy, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofFloatPixelsView & pixels, string path, ofImageQualityType quality){
+	ofPtr<ofFloatPixels> copy(new ofFloatPixels);
+	copy->setFromView(pixels);
+	return add(copy, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofImageSaver::save(const ofShortPixelsView & pixels, string path, ofImageQualityType quality){
+	ofPtr<ofShortPixels> copy(new ofShortPixels);
+	copy->setFromView(pixels);
+	return add(copy, path, quality);
+}
+
+//----------------------------------------------------------
+void ofImageSaver::waitForAll(){
+	impl->waitForAll();
+}
+
+//----------------------------------------------------------
+void ofImageSaver::setNumThreads(int numThreads){
+	impl->setNumThreads(numThreads);
+}
+
+//----------------------------------------------------------
+int ofImageSaver::getNumThreads(){
+	return impl->getNumThreads();
+}
+
+//----------------------------------------------------------
+void ofImageSaver::setMaxQueued(int maxQueued){
+	impl->setMaxQueued(maxQueued);
+}
+
+//----------------------------------------------------------
+int ofImageSaver::getMaxQueued(){
+	return impl->getMaxQueued();
+}
+
+//----------------------------------------------------------
+int ofImageSaver::getNumPending(){
+	return impl->getNumPending();
+}
+
+//----------------------------------------------------------
+void ofImageSaver::update(ofEventArgs & args){
+	std::deque<ofImageSavedEventArgs> finished = impl->takeFinished();
+	for(size_t i=0;i<finished.size();i++){
+		if(!finished[i].saved){
+			ofLogError("ofImageSaver") << "couldn't save \"" << finished[i].path << "\"";
+		}
+		ofNotifyEvent(savedEvent, finished[i], this);
+	}
+}
+
+//----------------------------------------------------------
+void ofImageSaver::exit(ofEventArgs & args){
+	waitForAll();
+}
+
+//----------------------------------------------------------
+ofImageSaver & ofGetImageSaver(){
+	// never deleted so it's still there for images saved while exiting
+	static ofImageSaver * saver = new ofImageSaver;
+	return *saver;
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofPixels & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(ofPixels && pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(std::move(pixels), path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofFloatPixels & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofShortPixels & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofPixelsView & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofFloatPixelsView & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+future<bool> ofSaveImageAsync(const ofShortPixelsView & pixels, string path, ofImageQualityType quality){
+	return ofGetImageSaver().save(pixels, path, quality);
+}
+
+//----------------------------------------------------------
+void ofWaitForImageSaves(){
+	ofGetImageSaver().waitForAll();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ofImage.h"
+#include "ofEvents.h"
+
+class ofImageSavedEventArgs : public ofEventArgs{
+public:
+	string path;
+	bool saved;
+};
+
+// encodes and writes images in background threads. the pixels are copied
+// when they're queued so the caller can reuse them right away, that copy is
+// all the calling thread pays for.
+//
+// at most setMaxQueued images wait to be encoded, once the queue is full
+// save() blocks until one of the encoder threads takes an image from it so
+// a program saving faster than the disk can write doesn't run out of memory.
+//
+// every save returns a future with the result, savedEvent is notified for
+// each image from the main thread in the next update. queued images are
+// still written when the app exits
+class ofImageSaver{
+public:
+	ofImageSaver(int numThreads = 2, int maxQueued = 8);
+	~ofImageSaver();
+
+	future<bool> save(const ofPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	// takes the pixels instead of copying them
+	future<bool> save(ofPixels && pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	future<bool> save(const ofFloatPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	future<bool> save(const ofShortPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	future<bool> save(const ofPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	future<bool> save(const ofFloatPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+	future<bool> save(const ofShortPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+
+	// waits for the queued images to be written
+	void waitForAll();
+
+	// the threads are restarted once the images already queued are written
+	void setNumThreads(int numThreads);
+	int getNumThreads();
+	void setMaxQueued(int maxQueued);
+	int getMaxQueued();
+
+	// images queued or being encoded
+	int getNumPending();
+
+	ofEvent<ofImageSavedEventArgs> savedEvent;
+
+private:
+	class Impl;
+	template<typename PixelType>
+	future<bool> add(ofPtr<ofPixels_<PixelType> > pixels, const string & path, ofImageQualityType quality);
+	void update(ofEventArgs & args);
+	void exit(ofEventArgs & args);
+
+	ofPtr<Impl> impl;
+};
+
+// the saver used by ofSaveImageAsync, ofSaveScreenAsync...
+ofImageSaver & ofGetImageSaver();
+
+future<bool> ofSaveImageAsync(const ofPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(ofPixels && pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(const ofFloatPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(const ofShortPixels & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(const ofPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(const ofFloatPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+future<bool> ofSaveImageAsync(const ofShortPixelsView & pixels, string path, ofImageQualityType quality = OF_IMAGE_QUALITY_BEST);
+void ofWaitForImageSaves();
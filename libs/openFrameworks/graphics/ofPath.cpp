@@ -1,8 +1,7 @@
 #include "ofPath.h"
 #include "ofGraphics.h"
 #include "ofTessellator.h"
-
-ofTessellator ofPath::tessellator;
+#include "ofParallel.h"
 
 ofPath::Command::Command(Type type)
 :type(type){
@@ -48,6 +47,8 @@ ofPath::ofPath(){
 	bHasChanged = false;
 	bUseShapeColor = true;
 	bNeedsPolylinesGeneration = false;
+	bNeedsStroke = false;
+	stroker.setWidth(strokeWidth);
 	clear();
 }
 
@@ -59,6 +60,7 @@ void ofPath::clear(){
 	polylines.resize(1);
 	polylines[0].clear();
 	cachedTessellation.clear();
+	cachedStroke.clear();
 	flagShapeChanged();
 }
 
@@ -434,7 +436,37 @@ void ofPath::setFilled(bool hasFill){
 
 //----------------------------------------------------------
 void ofPath::setStrokeWidth(float width){
+	if(!hasOutline() && width>0 && windingMode!=OF_POLY_WINDING_ODD){
+		// the outline of other winding modes is only kept with a stroke
+		bNeedsTessellation = true;
+	}
 	strokeWidth = width;
+	stroker.setWidth(width);
+	bNeedsStroke = true;
+}
+
+//----------------------------------------------------------
+void ofPath::setStrokeJoin(ofStrokeJoin join){
+	stroker.setJoin(join);
+	bNeedsStroke = true;
+}
+
+//----------------------------------------------------------
+void ofPath::setStrokeCap(ofStrokeCap cap){
+	stroker.setCap(cap);
+	bNeedsStroke = true;
+}
+
+//----------------------------------------------------------
+void ofPath::setStrokeMiterLimit(float limit){
+	stroker.setMiterLimit(limit);
+	bNeedsStroke = true;
+}
+
+//----------------------------------------------------------
+void ofPath::setStrokeDashes(const vector<float> & dashes, float offset){
+	stroker.setDashes(dashes, offset);
+	bNeedsStroke = true;
 }
 
 //----------------------------------------------------------
@@ -486,6 +518,26 @@ float ofPath::getStrokeWidth() const{
 	return strokeWidth;
 }
 
+//----------------------------------------------------------
+ofStrokeJoin ofPath::getStrokeJoin() const{
+	return stroker.getJoin();
+}
+
+//----------------------------------------------------------
+ofStrokeCap ofPath::getStrokeCap() const{
+	return stroker.getCap();
+}
+
+//----------------------------------------------------------
+float ofPath::getStrokeMiterLimit() const{
+	return stroker.getMiterLimit();
+}
+
+//----------------------------------------------------------
+const ofStroker & ofPath::getStroker() const{
+	return stroker;
+}
+
 //----------------------------------------------------------
 void ofPath::generatePolylinesFromCommands(){
 	if(mode==POLYLINES || commands.empty()) return;
@@ -535,15 +587,41 @@ void ofPath::generatePolylinesFromCommands(){
 //----------------------------------------------------------
 void ofPath::tessellate(){
 	generatePolylinesFromCommands();
-	if(!bNeedsTessellation) return;
-	if(bFill){
-		tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
-		cachedTessellationValid=true;
+	if(bNeedsTessellation){
+		ofTessellator & tessellator = ofTessellator::getThreadTessellator();
+		if(bFill){
+			tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
+			cachedTessellationValid=true;
+		}
+		if(hasOutline() && windingMode!=OF_POLY_WINDING_ODD){
+			tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
+		}
+		bNeedsTessellation = false;
+		bNeedsStroke = true;
 	}
-	if(hasOutline() && windingMode!=OF_POLY_WINDING_ODD){
-		tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
+	if(bNeedsStroke && usesStrokeMesh()){
+		cachedStroke.clear();
+		stroker.stroke(windingMode!=OF_POLY_WINDING_ODD ? tessellatedContour : polylines, cachedStroke);
+		bNeedsStroke = false;
 	}
-	bNeedsTessellation = false;
+}
+
+//----------------------------------------------------------
+void ofPath::tessellate(vector<ofPath> & paths){
+	ofParallelFor(0, paths.size(), [&](int begin, int end){
+		for(int i=begin;i<end;i++){
+			paths[i].tessellate();
+		}
+	});
+}
+
+//----------------------------------------------------------
+void ofPath::tessellate(const vector<ofPath*> & paths){
+	ofParallelFor(0, paths.size(), [&](int begin, int end){
+		for(int i=begin;i<end;i++){
+			paths[i]->tessellate();
+		}
+	});
 }
 
 //----------------------------------------------------------
@@ -563,6 +641,23 @@ ofMesh & ofPath::getTessellation(){
 	return cachedTessellation;
 }
 
+//----------------------------------------------------------
+ofMesh & ofPath::getStrokeMesh(){
+	tessellate();
+	if(bNeedsStroke){
+		// the path has no outline or it's drawn with gl lines
+		cachedStroke.clear();
+		stroker.stroke(getOutline(), cachedStroke);
+		bNeedsStroke = false;
+	}
+	return cachedStroke;
+}
+
+//----------------------------------------------------------
+bool ofPath::usesStrokeMesh() const{
+	return hasOutline() && (strokeWidth>1 || stroker.isDashed());
+}
+
 //----------------------------------------------------------
 void ofPath::draw(float x, float y){
 	ofPushMatrix();
@@ -594,16 +689,20 @@ void ofPath::draw(){
 		}
 
 		if(hasOutline()){
-			float lineWidth = ofGetStyle().lineWidth;
 			if(bUseShapeColor){
 				ofSetColor(strokeColor);
 			}
-			ofSetLineWidth( strokeWidth );
-			vector<ofPolyline> & polys = getOutline();
-			for(int i=0;i<(int)polys.size();i++){
-				ofGetCurrentRenderer()->draw(polys[i]);
+			if(usesStrokeMesh()){
+				cachedStroke.draw();
+			}else{
+				float lineWidth = ofGetStyle().lineWidth;
+				ofSetLineWidth( strokeWidth );
+				vector<ofPolyline> & polys = getOutline();
+				for(int i=0;i<(int)polys.size();i++){
+					ofGetCurrentRenderer()->draw(polys[i]);
+				}
+				ofSetLineWidth(lineWidth);
 			}
-			ofSetLineWidth(lineWidth);
 		}
 
 		if(bUseShapeColor){
@@ -713,9 +812,7 @@ void ofPath::setStrokeHexColor( int hex ) {
 //----------------------------------------------------------
 void ofPath::simplify(float tolerance){
 	if(mode==COMMANDS) generatePolylinesFromCommands();
-	for(int i=0;i<(int)polylines.size();i++){
-		polylines[i].simplify(tolerance);
-	}
+	ofPolyline::simplify(polylines, tolerance);
 }
 
 //----------------------------------------------------------
@@ -7,6 +7,7 @@
 #include "ofBaseTypes.h"
 #include "ofVboMesh.h"
 #include "ofTessellator.h"
+#include "ofStroker.h"
 
 
 class ofPath{
@@ -94,6 +95,10 @@ public:
 	void setFillHexColor( int hex );
 	void setStrokeColor(const ofColor & color);
 	void setStrokeHexColor( int hex );
+	void setStrokeJoin(ofStrokeJoin join); // default OF_STROKE_JOIN_MITER
+	void setStrokeCap(ofStrokeCap cap); // default OF_STROKE_CAP_BUTT
+	void setStrokeMiterLimit(float limit); // default 4
+	void setStrokeDashes(const vector<float> & dashes, float offset=0);
 
 
 	ofPolyWindingMode getWindingMode() const;
@@ -101,6 +106,10 @@ public:
 	ofColor getFillColor() const;
 	ofColor getStrokeColor() const;
 	float getStrokeWidth() const; // default 0
+	ofStrokeJoin getStrokeJoin() const;
+	ofStrokeCap getStrokeCap() const;
+	float getStrokeMiterLimit() const;
+	const ofStroker & getStroker() const;
 	bool hasOutline() const { return strokeWidth>0; }
 
 	void draw(float x, float y);
@@ -109,6 +118,12 @@ public:
 	vector<ofPolyline> & getOutline();
 	ofMesh & getTessellation();
 
+	// the outline as triangles with the stroke width, joins, caps and dashes.
+	// outlines wider than 1 or dashed are drawn with it instead of gl lines,
+	// which most gl es and core profile drivers can't draw wider than 1
+	ofMesh & getStrokeMesh();
+	bool usesStrokeMesh() const;
+
 	void simplify(float tolerance=0.3);
 
 	// only needs to be called when path is modified externally
@@ -137,6 +152,13 @@ public:
 	
 	void tessellate();
 
+	// tessellates every path that needs it, splitting them over
+	// ofParallelFor, each thread with its own tessellator. this can run on
+	// any thread as long as the paths aren't used anywhere else meanwhile,
+	// drawing them afterwards only uploads the meshes
+	static void tessellate(vector<ofPath> & paths);
+	static void tessellate(const vector<ofPath*> & paths);
+
 	void translate(const ofPoint & p);
 	void rotate(float az, const ofVec3f& axis );
 	void scale(float x, float y);
@@ -202,7 +224,13 @@ private:
 #endif
 	bool				cachedTessellationValid;
 
-	static ofTessellator tessellator;
+	ofStroker			stroker;
+#ifdef TARGET_OPENGLES
+	ofMesh				cachedStroke;
+#else
+	ofVboMesh			cachedStroke;
+#endif
+	bool				bNeedsStroke;
 
 	bool				bHasChanged;
 	int					prevCurveRes;
@@ -1,5 +1,9 @@
 #include "ofPixels.h"
 #include "ofMath.h"
+#include "ofParallel.h"
+
+// pixel buffers are aligned for the widest simd loads used by the kernels
+static const size_t pixelsAlignment = 32;
 
 
 static ofImageType getImageTypeFromChannels(int channels){
@@ -166,7 +170,7 @@ void ofPixels_<PixelType>::allocate(int w, int h, int _channels){
 	width= w;
 	height = h;
 
-	pixels = new PixelType[w * h * channels];
+	pixels = (PixelType*)ofPixelsPoolAllocate((size_t)w * h * channels * sizeof(PixelType), pixelsAlignment);
 	bAllocated = true;
 	pixelsOwner = true;
 }
@@ -219,18 +223,13 @@ void ofPixels_<PixelType>::allocate(int w, int h, ofImageType type){
 
 template<typename PixelType>
 void ofPixels_<PixelType>::swapRgb(){
-	if (channels >= 3){
-		int sizePixels = width*height*channels;
-		for (int i=0; i< sizePixels; i+=channels){
-			std::swap(pixels[i],pixels[i+2]);
-		}
-	}
+	ofSwapPixelsRB(pixels, channels, (size_t)width*height);
 }
 
 template<typename PixelType>
 void ofPixels_<PixelType>::clear(){
 	if(pixels){
-		if(pixelsOwner) delete[] pixels;
+		if(pixelsOwner) ofPixelsPoolRelease(pixels, (size_t)width * height * channels * sizeof(PixelType), pixelsAlignment);
 		pixels = NULL;
 	}
 
@@ -356,25 +355,7 @@ void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
 	ofPixels_<PixelType> dst;
 	dst.allocate(width,height,imageType);
-	PixelType * dstPtr = &dst[0];
-	PixelType * srcPtr = &pixels[0];
-	int diffNumChannels = 0;
-	if(dst.getNumChannels()<getNumChannels()){
-		diffNumChannels = getNumChannels()-dst.getNumChannels();
-	}
-	for(int i=0;i<width*height;i++){
-		const PixelType & gray = *srcPtr;
-		for(int j=0;j<dst.getNumChannels();j++){
-			if(j<getNumChannels()){
-				*dstPtr++ =  *srcPtr++;
-			}else if(j<3){
-				*dstPtr++ = gray;
-			}else{
-				*dstPtr++ = ofColor_<PixelType>::limit();
-			}
-		}
-		srcPtr+=diffNumChannels;
-	}
+	ofConvertPixelChannels(pixels, channels, dst.pixels, dst.channels, (size_t)width*height, (PixelType)ofColor_<PixelType>::limit());
 	swap(dst);
 }
 
@@ -421,37 +402,12 @@ void ofPixels_<PixelType>::crop(int x, int y, int _width, int _height){
 		_width = ofClamp(_width,1,getWidth());
 		_height = ofClamp(_height,1,getHeight());
 
-		int bytesPerPixel = channels;
-
-		int newWidth = _width;
-		int newHeight = _height;
-		
-		PixelType * newPixels = new PixelType[newWidth*newHeight*bytesPerPixel];
-		memset(newPixels, 0, newWidth*newHeight*channels*sizeof(PixelType));
-
-		// this prevents having to do a check for bounds in the for loop;
-		int minX = MAX(x, 0);
-		int maxX = MIN(x+_width, width);
-		int minY = MAX(y, 0);
-		int maxY = MIN(y+_height, height);
-
-		// TODO: point math can help speed this up:
-		for (int i = minX; i < maxX; i++){
-			for (int j = minY; j < maxY; j++){
-
-				int newPixel = (j-y) * newWidth + (i-x);
-				int oldPixel = (j) * width + (i);
-
-				for (int k = 0; k < bytesPerPixel; k++){
-					newPixels[newPixel*bytesPerPixel + k] = pixels[oldPixel*bytesPerPixel + k];
-				}
-			}
-		}
-
-		delete [] pixels;
-		pixels = newPixels;
-		width = newWidth;
-		height = newHeight;
+		// the parts outside of the original image are left black
+		ofPixels_<PixelType> newPixels;
+		newPixels.allocate(_width, _height, channels);
+		newPixels.set(0);
+		getView(x, y, _width, _height).pasteInto(newPixels, MAX(x, 0) - x, MAX(y, 0) - y);
+		swap(newPixels);
 	}
 }
 
@@ -465,35 +421,11 @@ void ofPixels_<PixelType>::cropTo(ofPixels_<PixelType> &toPix, int x, int y, int
 		_width = ofClamp(_width,1,getWidth());
 		_height = ofClamp(_height,1,getHeight());
 
-		int bytesPerPixel = channels;
-
 		if ((toPix.width != _width) || (toPix.height != _height) || (toPix.channels != channels)){
 			toPix.allocate(_width, _height, channels);
 		}
 
-		int newWidth = _width;
-		PixelType * newPixels = toPix.pixels;
-
-		// this prevents having to do a check for bounds in the for loop;
-		int minX = MAX(x, 0);
-		int maxX = MIN(x+_width, width);
-		int minY = MAX(y, 0);
-		int maxY = MIN(y+_height, height);
-
-		// TODO: point math can help speed this up:
-		for (int i = minX; i < maxX; i++){
-			for (int j = minY; j < maxY; j++){
-
-				int newPixel = (j-y) * newWidth + (i-x);
-				int oldPixel = (j) * width + (i);
-
-				for (int k = 0; k < bytesPerPixel; k++){
-					newPixels[newPixel*bytesPerPixel + k] = pixels[oldPixel*bytesPerPixel + k];
-				}
-			}
-		}
-
-
+		getView(x, y, _width, _height).pasteInto(toPix, MAX(x, 0) - x, MAX(y, 0) - y);
 	}
 
 }
@@ -528,36 +460,8 @@ void ofPixels_<PixelType>::rotate90To(ofPixels_<PixelType> & dst, int nClockwise
 	}
 
 	// otherwise, we will need to do some new allocaiton.
-	dst.allocate(height,width,getImageType());
-    
-	int strideSrc = width * channels;
-	int strideDst = dst.width * channels;
-
-	if(rotation == 1){
-		PixelType * srcPixels = pixels;
-		for (int i = 0; i < height; i++){
-			PixelType * dstPixels = dst.getPixels() + (strideDst - channels*(i+1));
-			for (int j = 0; j < width; j++){
-				for (int k = 0; k < channels; k++){
-					dstPixels[k] = srcPixels[k];
-				}
-				srcPixels += channels;
-				dstPixels += strideDst;
-			}
-		}
-	} else if(rotation == 3){
-		PixelType * dstPixels = dst.pixels;
-		for (int i = 0; i < dst.height; i++){
-			PixelType * srcPixels = pixels + (strideSrc - channels*(i+1));
-			for (int j = 0; j < dst.width; j++){
-				for (int k = 0; k < channels; k++){
-					dstPixels[k] = srcPixels[k];
-				}
-				srcPixels += strideSrc;
-				dstPixels += channels;
-			}
-		}
-	}
+	dst.allocate(height,width,channels);
+	ofRotatePixels90(pixels, width, height, channels, dst.pixels, rotation == 1);
 }
 
 //----------------------------------------------------------------------
@@ -587,50 +491,17 @@ void ofPixels_<PixelType>::rotate90(int nClockwiseRotations){
 
 	ofPixels_<PixelType> newPixels;
 	rotate90To(newPixels,nClockwiseRotations);
-	delete [] pixels;
-	pixels = newPixels.pixels;
-	width = newPixels.width;
-	height = newPixels.height;
-	newPixels.pixelsOwner = false;
+	swap(newPixels);
 
 }
 
 //----------------------------------------------------------------------
 template<typename PixelType>
 void ofPixels_<PixelType>::mirror(bool vertically, bool horizontal){
-
-	if (!vertically && !horizontal){
+	if (bAllocated == false || (!vertically && !horizontal)){
 		return;
 	}
-
-	int bytesPerPixel = channels;
-	PixelType * oldPixels = pixels;
-	PixelType tempVal;
-
-	if (! (vertically && horizontal)){
-		int wToDo = horizontal ? width/2 : width;
-		int hToDo = vertically ? height/2 : height;
-
-		for (int i = 0; i < wToDo; i++){
-			for (int j = 0; j < hToDo; j++){
-
-				int pixelb = (vertically ? (height - j - 1) : j) * width + (horizontal ? (width - i - 1) : i);
-				int pixela = j*width + i;
-				for (int k = 0; k < bytesPerPixel; k++){
-
-					tempVal = oldPixels[pixela*bytesPerPixel + k];
-					oldPixels[pixela*bytesPerPixel + k] = oldPixels[pixelb*bytesPerPixel + k];
-					oldPixels[pixelb*bytesPerPixel + k] = tempVal;
-
-				}
-			}
-		}
-	} else {
-		// I couldn't think of a good way to do this in place.  I'm sure there is.
-		mirror(true, false);
-		mirror(false, true);
-	}
-
+	ofMirrorPixels(pixels, width, height, channels, pixels, vertically, horizontal);
 }
 
 //----------------------------------------------------------------------
@@ -646,30 +517,12 @@ void ofPixels_<PixelType>::mirrorTo(ofPixels_<PixelType> & dst, bool vertically,
 		return;
 	}
 
-	int bytesPerPixel = channels;
-
-	if (! (vertically && horizontal)){
-		int wToDo = horizontal ? width/2 : width;
-		int hToDo = vertically ? height/2 : height;
-
-		for (int i = 0; i < wToDo; i++){
-			for (int j = 0; j < hToDo; j++){
-
-				int pixelb = (vertically ? (height - j - 1) : j) * width + (horizontal ? (width - i - 1) : i);
-				int pixela = j*width + i;
-				for (int k = 0; k < bytesPerPixel; k++){
-					dst[pixela*bytesPerPixel + k] = pixels[pixelb*bytesPerPixel + k];
-					dst[pixelb*bytesPerPixel + k] = pixels[pixela*bytesPerPixel + k];
-
-				}
-			}
-		}
-	} else {
-		// I couldn't think of a good way to do this in place.  I'm sure there is.
-		mirrorTo(dst,true, false);
-		dst.mirror(false, true);
+	if (bAllocated == false){
+		return;
 	}
 
+	dst.allocate(width,height,channels);
+	ofMirrorPixels(pixels, width, height, channels, dst.pixels, vertically, horizontal);
 }
 
 //----------------------------------------------------------------------
@@ -683,65 +536,167 @@ bool ofPixels_<PixelType>::resize(int dstWidth, int dstHeight, ofInterpolationMe
 
 	if(!resizeTo(dstPixels,interpMethod)) return false;
 
-	delete [] pixels;
-	pixels = dstPixels.getPixels();
-	width  = dstWidth;
-	height = dstHeight;
-	dstPixels.pixelsOwner = false;
+	swap(dstPixels);
 	return true;
 }
 
 //----------------------------------------------------------------------
+// separable resampling: the weights of every output column / row are
+// precomputed once, then the image is filtered horizontally into a float
+// buffer and vertically from it, each pass split by rows across threads
+
+// filter support in source pixels when upscaling, it's stretched by the
+// scale factor when downscaling so every source pixel contributes
+static float getFilterSupport(ofInterpolationMethod interpMethod){
+	switch(interpMethod){
+	case OF_INTERPOLATE_BICUBIC: return 2;
+	case OF_INTERPOLATE_LANCZOS: return 3;
+	case OF_INTERPOLATE_AREA: return 0.5;
+	case OF_INTERPOLATE_BILINEAR:
+	default: return 1;
+	}
+}
+
+static float filterWeight(ofInterpolationMethod interpMethod, float x){
+	x = fabs(x);
+	switch(interpMethod){
+	case OF_INTERPOLATE_BICUBIC:
+		// catmull-rom, same curve as the previous per pixel bicubic patch
+		if(x < 1) return (1.5f*x - 2.5f)*x*x + 1;
+		if(x < 2) return ((-0.5f*x + 2.5f)*x - 4)*x + 2;
+		return 0;
+	case OF_INTERPOLATE_LANCZOS:{
+		if(x < 1e-5f) return 1;
+		if(x >= 3) return 0;
+		float px = PI * x;
+		return 3 * sin(px) * sin(px / 3) / (px * px);
+	}
+	case OF_INTERPOLATE_BILINEAR:
+	default:
+		return x < 1 ? 1 - x : 0;
+	}
+}
+
+struct ofResampleWeights{
+	int taps;
+	vector<int> indices;	// dstSize * taps source indices
+	vector<float> weights;	// dstSize * taps normalized weights
+};
+
+static void computeResampleWeights(int srcSize, int dstSize, ofInterpolationMethod interpMethod, ofResampleWeights & weights){
+	float scale = float(srcSize) / dstSize;
+	// bilinear keeps the classic 2 taps, area upscaling is the same as bilinear
+	if(interpMethod == OF_INTERPOLATE_AREA && scale <= 1){
+		interpMethod = OF_INTERPOLATE_BILINEAR;
+	}
+	float filterScale = (interpMethod == OF_INTERPOLATE_BILINEAR) ? 1 : MAX(scale, 1.f);
+	float support = getFilterSupport(interpMethod) * filterScale;
+
+	weights.taps = (int)ceil(support) * 2 + 1;
+	weights.indices.assign(dstSize * weights.taps, 0);
+	weights.weights.assign(dstSize * weights.taps, 0);
+
+	for(int i=0; i<dstSize; i++){
+		int * indices = &weights.indices[i * weights.taps];
+		float * w = &weights.weights[i * weights.taps];
+		float center = (i + 0.5f) * scale - 0.5f;
+		int first = (int)ceil(center - support);
+		int last = (int)floor(center + support);
+		if(interpMethod == OF_INTERPOLATE_AREA){
+			first = (int)floor(i * scale);
+			last = (int)ceil((i + 1) * scale) - 1;
+		}
+		float total = 0;
+		int tap = 0;
+		for(int j=first; j<=last && tap<weights.taps; j++, tap++){
+			float weight;
+			if(interpMethod == OF_INTERPOLATE_AREA){
+				// exact coverage of the source pixel by the destination one
+				float srcStart = i * scale;
+				float srcEnd = srcStart + scale;
+				weight = MAX(0.f, MIN(srcEnd, j + 1.f) - MAX(srcStart, float(j)));
+			}else{
+				weight = filterWeight(interpMethod, (j - center) / filterScale);
+			}
+			indices[tap] = ofClamp(j, 0, srcSize - 1);
+			w[tap] = weight;
+			total += weight;
+		}
+		if(total != 0){
+			for(int t=0; t<tap; t++){
+				w[t] /= total;
+			}
+		}
+	}
+}
+
 template<typename PixelType>
-float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,float y, float x2,float y2, float x3,float y3) {
-	// adapted from http://www.paulinternet.nl/?page=bicubic
-	// Note that this code can produce values outside of 0...255, due to cubic overshoot.
-	// The ofClamp() prevents this from happening.
-
-	float p00 = patch[ 0];
-	float p10 = patch[ 4];
-	float p20 = patch[ 8];
-	float p30 = patch[12];
-
-	float p01 = patch[ 1];
-	float p11 = patch[ 5];
-	float p21 = patch[ 9];
-	float p31 = patch[13];
-
-	float p02 = patch[ 2];
-	float p12 = patch[ 6];
-	float p22 = patch[10];
-	float p32 = patch[14];
-
-	float p03 = patch[ 3];
-	float p13 = patch[ 7];
-	float p23 = patch[11];
-	float p33 = patch[15];
-
-	float a00 =    p11;
-	float a01 =   -p10 +   p12;
-	float a02 =  2.0f*p10 - 2.0f*p11 +   p12 -   p13;
-	float a03 =   -p10 +   p11 -   p12 +   p13;
-	float a10 =   -p01 +   p21;
-	float a11 =    p00 -   p02 -   p20 +   p22;
-	float a12 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p20 - 2.0f*p21 +   p22 -   p23;
-	float a13 =    p00 -   p01 +   p02 -   p03 -   p20 +   p21 -   p22 +   p23;
-	float a20 =  2.0f*p01 - 2.0f*p11 +   p21 -   p31;
-	float a21 = -2.0f*p00 + 2.0f*p02 + 2.0f*p10 - 2.0f*p12 -   p20 +   p22 +   p30 -   p32;
-	float a22 =  4*p00 - 4*p01 + 2.0f*p02 - 2.0f*p03 - 4*p10 + 4*p11 - 2.0f*p12 + 2.0f*p13 + 2.0f*p20 - 2.0f*p21 + p22 - p23 - 2.0f*p30 + 2.0f*p31 - p32 + p33;
-	float a23 = -2.0f*p00 + 2.0f*p01 - 2.0f*p02 + 2.0f*p03 + 2.0f*p10 - 2.0f*p11 + 2.0f*p12 - 2.0f*p13 -   p20 +   p21 - p22 + p23 +   p30 -   p31 + p32 - p33;
-	float a30 =   -p01 +   p11 -   p21 +   p31;
-	float a31 =    p00 -   p02 -   p10 +   p12 +   p20 -   p22 -   p30 +   p32;
-	float a32 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p10 - 2.0f*p11 +   p12 -   p13 - 2.0f*p20 + 2.0f*p21 - p22 + p23 + 2.0f*p30 - 2.0f*p31 + p32 - p33;
-	float a33 =    p00 -   p01 +   p02 -   p03 -   p10 +   p11 -   p12 +   p13 +   p20 -   p21 + p22 - p23 -   p30 +   p31 - p32 + p33;
-
-	float out =
-    a00      + a01 * y      + a02 * y2      + a03 * y3 +
-    a10 * x  + a11 * x  * y + a12 * x  * y2 + a13 * x  * y3 +
-    a20 * x2 + a21 * x2 * y + a22 * x2 * y2 + a23 * x2 * y3 +
-    a30 * x3 + a31 * x3 * y + a32 * x3 * y2 + a33 * x3 * y3;
-
-	return MIN(255, MAX(out, 0));
+static inline PixelType resampleToPixel(float value){
+	if(numeric_limits<PixelType>::is_integer){
+		value = ofClamp(value, numeric_limits<PixelType>::min(), numeric_limits<PixelType>::max());
+		return PixelType(value < 0 ? value - 0.5f : value + 0.5f);
+	}else{
+		return PixelType(value);
+	}
+}
+
+template<typename PixelType>
+static void resampleSeparable(const ofPixelsView_<PixelType> & srcView, const ofPixelsView_<PixelType> & dstView, ofInterpolationMethod interpMethod){
+	int srcWidth = srcView.getWidth();
+	int srcHeight = srcView.getHeight();
+	int dstWidth = dstView.getWidth();
+	int dstHeight = dstView.getHeight();
+	int channels = srcView.getNumChannels();
+
+	ofResampleWeights horizontal, vertical;
+	computeResampleWeights(srcWidth, dstWidth, interpMethod, horizontal);
+	computeResampleWeights(srcHeight, dstHeight, interpMethod, vertical);
+
+	// horizontal pass, every source row to dstWidth columns
+	vector<float> tmp(srcHeight * dstWidth * channels);
+	ofParallelFor(0, srcHeight, [&](int rowBegin, int rowEnd){
+		for(int y=rowBegin; y<rowEnd; y++){
+			const PixelType * srcRow = srcView.getRow(y);
+			float * tmpRow = &tmp[y * dstWidth * channels];
+			for(int x=0; x<dstWidth; x++){
+				const int * indices = &horizontal.indices[x * horizontal.taps];
+				const float * w = &horizontal.weights[x * horizontal.taps];
+				float * out = tmpRow + x * channels;
+				for(int c=0; c<channels; c++){
+					out[c] = 0;
+				}
+				for(int t=0; t<horizontal.taps; t++){
+					if(w[t] == 0) continue;
+					const PixelType * in = srcRow + indices[t] * channels;
+					for(int c=0; c<channels; c++){
+						out[c] += in[c] * w[t];
+					}
+				}
+			}
+		}
+	}, 16);
+
+	// vertical pass, dstHeight rows from the filtered ones
+	int rowSize = dstWidth * channels;
+	ofParallelFor(0, dstHeight, [&](int rowBegin, int rowEnd){
+		vector<float> accum(rowSize);
+		for(int y=rowBegin; y<rowEnd; y++){
+			const int * indices = &vertical.indices[y * vertical.taps];
+			const float * w = &vertical.weights[y * vertical.taps];
+			std::fill(accum.begin(), accum.end(), 0.f);
+			for(int t=0; t<vertical.taps; t++){
+				if(w[t] == 0) continue;
+				const float * in = &tmp[indices[t] * rowSize];
+				for(int i=0; i<rowSize; i++){
+					accum[i] += in[i] * w[t];
+				}
+			}
+			PixelType * dstRow = dstView.getRow(y);
+			for(int i=0; i<rowSize; i++){
+				dstRow[i] = resampleToPixel<PixelType>(accum[i]);
+			}
+		}
+	}, 8);
 }
 
 //----------------------------------------------------------------------
@@ -751,34 +706,111 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 		return true;
 	}
 
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel()) return false;
+	if (!(isAllocated()) || !(dst.isAllocated())) return false;
 
-	int srcWidth      = getWidth();
-	int srcHeight     = getHeight();
-	int dstWidth	  = dst.getWidth();
-	int dstHeight	  = dst.getHeight();
-	int bytesPerPixel = getBytesPerPixel();
+	return getView().resizeTo(dst.getView(), interpMethod);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo){
+	if (!(isAllocated()) || !(dst.isAllocated())) return false;
+
+	return getView().pasteInto(dst.getView(), xTo, yTo);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getView(){
+	return ofPixelsView_<PixelType>(*this);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getView(int x, int y, int _width, int _height){
+	return getView().getView(x, y, _width, _height);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromView(const ofPixelsView_<PixelType> & view){
+	if(!view.isAllocated()){
+		clear();
+		return;
+	}
+	if(view.isContiguous()){
+		setFromPixels(view.getPixels(), view.getWidth(), view.getHeight(), view.getNumChannels());
+		return;
+	}
+	allocate(view.getWidth(), view.getHeight(), view.getNumChannels());
+	view.pasteInto(*this, 0, 0);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_()
+:pixels(NULL)
+,width(0)
+,height(0)
+,channels(0)
+,stride(0){}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(PixelType * _pixels, int _width, int _height, int _channels, int _stride)
+:pixels(_pixels)
+,width(_width)
+,height(_height)
+,channels(_channels)
+,stride(_stride ? _stride : _width * _channels * sizeof(PixelType)){}
 
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(ofPixels_<PixelType> & pix)
+:pixels(pix.isAllocated() ? pix.getPixels() : NULL)
+,width(pix.getWidth())
+,height(pix.getHeight())
+,channels(pix.getNumChannels())
+,stride(pix.getWidth() * pix.getBytesPerPixel()){}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getView(int x, int y, int _width, int _height) const{
+	int minX = ofClamp(x, 0, width);
+	int minY = ofClamp(y, 0, height);
+	int maxX = ofClamp(x + _width, minX, width);
+	int maxY = ofClamp(y + _height, minY, height);
+	if(!isAllocated() || maxX == minX || maxY == minY){
+		return ofPixelsView_<PixelType>();
+	}
+	return ofPixelsView_<PixelType>(getRow(minY) + minX * channels, maxX - minX, maxY - minY, channels, stride);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::resizeTo(ofPixelsView_<PixelType> dst, ofInterpolationMethod interpMethod) const{
+	if (!isAllocated() || !dst.isAllocated() || channels != dst.channels) return false;
 
-	PixelType * dstPixels = dst.getPixels();
+	int srcWidth      = width;
+	int srcHeight     = height;
+	int dstWidth	  = dst.getWidth();
+	int dstHeight	  = dst.getHeight();
 
 	switch (interpMethod){
 
 			//----------------------------------------
 		case OF_INTERPOLATE_NEAREST_NEIGHBOR:{
-			int dstIndex = 0;
 			float srcxFactor = (float)srcWidth/dstWidth;
 			float srcyFactor = (float)srcHeight/dstHeight;
 			float srcy = 0.5;
 			for (int dsty=0; dsty<dstHeight; dsty++){
 				float srcx = 0.5;
-				int srcIndex = int(srcy)*srcWidth;
+				const PixelType * srcRow = getRow(int(srcy));
+				PixelType * dstPixels = dst.getRow(dsty);
 				for (int dstx=0; dstx<dstWidth; dstx++){
-					int pixelIndex = int(srcIndex + srcx) * bytesPerPixel;
-					for (int k=0; k<bytesPerPixel; k++){
-						dstPixels[dstIndex] = pixels[pixelIndex];
-						dstIndex++;
-						pixelIndex++;
+					const PixelType * srcPixel = srcRow + int(srcx) * channels;
+					for (int k=0; k<channels; k++){
+						*dstPixels++ = srcPixel[k];
 					}
 					srcx+=srcxFactor;
 				}
@@ -788,65 +820,36 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_BILINEAR:
-			// not implemented yet
-			ofLogError("ofPixels") << "resizeTo(): bilinear resize not implemented, not resizing";
-			break;
-
-			//----------------------------------------
 		case OF_INTERPOLATE_BICUBIC:
-			float px1, py1;
-			float px2, py2;
-			float px3, py3;
+		case OF_INTERPOLATE_AREA:
+		case OF_INTERPOLATE_LANCZOS:
+			resampleSeparable(*this, dst, interpMethod);
+			break;
 
-			float srcColor = 0;
-			float interpCol;
-			int patchRow;
-			int patchIndex;
-			float patch[16];
+		default:
+			ofLogError("ofPixels") << "resizeTo(): unknown interpolation method " << interpMethod << ", not resizing";
+			return false;
+	}
 
-			int srcRowBytes = srcWidth*bytesPerPixel;
-			int loIndex = (srcRowBytes)+1;
-			int hiIndex = (srcWidth*srcHeight*bytesPerPixel)-(srcRowBytes)-1;
+	return true;
+}
 
-			for (int dsty=0; dsty<dstHeight; dsty++){
-				for (int dstx=0; dstx<dstWidth; dstx++){
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::pasteInto(ofPixelsView_<PixelType> dst, int xTo, int yTo) const{
+	if (!isAllocated() || !dst.isAllocated() || channels != dst.channels || xTo>=dst.getWidth() || yTo>=dst.getHeight()) return false;
 
-					int   dstIndex0 = (dsty*dstWidth + dstx) * bytesPerPixel;
-					float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
-					float srcyf = srcHeight * (float)dsty/(float)dstHeight;
-					int   srcx = (int) MIN(srcWidth-1,   srcxf);
-					int   srcy = (int) MIN(srcHeight-1,  srcyf);
-					int   srcIndex0 = (srcy*srcWidth + srcx) * bytesPerPixel;
-
-					px1 = srcxf - srcx;
-					py1 = srcyf - srcy;
-					px2 = px1 * px1;
-					px3 = px2 * px1;
-					py2 = py1 * py1;
-					py3 = py2 * py1;
-
-					for (int k=0; k<bytesPerPixel; k++){
-						int   dstIndex = dstIndex0+k;
-						int   srcIndex = srcIndex0+k;
-
-						for (int dy=0; dy<4; dy++) {
-							patchRow = srcIndex + ((dy-1)*srcRowBytes);
-							for (int dx=0; dx<4; dx++) {
-								patchIndex = patchRow + (dx-1)*bytesPerPixel;
-								if ((patchIndex >= loIndex) && (patchIndex < hiIndex)) {
-									srcColor = pixels[patchIndex];
-								}
-								patch[dx*4 + dy] = srcColor;
-							}
-						}
-
-						interpCol = (PixelType)bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3);
-						dstPixels[dstIndex] = interpCol;
-					}
+	// clip the parts that fall outside of the destination
+	int xFrom = MAX(0, -xTo);
+	int yFrom = MAX(0, -yTo);
+	ofPixelsView_<PixelType> src = getView(xFrom, yFrom, dst.getWidth() - MAX(xTo, 0), dst.getHeight() - MAX(yTo, 0));
+	if(!src.isAllocated()) return false;
 
-				}
-			}
-			break;
+	int bytesToCopyPerRow = src.getWidth() * getBytesPerPixel();
+	int dstX = MAX(xTo, 0);
+	int dstY = MAX(yTo, 0);
+	for(int y=0;y<src.getHeight(); y++){
+		memcpy(dst.getRow(dstY + y) + dstX * channels, src.getRow(y), bytesToCopyPerRow);
 	}
 
 	return true;
@@ -854,23 +857,85 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 //----------------------------------------------------------------------
 template<typename PixelType>
-bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo){
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo>=dst.getWidth() || yTo>=dst.getHeight()) return false;
+PixelType * ofPixelsView_<PixelType>::getPixels() const{
+	return pixels;
+}
 
-	int bytesToCopyPerRow = (xTo + getWidth()<=dst.getWidth() ? getWidth() : dst.getWidth()-xTo) * getBytesPerPixel();
-	int columnsToCopy = yTo + getHeight() <= dst.getHeight() ? getHeight() : dst.getHeight()-yTo;
-	PixelType * dstPix = dst.getPixels() + ((xTo + yTo*dst.getWidth())*dst.getBytesPerPixel());
-	PixelType * srcPix = getPixels();
-	int srcStride = getWidth()*getBytesPerPixel();
-	int dstStride = dst.getWidth()*dst.getBytesPerPixel();
+//----------------------------------------------------------------------
+template<typename PixelType>
+PixelType * ofPixelsView_<PixelType>::getRow(int y) const{
+	return (PixelType*)((unsigned char*)pixels + y * stride);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofColor_<PixelType> ofPixelsView_<PixelType>::getColor(int x, int y) const{
+	ofColor_<PixelType> c;
+	const PixelType * pixel = getRow(y) + x * channels;
 
-	for(int y=0;y<columnsToCopy; y++){
-		memcpy(dstPix,srcPix,bytesToCopyPerRow);
-		dstPix += dstStride;
-		srcPix += srcStride;
+	if( channels == 1 ){
+		c.set( pixel[0] );
+	}else if( channels == 3 ){
+		c.set( pixel[0], pixel[1], pixel[2] );
+	}else if( channels == 4 ){
+		c.set( pixel[0], pixel[1], pixel[2], pixel[3] );
 	}
 
-	return true;
+	return c;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::isAllocated() const{
+	return pixels != NULL && width > 0 && height > 0;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::isContiguous() const{
+	return stride == getBytesPerPixel() * width;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getHeight() const{
+	return height;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getNumChannels() const{
+	return channels;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getStride() const{
+	return stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getBytesPerPixel() const{
+	return getBytesPerChannel() * channels;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getBytesPerChannel() const{
+	return sizeof(PixelType);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofImageType ofPixelsView_<PixelType>::getImageType() const{
+	return getImageTypeFromChannels(channels);
 }
 
 template class ofPixels_<char>;
@@ -883,3 +948,14 @@ template class ofPixels_<long>;
 template class ofPixels_<unsigned long>;
 template class ofPixels_<float>;
 template class ofPixels_<double>;
+
+template class ofPixelsView_<char>;
+template class ofPixelsView_<unsigned char>;
+template class ofPixelsView_<short>;
+template class ofPixelsView_<unsigned short>;
+template class ofPixelsView_<int>;
+template class ofPixelsView_<unsigned int>;
+template class ofPixelsView_<long>;
+template class ofPixelsView_<unsigned long>;
+template class ofPixelsView_<float>;
+template class ofPixelsView_<double>;
@@ -4,15 +4,70 @@
 #include "ofUtils.h"
 #include "ofColor.h"
 #include "ofMath.h"
+#include "ofPixelsKernels.h"
+#include "ofPixelsPool.h"
 #include <limits>
 
 //---------------------------------------
 enum ofInterpolationMethod {
 	OF_INTERPOLATE_NEAREST_NEIGHBOR =1,
 	OF_INTERPOLATE_BILINEAR			=2,
-	OF_INTERPOLATE_BICUBIC			=3
+	OF_INTERPOLATE_BICUBIC			=3,
+	OF_INTERPOLATE_AREA				=4, // averages the covered pixels, best for downscaling
+	OF_INTERPOLATE_LANCZOS			=5  // lanczos3, sharpest but slowest
 };
 
+template <typename PixelType>
+class ofPixels_;
+
+//---------------------------------------
+// non owning view over pixels that live somewhere else: an ofPixels_, a region
+// of one, a camera or opencv buffer with padded rows... the stride is the
+// distance in bytes from one row to the next so views of a region of a bigger
+// image don't need any copy. the memory has to outlive the view
+template <typename PixelType>
+class ofPixelsView_ {
+public:
+	ofPixelsView_();
+	// stride in bytes, 0 means rows are tightly packed
+	ofPixelsView_(PixelType * pixels, int width, int height, int channels, int stride = 0);
+	ofPixelsView_(ofPixels_<PixelType> & pixels);
+
+	// region of this view, clamped to its bounds
+	ofPixelsView_<PixelType> getView(int x, int y, int width, int height) const;
+
+	bool resizeTo(ofPixelsView_<PixelType> dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR) const;
+	bool pasteInto(ofPixelsView_<PixelType> dst, int x, int y) const;
+
+	PixelType * getPixels() const;
+	PixelType * getRow(int y) const;
+	ofColor_<PixelType> getColor(int x, int y) const;
+
+	bool isAllocated() const;
+	// true if the rows are back to back in memory with no padding
+	bool isContiguous() const;
+
+	int getWidth() const;
+	int getHeight() const;
+	int getNumChannels() const;
+	int getStride() const;
+	int getBytesPerPixel() const;
+	int getBytesPerChannel() const;
+	ofImageType getImageType() const;
+
+private:
+	PixelType * pixels;
+	int width;
+	int height;
+	int channels;
+	int stride;
+};
+
+typedef ofPixelsView_<unsigned char> ofPixelsView;
+typedef ofPixelsView_<float> ofFloatPixelsView;
+typedef ofPixelsView_<unsigned short> ofShortPixelsView;
+
+//---------------------------------------
 template <typename PixelType>
 class ofPixels_ {
 public:
@@ -38,6 +93,8 @@ public:
 	void setFromPixels(const PixelType * newPixels, int w, int h, ofImageType type);
 	void setFromExternalPixels(PixelType * newPixels, int w, int h, int channels);
 	void setFromAlignedPixels(const PixelType * newPixels, int width, int height, int channels, int stride);
+	// allocates and copies the pixels of the view packing its rows
+	void setFromView(const ofPixelsView_<PixelType> & view);
 	void swap(ofPixels_<PixelType> & pix);
 
 	//From ofPixelsUtils
@@ -58,6 +115,11 @@ public:
 
 	void swapRgb();
 
+	// views over all or a region of these pixels, no copy is made.
+	// regions are clamped to the image bounds
+	ofPixelsView_<PixelType> getView();
+	ofPixelsView_<PixelType> getView(int x, int y, int width, int height);
+
 	void clear();
 	
 	PixelType * getPixels();
@@ -93,8 +155,6 @@ public:
 	int size() const;
 
 private:
-	float bicubicInterpolate(const float *patch, float x,float y, float x2,float y2, float x3,float y3);
-
 	void copyFrom( const ofPixels_<PixelType>& mom );
 
 	template<typename SrcType>
@@ -151,22 +211,7 @@ template<typename SrcType>
 void ofPixels_<PixelType>::copyFrom(const ofPixels_<SrcType> & mom){
 	if(mom.isAllocated()){
 		allocate(mom.getWidth(),mom.getHeight(),mom.getNumChannels());
-
-		const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : numeric_limits<SrcType>::max() );
-		const float dstMax = ( (sizeof(PixelType) == sizeof(float) ) ? 1.f : numeric_limits<PixelType>::max() );
-		const float factor = dstMax / srcMax;
-
-		if(sizeof(SrcType) == sizeof(float)) {
-			// coming from float we need a special case to clamp the values
-			for(int i = 0; i < mom.size(); i++){
-				pixels[i] = CLAMP(mom[i], 0, 1) * factor;
-			}
-		} else{
-			// everything else is a straight scaling
-			for(int i = 0; i < mom.size(); i++){
-				pixels[i] = mom[i] * factor;
-			}
-		}
+		ofConvertPixelValues(mom.getPixels(), pixels, (size_t)mom.size());
 	}
 }
 
@@ -0,0 +1,978 @@
+#include "ofPixelsKernels.h"
+
+#if !defined(OF_PIXELS_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+	#define OF_PIXELS_SIMD_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define OF_TARGET_SSE2
+		#define OF_TARGET_SSSE3
+		#define OF_TARGET_AVX2
+	#else
+		// compile each kernel for its own instruction set so the rest of
+		// the library doesn't need any special flags
+		#define OF_TARGET_SSE2 __attribute__((target("sse2")))
+		#define OF_TARGET_SSSE3 __attribute__((target("ssse3")))
+		#define OF_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#elif !defined(OF_PIXELS_NO_SIMD) && defined(__wasm_simd128__)
+	#define OF_PIXELS_SIMD_WASM
+	#include <wasm_simd128.h>
+#endif
+
+//----------------------------------------------------------
+static ofSimdLevel detectSimdLevel(){
+#if defined(OF_PIXELS_SIMD_X86)
+	#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+		__cpuid(info, 1);
+		bool sse2 = (info[3] & (1<<26)) != 0;
+		bool ssse3 = (info[2] & (1<<9)) != 0;
+		bool osAvx = (info[2] & (1<<27)) && (info[2] & (1<<28)) && ((_xgetbv(0) & 6) == 6);
+		bool avx2 = false;
+		if(osAvx && maxLeaf >= 7){
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1<<5)) != 0;
+		}
+	#else
+		__builtin_cpu_init();
+		bool sse2 = __builtin_cpu_supports("sse2");
+		bool ssse3 = __builtin_cpu_supports("ssse3");
+		bool avx2 = __builtin_cpu_supports("avx2");
+	#endif
+	if(avx2 && ssse3) return OF_SIMD_AVX2;
+	if(ssse3 && sse2) return OF_SIMD_SSSE3;
+	if(sse2) return OF_SIMD_SSE2;
+	return OF_SIMD_NONE;
+#elif defined(OF_PIXELS_SIMD_WASM)
+	// wasm has no runtime detection, if the module was built with simd it can run it
+	return OF_SIMD_WASM128;
+#else
+	return OF_SIMD_NONE;
+#endif
+}
+
+static ofSimdLevel & currentSimdLevel(){
+	static ofSimdLevel level = ofGetSupportedSimdLevel();
+	return level;
+}
+
+//----------------------------------------------------------
+ofSimdLevel ofGetSupportedSimdLevel(){
+	static ofSimdLevel supported = detectSimdLevel();
+	return supported;
+}
+
+//----------------------------------------------------------
+ofSimdLevel ofGetSimdLevel(){
+	return currentSimdLevel();
+}
+
+//----------------------------------------------------------
+void ofSetSimdLevel(ofSimdLevel level){
+	ofSimdLevel supported = ofGetSupportedSimdLevel();
+	// wasm simd can't be mixed with the x86 levels
+	bool isSubset = supported != OF_SIMD_WASM128 && level <= supported;
+	if(level == OF_SIMD_NONE || level == supported || isSubset){
+		currentSimdLevel() = level;
+	}
+}
+
+#if defined(OF_PIXELS_SIMD_X86)
+// every kernel converts as many pixels as it can from the start of the buffers
+// and returns how many it did, the caller finishes the rest with a narrower
+// instruction set or the scalar loop
+
+//----------------------------------------------------------
+// sse2
+OF_TARGET_SSE2 static size_t u8ToU16_sse2(const unsigned char * src, unsigned short * dst, size_t n){
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		// x * 257 == x | x << 8
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, v));
+		_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, v));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t u8ToFloat_sse2(const unsigned char * src, float * dst, size_t n){
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 factor = _mm_set1_ps(1.f / 255.f);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_ps(dst + i,      _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), factor));
+		_mm_storeu_ps(dst + i + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), factor));
+		_mm_storeu_ps(dst + i + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), factor));
+		_mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), factor));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t u16ToU8_sse2(const unsigned short * src, unsigned char * dst, size_t n){
+	// go through float so the truncation matches the scalar code exactly
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 factor = _mm_set1_ps(255.f / 65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), factor));
+		__m128i hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), factor));
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(lo, hi), zero);
+		_mm_storel_epi64((__m128i*)(dst + i), packed);
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t u16ToFloat_sse2(const unsigned short * src, float * dst, size_t n){
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 factor = _mm_set1_ps(1.f / 65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_ps(dst + i,     _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), factor));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), factor));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static inline __m128i clampScaleTruncate_sse2(const float * src, __m128 factor){
+	__m128 v = _mm_max_ps(_mm_loadu_ps(src), _mm_setzero_ps());
+	v = _mm_min_ps(v, _mm_set1_ps(1.f));
+	return _mm_cvttps_epi32(_mm_mul_ps(v, factor));
+}
+
+OF_TARGET_SSE2 static size_t floatToU8_sse2(const float * src, unsigned char * dst, size_t n){
+	const __m128 factor = _mm_set1_ps(255.f);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i a = clampScaleTruncate_sse2(src + i, factor);
+		__m128i b = clampScaleTruncate_sse2(src + i + 4, factor);
+		__m128i c = clampScaleTruncate_sse2(src + i + 8, factor);
+		__m128i d = clampScaleTruncate_sse2(src + i + 12, factor);
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+		_mm_storeu_si128((__m128i*)(dst + i), packed);
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t floatToU16_sse2(const float * src, unsigned short * dst, size_t n){
+	// sse2 has no unsigned 32 -> 16 pack, bias into the signed range and back
+	const __m128 factor = _mm_set1_ps(65535.f);
+	const __m128i bias32 = _mm_set1_epi32(32768);
+	const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m128i a = _mm_sub_epi32(clampScaleTruncate_sse2(src + i, factor), bias32);
+		__m128i b = _mm_sub_epi32(clampScaleTruncate_sse2(src + i + 4, factor), bias32);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t grayToRgba_sse2(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	const __m128i a = _mm_set1_epi8((char)alpha);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i g = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i gg = _mm_unpacklo_epi8(g, g);
+		__m128i ga = _mm_unpacklo_epi8(g, a);
+		_mm_storeu_si128((__m128i*)(dst + i*4),      _mm_unpacklo_epi16(gg, ga));
+		_mm_storeu_si128((__m128i*)(dst + i*4 + 16), _mm_unpackhi_epi16(gg, ga));
+		gg = _mm_unpackhi_epi8(g, g);
+		ga = _mm_unpackhi_epi8(g, a);
+		_mm_storeu_si128((__m128i*)(dst + i*4 + 32), _mm_unpacklo_epi16(gg, ga));
+		_mm_storeu_si128((__m128i*)(dst + i*4 + 48), _mm_unpackhi_epi16(gg, ga));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t rgbaToGray_sse2(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i*4)), mask);
+		__m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i*4 + 16)), mask);
+		__m128i c = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i*4 + 32)), mask);
+		__m128i d = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i*4 + 48)), mask);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+	return i;
+}
+
+OF_TARGET_SSE2 static size_t swapRB4_sse2(unsigned char * pixels, size_t n){
+	const __m128i maskGA = _mm_set1_epi32((int)0xFF00FF00);
+	const __m128i maskLow = _mm_set1_epi32(0xFF);
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i*4));
+		__m128i ga = _mm_and_si128(v, maskGA);
+		__m128i r = _mm_slli_epi32(_mm_and_si128(v, maskLow), 16);
+		__m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), maskLow);
+		_mm_storeu_si128((__m128i*)(pixels + i*4), _mm_or_si128(ga, _mm_or_si128(r, b)));
+	}
+	return i;
+}
+
+// the transposes read a block from srcRows and write its columns to dstRows,
+// dstRows[i][j] = srcRows[j][i]. rotations pick the rows so the result is
+// already flipped
+OF_TARGET_SSE2 static void transpose8x8_sse2(const unsigned char * const * src, unsigned char * const * dst){
+	__m128i a0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)src[0]), _mm_loadl_epi64((const __m128i*)src[1]));
+	__m128i a1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)src[2]), _mm_loadl_epi64((const __m128i*)src[3]));
+	__m128i a2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)src[4]), _mm_loadl_epi64((const __m128i*)src[5]));
+	__m128i a3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)src[6]), _mm_loadl_epi64((const __m128i*)src[7]));
+	__m128i b0 = _mm_unpacklo_epi16(a0, a1);
+	__m128i b1 = _mm_unpackhi_epi16(a0, a1);
+	__m128i b2 = _mm_unpacklo_epi16(a2, a3);
+	__m128i b3 = _mm_unpackhi_epi16(a2, a3);
+	// each register now has two of the 8 columns
+	__m128i c0 = _mm_unpacklo_epi32(b0, b2);
+	__m128i c1 = _mm_unpackhi_epi32(b0, b2);
+	__m128i c2 = _mm_unpacklo_epi32(b1, b3);
+	__m128i c3 = _mm_unpackhi_epi32(b1, b3);
+	_mm_storel_epi64((__m128i*)dst[0], c0);
+	_mm_storel_epi64((__m128i*)dst[1], _mm_unpackhi_epi64(c0, c0));
+	_mm_storel_epi64((__m128i*)dst[2], c1);
+	_mm_storel_epi64((__m128i*)dst[3], _mm_unpackhi_epi64(c1, c1));
+	_mm_storel_epi64((__m128i*)dst[4], c2);
+	_mm_storel_epi64((__m128i*)dst[5], _mm_unpackhi_epi64(c2, c2));
+	_mm_storel_epi64((__m128i*)dst[6], c3);
+	_mm_storel_epi64((__m128i*)dst[7], _mm_unpackhi_epi64(c3, c3));
+}
+
+OF_TARGET_SSE2 static inline void transpose4x4_epi32_sse2(__m128i & r0, __m128i & r1, __m128i & r2, __m128i & r3){
+	__m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	__m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	__m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	__m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+OF_TARGET_SSE2 static void transpose4x4Rgba_sse2(const unsigned char * const * src, unsigned char * const * dst){
+	__m128i r0 = _mm_loadu_si128((const __m128i*)src[0]);
+	__m128i r1 = _mm_loadu_si128((const __m128i*)src[1]);
+	__m128i r2 = _mm_loadu_si128((const __m128i*)src[2]);
+	__m128i r3 = _mm_loadu_si128((const __m128i*)src[3]);
+	transpose4x4_epi32_sse2(r0, r1, r2, r3);
+	_mm_storeu_si128((__m128i*)dst[0], r0);
+	_mm_storeu_si128((__m128i*)dst[1], r1);
+	_mm_storeu_si128((__m128i*)dst[2], r2);
+	_mm_storeu_si128((__m128i*)dst[3], r3);
+}
+
+OF_TARGET_SSE2 static size_t mirrorRow4_sse2(const unsigned char * src, unsigned char * dst, size_t n){
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i*4));
+		_mm_storeu_si128((__m128i*)(dst + (n - i - 4)*4), _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3)));
+	}
+	return i;
+}
+
+//----------------------------------------------------------
+// ssse3, the 3 channel shuffles need pshufb
+OF_TARGET_SSSE3 static size_t rgbToRgba_ssse3(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	const __m128i shuffle = _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const __m128i a = _mm_set1_epi32((int)((unsigned int)alpha << 24));
+	size_t i = 0;
+	// each load reads 16 bytes but only uses 12
+	for(; i*3 + 16 <= n*3; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i*3));
+		_mm_storeu_si128((__m128i*)(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(v, shuffle), a));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static size_t rgbaToRgb_ssse3(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m128i shuffle = _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	size_t i = 0;
+	// each store writes 16 bytes, the last 4 are overwritten by the next one
+	for(; i*3 + 16 <= n*3; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i*4));
+		_mm_storeu_si128((__m128i*)(dst + i*3), _mm_shuffle_epi8(v, shuffle));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static size_t grayToRgb_ssse3(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m128i shuffle0 = _mm_setr_epi8(0,0,0, 1,1,1, 2,2,2, 3,3,3, 4,4,4, 5);
+	const __m128i shuffle1 = _mm_setr_epi8(5,5, 6,6,6, 7,7,7, 8,8,8, 9,9,9, 10,10);
+	const __m128i shuffle2 = _mm_setr_epi8(10, 11,11,11, 12,12,12, 13,13,13, 14,14,14, 15,15,15);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i g = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i*3),      _mm_shuffle_epi8(g, shuffle0));
+		_mm_storeu_si128((__m128i*)(dst + i*3 + 16), _mm_shuffle_epi8(g, shuffle1));
+		_mm_storeu_si128((__m128i*)(dst + i*3 + 32), _mm_shuffle_epi8(g, shuffle2));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static size_t rgbToGray_ssse3(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m128i shuffle0 = _mm_setr_epi8(0,3,6,9,12,15, -1,-1,-1,-1,-1, -1,-1,-1,-1,-1);
+	const __m128i shuffle1 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1, 2,5,8,11,14, -1,-1,-1,-1,-1);
+	const __m128i shuffle2 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1, 1,4,7,10,13);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i*3)), shuffle0);
+		__m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i*3 + 16)), shuffle1);
+		__m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i*3 + 32)), shuffle2);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(a, _mm_or_si128(b, c)));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static size_t swapRB3_ssse3(unsigned char * pixels, size_t n){
+	// swap 5 pixels per step, the 16th byte is written back untouched
+	const __m128i shuffle = _mm_setr_epi8(2,1,0, 5,4,3, 8,7,6, 11,10,9, 14,13,12, 15);
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 5){
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i*3));
+		_mm_storeu_si128((__m128i*)(pixels + i*3), _mm_shuffle_epi8(v, shuffle));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static void transpose4x4Rgb_ssse3(const unsigned char * const * src, unsigned char * const * dst){
+	// pad each pixel to 32 bits, transpose those and pack them back
+	const __m128i expand = _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const __m128i compact = _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	__m128i r[4];
+	for(int i = 0; i < 4; i++){
+		// exactly 12 bytes so the last pixel of the image can be read
+		int last;
+		memcpy(&last, src[i] + 8, 4);
+		__m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)src[i]), _mm_cvtsi32_si128(last));
+		r[i] = _mm_shuffle_epi8(v, expand);
+	}
+	transpose4x4_epi32_sse2(r[0], r[1], r[2], r[3]);
+	for(int i = 0; i < 4; i++){
+		__m128i v = _mm_shuffle_epi8(r[i], compact);
+		_mm_storel_epi64((__m128i*)dst[i], v);
+		int last = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+		memcpy(dst[i] + 8, &last, 4);
+	}
+}
+
+OF_TARGET_SSSE3 static size_t mirrorRow1_ssse3(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m128i reverse = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + n - i - 16), _mm_shuffle_epi8(v, reverse));
+	}
+	return i;
+}
+
+OF_TARGET_SSSE3 static size_t mirrorRow3_ssse3(const unsigned char * src, unsigned char * dst, size_t n){
+	// 5 pixels per step, stored one byte early so the unused byte lands on
+	// the pixel before them which is written by the next step
+	const __m128i reverse = _mm_setr_epi8(-1, 12,13,14, 9,10,11, 6,7,8, 3,4,5, 0,1,2);
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 5){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i*3));
+		_mm_storeu_si128((__m128i*)(dst + (n - i - 5)*3 - 1), _mm_shuffle_epi8(v, reverse));
+	}
+	return i;
+}
+
+//----------------------------------------------------------
+// avx2
+OF_TARGET_AVX2 static size_t u8ToU16_avx2(const unsigned char * src, unsigned short * dst, size_t n){
+	const __m256i factor = _mm256_set1_epi16(257);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + i)));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_mullo_epi16(v, factor));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t u8ToFloat_avx2(const unsigned char * src, float * dst, size_t n){
+	const __m256 factor = _mm256_set1_ps(1.f / 255.f);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m256i lo = _mm256_cvtepu8_epi32(v);
+		__m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8));
+		_mm256_storeu_ps(dst + i,     _mm256_mul_ps(_mm256_cvtepi32_ps(lo), factor));
+		_mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), factor));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t u16ToU8_avx2(const unsigned short * src, unsigned char * dst, size_t n){
+	const __m256 factor = _mm256_set1_ps(255.f / 65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+		__m256i t = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(v), factor));
+		__m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+		_mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(packed, packed));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t u16ToFloat_avx2(const unsigned short * src, float * dst, size_t n){
+	const __m256 factor = _mm256_set1_ps(1.f / 65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), factor));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static inline __m256i clampScaleTruncate_avx2(const float * src, __m256 factor){
+	__m256 v = _mm256_max_ps(_mm256_loadu_ps(src), _mm256_setzero_ps());
+	v = _mm256_min_ps(v, _mm256_set1_ps(1.f));
+	return _mm256_cvttps_epi32(_mm256_mul_ps(v, factor));
+}
+
+OF_TARGET_AVX2 static size_t floatToU8_avx2(const float * src, unsigned char * dst, size_t n){
+	const __m256 factor = _mm256_set1_ps(255.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i t = clampScaleTruncate_avx2(src + i, factor);
+		__m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+		_mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(packed, packed));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t floatToU16_avx2(const float * src, unsigned short * dst, size_t n){
+	const __m256 factor = _mm256_set1_ps(65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i t = clampScaleTruncate_avx2(src + i, factor);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1)));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t grayToRgba_avx2(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	// g * 0x010101 replicates the gray value in the 3 color bytes
+	const __m256i replicate = _mm256_set1_epi32(0x010101);
+	const __m256i a = _mm256_set1_epi32((int)((unsigned int)alpha << 24));
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i g = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+		_mm256_storeu_si256((__m256i*)(dst + i*4), _mm256_or_si256(_mm256_mullo_epi32(g, replicate), a));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t rgbToRgba_avx2(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	// pshufb works per 128 bit lane so load 4 pixels in each lane
+	const __m256i shuffle = _mm256_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1,
+	                                         0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const __m256i a = _mm256_set1_epi32((int)((unsigned int)alpha << 24));
+	size_t i = 0;
+	for(; i*3 + 28 <= n*3; i += 8){
+		__m128i lo = _mm_loadu_si128((const __m128i*)(src + i*3));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(src + i*3 + 12));
+		__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		_mm256_storeu_si256((__m256i*)(dst + i*4), _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), a));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t rgbaToRgb_avx2(const unsigned char * src, unsigned char * dst, size_t n){
+	const __m256i shuffle = _mm256_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1,
+	                                         0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	size_t i = 0;
+	for(; i*3 + 28 <= n*3; i += 8){
+		__m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(src + i*4)), shuffle);
+		// the second store overwrites the 4 unused bytes of the first one
+		_mm_storeu_si128((__m128i*)(dst + i*3), _mm256_castsi256_si128(v));
+		_mm_storeu_si128((__m128i*)(dst + i*3 + 12), _mm256_extracti128_si256(v, 1));
+	}
+	return i;
+}
+
+OF_TARGET_AVX2 static size_t swapRB4_avx2(unsigned char * pixels, size_t n){
+	const __m256i shuffle = _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15,
+	                                         2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i*4));
+		_mm256_storeu_si256((__m256i*)(pixels + i*4), _mm256_shuffle_epi8(v, shuffle));
+	}
+	return i;
+}
+#endif // OF_PIXELS_SIMD_X86
+
+#if defined(OF_PIXELS_SIMD_WASM)
+//----------------------------------------------------------
+// wasm simd, swizzle returns 0 for out of range indices like pshufb
+static size_t u8ToU16_wasm(const unsigned char * src, unsigned short * dst, size_t n){
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		v128_t v = wasm_v128_load(src + i);
+		wasm_v128_store(dst + i,     wasm_i8x16_shuffle(v, v, 0,0, 1,1, 2,2, 3,3, 4,4, 5,5, 6,6, 7,7));
+		wasm_v128_store(dst + i + 8, wasm_i8x16_shuffle(v, v, 8,8, 9,9, 10,10, 11,11, 12,12, 13,13, 14,14, 15,15));
+	}
+	return i;
+}
+
+static size_t u8ToFloat_wasm(const unsigned char * src, float * dst, size_t n){
+	const v128_t factor = wasm_f32x4_splat(1.f / 255.f);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		v128_t v = wasm_v128_load(src + i);
+		v128_t lo = wasm_u16x8_extend_low_u8x16(v);
+		v128_t hi = wasm_u16x8_extend_high_u8x16(v);
+		wasm_v128_store(dst + i,      wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(lo)), factor));
+		wasm_v128_store(dst + i + 4,  wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(lo)), factor));
+		wasm_v128_store(dst + i + 8,  wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(hi)), factor));
+		wasm_v128_store(dst + i + 12, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(hi)), factor));
+	}
+	return i;
+}
+
+static size_t u16ToFloat_wasm(const unsigned short * src, float * dst, size_t n){
+	const v128_t factor = wasm_f32x4_splat(1.f / 65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		v128_t v = wasm_v128_load(src + i);
+		wasm_v128_store(dst + i,     wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(v)), factor));
+		wasm_v128_store(dst + i + 4, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(v)), factor));
+	}
+	return i;
+}
+
+static inline v128_t clampScaleTruncate_wasm(const float * src, v128_t factor){
+	v128_t v = wasm_f32x4_pmax(wasm_v128_load(src), wasm_f32x4_splat(0.f));
+	v = wasm_f32x4_pmin(v, wasm_f32x4_splat(1.f));
+	return wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(v, factor));
+}
+
+static size_t floatToU8_wasm(const float * src, unsigned char * dst, size_t n){
+	const v128_t factor = wasm_f32x4_splat(255.f);
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		v128_t ab = wasm_i16x8_narrow_i32x4(clampScaleTruncate_wasm(src + i, factor), clampScaleTruncate_wasm(src + i + 4, factor));
+		v128_t cd = wasm_i16x8_narrow_i32x4(clampScaleTruncate_wasm(src + i + 8, factor), clampScaleTruncate_wasm(src + i + 12, factor));
+		wasm_v128_store(dst + i, wasm_u8x16_narrow_i16x8(ab, cd));
+	}
+	return i;
+}
+
+static size_t floatToU16_wasm(const float * src, unsigned short * dst, size_t n){
+	const v128_t factor = wasm_f32x4_splat(65535.f);
+	size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		wasm_v128_store(dst + i, wasm_u16x8_narrow_i32x4(clampScaleTruncate_wasm(src + i, factor), clampScaleTruncate_wasm(src + i + 4, factor)));
+	}
+	return i;
+}
+
+static size_t rgbToRgba_wasm(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	const v128_t shuffle = wasm_i8x16_make(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const v128_t a = wasm_i32x4_splat((int)((unsigned int)alpha << 24));
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 4){
+		v128_t v = wasm_v128_load(src + i*3);
+		wasm_v128_store(dst + i*4, wasm_v128_or(wasm_i8x16_swizzle(v, shuffle), a));
+	}
+	return i;
+}
+
+static size_t rgbaToRgb_wasm(const unsigned char * src, unsigned char * dst, size_t n){
+	const v128_t shuffle = wasm_i8x16_make(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 4){
+		v128_t v = wasm_v128_load(src + i*4);
+		wasm_v128_store(dst + i*3, wasm_i8x16_swizzle(v, shuffle));
+	}
+	return i;
+}
+
+static size_t grayToRgb_wasm(const unsigned char * src, unsigned char * dst, size_t n){
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		v128_t g = wasm_v128_load(src + i);
+		wasm_v128_store(dst + i*3,      wasm_i8x16_shuffle(g, g, 0,0,0, 1,1,1, 2,2,2, 3,3,3, 4,4,4, 5));
+		wasm_v128_store(dst + i*3 + 16, wasm_i8x16_shuffle(g, g, 5,5, 6,6,6, 7,7,7, 8,8,8, 9,9,9, 10,10));
+		wasm_v128_store(dst + i*3 + 32, wasm_i8x16_shuffle(g, g, 10, 11,11,11, 12,12,12, 13,13,13, 14,14,14, 15,15,15));
+	}
+	return i;
+}
+
+static size_t grayToRgba_wasm(const unsigned char * src, unsigned char * dst, size_t n, unsigned char alpha){
+	const v128_t a = wasm_i8x16_splat((char)alpha);
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		v128_t g = wasm_v128_load32_zero(src + i);
+		wasm_v128_store(dst + i*4, wasm_i8x16_shuffle(g, a, 0,0,0,16, 1,1,1,16, 2,2,2,16, 3,3,3,16));
+	}
+	return i;
+}
+
+static size_t swapRB3_wasm(unsigned char * pixels, size_t n){
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 5){
+		v128_t v = wasm_v128_load(pixels + i*3);
+		wasm_v128_store(pixels + i*3, wasm_i8x16_shuffle(v, v, 2,1,0, 5,4,3, 8,7,6, 11,10,9, 14,13,12, 15));
+	}
+	return i;
+}
+
+static size_t swapRB4_wasm(unsigned char * pixels, size_t n){
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		v128_t v = wasm_v128_load(pixels + i*4);
+		wasm_v128_store(pixels + i*4, wasm_i8x16_shuffle(v, v, 2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+	}
+	return i;
+}
+
+static void transpose8x8_wasm(const unsigned char * const * src, unsigned char * const * dst){
+	v128_t r[8];
+	for(int i = 0; i < 8; i++){
+		r[i] = wasm_v128_load64_zero(src[i]);
+	}
+	v128_t a0 = wasm_i8x16_shuffle(r[0], r[1], 0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);
+	v128_t a1 = wasm_i8x16_shuffle(r[2], r[3], 0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);
+	v128_t a2 = wasm_i8x16_shuffle(r[4], r[5], 0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);
+	v128_t a3 = wasm_i8x16_shuffle(r[6], r[7], 0,16,1,17,2,18,3,19,4,20,5,21,6,22,7,23);
+	v128_t b0 = wasm_i16x8_shuffle(a0, a1, 0,8,1,9,2,10,3,11);
+	v128_t b1 = wasm_i16x8_shuffle(a0, a1, 4,12,5,13,6,14,7,15);
+	v128_t b2 = wasm_i16x8_shuffle(a2, a3, 0,8,1,9,2,10,3,11);
+	v128_t b3 = wasm_i16x8_shuffle(a2, a3, 4,12,5,13,6,14,7,15);
+	v128_t c[4];
+	c[0] = wasm_i32x4_shuffle(b0, b2, 0,4,1,5);
+	c[1] = wasm_i32x4_shuffle(b0, b2, 2,6,3,7);
+	c[2] = wasm_i32x4_shuffle(b1, b3, 0,4,1,5);
+	c[3] = wasm_i32x4_shuffle(b1, b3, 2,6,3,7);
+	for(int i = 0; i < 4; i++){
+		wasm_v128_store64_lane(dst[i*2], c[i], 0);
+		wasm_v128_store64_lane(dst[i*2 + 1], c[i], 1);
+	}
+}
+
+static inline void transpose4x4_i32_wasm(v128_t * r){
+	v128_t t0 = wasm_i32x4_shuffle(r[0], r[1], 0,4,1,5);
+	v128_t t1 = wasm_i32x4_shuffle(r[2], r[3], 0,4,1,5);
+	v128_t t2 = wasm_i32x4_shuffle(r[0], r[1], 2,6,3,7);
+	v128_t t3 = wasm_i32x4_shuffle(r[2], r[3], 2,6,3,7);
+	r[0] = wasm_i64x2_shuffle(t0, t1, 0,2);
+	r[1] = wasm_i64x2_shuffle(t0, t1, 1,3);
+	r[2] = wasm_i64x2_shuffle(t2, t3, 0,2);
+	r[3] = wasm_i64x2_shuffle(t2, t3, 1,3);
+}
+
+static void transpose4x4Rgba_wasm(const unsigned char * const * src, unsigned char * const * dst){
+	v128_t r[4];
+	for(int i = 0; i < 4; i++){
+		r[i] = wasm_v128_load(src[i]);
+	}
+	transpose4x4_i32_wasm(r);
+	for(int i = 0; i < 4; i++){
+		wasm_v128_store(dst[i], r[i]);
+	}
+}
+
+static void transpose4x4Rgb_wasm(const unsigned char * const * src, unsigned char * const * dst){
+	const v128_t expand = wasm_i8x16_make(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const v128_t compact = wasm_i8x16_make(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	v128_t r[4];
+	for(int i = 0; i < 4; i++){
+		v128_t v = wasm_v128_load32_lane(src[i] + 8, wasm_v128_load64_zero(src[i]), 2);
+		r[i] = wasm_i8x16_swizzle(v, expand);
+	}
+	transpose4x4_i32_wasm(r);
+	for(int i = 0; i < 4; i++){
+		v128_t v = wasm_i8x16_swizzle(r[i], compact);
+		wasm_v128_store64_lane(dst[i], v, 0);
+		wasm_v128_store32_lane(dst[i] + 8, v, 2);
+	}
+}
+
+static size_t mirrorRow1_wasm(const unsigned char * src, unsigned char * dst, size_t n){
+	size_t i = 0;
+	for(; i + 16 <= n; i += 16){
+		v128_t v = wasm_v128_load(src + i);
+		wasm_v128_store(dst + n - i - 16, wasm_i8x16_shuffle(v, v, 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0));
+	}
+	return i;
+}
+
+static size_t mirrorRow3_wasm(const unsigned char * src, unsigned char * dst, size_t n){
+	const v128_t reverse = wasm_i8x16_make(-1, 12,13,14, 9,10,11, 6,7,8, 3,4,5, 0,1,2);
+	size_t i = 0;
+	for(; i*3 + 16 <= n*3; i += 5){
+		v128_t v = wasm_v128_load(src + i*3);
+		wasm_v128_store(dst + (n - i - 5)*3 - 1, wasm_i8x16_swizzle(v, reverse));
+	}
+	return i;
+}
+
+static size_t mirrorRow4_wasm(const unsigned char * src, unsigned char * dst, size_t n){
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		v128_t v = wasm_v128_load(src + i*4);
+		wasm_v128_store(dst + (n - i - 4)*4, wasm_i32x4_shuffle(v, v, 3,2,1,0));
+	}
+	return i;
+}
+#endif // OF_PIXELS_SIMD_WASM
+
+//----------------------------------------------------------
+// dispatchers, each one runs the widest kernel available, then the narrower
+// ones on what's left and the scalar templates for the last few pixels
+#if defined(OF_PIXELS_SIMD_X86)
+	#define OF_SIMD_AT_LEAST(level) (ofGetSimdLevel() >= level && ofGetSimdLevel() != OF_SIMD_WASM128)
+#else
+	#define OF_SIMD_AT_LEAST(level) (ofGetSimdLevel() == level)
+#endif
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const unsigned char * src, unsigned short * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += u8ToU16_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += u8ToU16_sse2(src + i, dst + i, numValues - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += u8ToU16_wasm(src, dst, numValues);
+#endif
+	ofConvertPixelValues<unsigned char,unsigned short>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const unsigned char * src, float * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += u8ToFloat_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += u8ToFloat_sse2(src + i, dst + i, numValues - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += u8ToFloat_wasm(src, dst, numValues);
+#endif
+	ofConvertPixelValues<unsigned char,float>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const unsigned short * src, unsigned char * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += u16ToU8_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += u16ToU8_sse2(src + i, dst + i, numValues - i);
+#endif
+	ofConvertPixelValues<unsigned short,unsigned char>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const unsigned short * src, float * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += u16ToFloat_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += u16ToFloat_sse2(src + i, dst + i, numValues - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += u16ToFloat_wasm(src, dst, numValues);
+#endif
+	ofConvertPixelValues<unsigned short,float>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const float * src, unsigned char * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += floatToU8_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += floatToU8_sse2(src + i, dst + i, numValues - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += floatToU8_wasm(src, dst, numValues);
+#endif
+	ofConvertPixelValues<float,unsigned char>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelValues(const float * src, unsigned short * dst, size_t numValues){
+	size_t i = 0;
+#if defined(OF_PIXELS_SIMD_X86)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += floatToU16_avx2(src, dst, numValues);
+	if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += floatToU16_sse2(src + i, dst + i, numValues - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+	if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += floatToU16_wasm(src, dst, numValues);
+#endif
+	ofConvertPixelValues<float,unsigned short>(src + i, dst + i, numValues - i);
+}
+
+//----------------------------------------------------------
+void ofConvertPixelChannels(const unsigned char * src, int srcChannels, unsigned char * dst, int dstChannels, size_t numPixels, unsigned char alpha){
+	size_t i = 0;
+	if(srcChannels==3 && dstChannels==4){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += rgbToRgba_avx2(src, dst, numPixels, alpha);
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += rgbToRgba_ssse3(src + i*3, dst + i*4, numPixels - i, alpha);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += rgbToRgba_wasm(src, dst, numPixels, alpha);
+#endif
+	}else if(srcChannels==4 && dstChannels==3){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += rgbaToRgb_avx2(src, dst, numPixels);
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += rgbaToRgb_ssse3(src + i*4, dst + i*3, numPixels - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += rgbaToRgb_wasm(src, dst, numPixels);
+#endif
+	}else if(srcChannels==1 && dstChannels==3){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += grayToRgb_ssse3(src, dst, numPixels);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += grayToRgb_wasm(src, dst, numPixels);
+#endif
+	}else if(srcChannels==1 && dstChannels==4){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += grayToRgba_avx2(src, dst, numPixels, alpha);
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += grayToRgba_sse2(src + i, dst + i*4, numPixels - i, alpha);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += grayToRgba_wasm(src, dst, numPixels, alpha);
+#endif
+	}else if(srcChannels==3 && dstChannels==1){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += rgbToGray_ssse3(src, dst, numPixels);
+#endif
+	}else if(srcChannels==4 && dstChannels==1){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += rgbaToGray_sse2(src, dst, numPixels);
+#endif
+	}
+	ofConvertPixelChannels<unsigned char>(src + i*srcChannels, srcChannels, dst + i*dstChannels, dstChannels, numPixels - i, alpha);
+}
+
+//----------------------------------------------------------
+void ofSwapPixelsRB(unsigned char * pixels, int channels, size_t numPixels){
+	size_t i = 0;
+	if(channels==3){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += swapRB3_ssse3(pixels, numPixels);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += swapRB3_wasm(pixels, numPixels);
+#endif
+	}else if(channels==4){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_AVX2)) i += swapRB4_avx2(pixels, numPixels);
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += swapRB4_sse2(pixels + i*4, numPixels - i);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += swapRB4_wasm(pixels, numPixels);
+#endif
+	}
+	ofSwapPixelsRB<unsigned char>(pixels + i*channels, channels, numPixels - i);
+}
+
+//----------------------------------------------------------
+// copies the pixels in x0..x1, y0..y1 to their rotated position
+static void rotateRegion(const unsigned char * src, int width, int height, int channels, unsigned char * dst, bool clockwise, int x0, int y0, int x1, int y1){
+	for(int y = y0; y < y1; y++){
+		const unsigned char * srcPixel = src + ((size_t)y * width + x0) * channels;
+		for(int x = x0; x < x1; x++){
+			int dstX = clockwise ? height - 1 - y : y;
+			int dstY = clockwise ? x : width - 1 - x;
+			memcpy(dst + ((size_t)dstY * height + dstX) * channels, srcPixel, channels);
+			srcPixel += channels;
+		}
+	}
+}
+
+typedef void (*TransposeBlock)(const unsigned char * const * srcRows, unsigned char * const * dstRows);
+
+// rotates the whole blockSize x blockSize blocks with transpose, in tiles
+// of a few blocks so the dst rows written by a tile stay in cache. doneWidth
+// and doneHeight are set to the region done from the top left corner
+static void rotateBlocks(const unsigned char * src, int width, int height, int channels, unsigned char * dst, bool clockwise, int blockSize, TransposeBlock transpose, int & doneWidth, int & doneHeight){
+	const int tileSize = channels == 1 ? 64 : 32;
+	size_t srcStride = (size_t)width * channels;
+	size_t dstStride = (size_t)height * channels;
+	doneWidth = width / blockSize * blockSize;
+	doneHeight = height / blockSize * blockSize;
+	const unsigned char * srcRows[8];
+	unsigned char * dstRows[8];
+	for(int tileY = 0; tileY < doneHeight; tileY += tileSize){
+		int endY = std::min(doneHeight, tileY + tileSize);
+		for(int tileX = 0; tileX < doneWidth; tileX += tileSize){
+			int endX = std::min(doneWidth, tileX + tileSize);
+			for(int y = tileY; y < endY; y += blockSize){
+				for(int x = tileX; x < endX; x += blockSize){
+					for(int i = 0; i < blockSize; i++){
+						if(clockwise){
+							srcRows[i] = src + (y + blockSize - 1 - i) * srcStride + x * channels;
+							dstRows[i] = dst + (x + i) * dstStride + (height - y - blockSize) * channels;
+						}else{
+							srcRows[i] = src + (y + i) * srcStride + x * channels;
+							dstRows[i] = dst + (width - 1 - x - i) * dstStride + y * channels;
+						}
+					}
+					transpose(srcRows, dstRows);
+				}
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofRotatePixels90(const unsigned char * src, int width, int height, int channels, unsigned char * dst, bool clockwise){
+	TransposeBlock transpose = NULL;
+	int blockSize = 0;
+	if(channels==1){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)){ transpose = transpose8x8_sse2; blockSize = 8; }
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)){ transpose = transpose8x8_wasm; blockSize = 8; }
+#endif
+	}else if(channels==3){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)){ transpose = transpose4x4Rgb_ssse3; blockSize = 4; }
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)){ transpose = transpose4x4Rgb_wasm; blockSize = 4; }
+#endif
+	}else if(channels==4){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)){ transpose = transpose4x4Rgba_sse2; blockSize = 4; }
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)){ transpose = transpose4x4Rgba_wasm; blockSize = 4; }
+#endif
+	}
+	if(transpose == NULL){
+		ofRotatePixels90<unsigned char>(src, width, height, channels, dst, clockwise);
+		return;
+	}
+	int doneWidth, doneHeight;
+	rotateBlocks(src, width, height, channels, dst, clockwise, blockSize, transpose, doneWidth, doneHeight);
+	// the columns on the right and the rows at the bottom that don't fill a block
+	rotateRegion(src, width, height, channels, dst, clockwise, doneWidth, 0, width, height);
+	rotateRegion(src, width, height, channels, dst, clockwise, 0, doneHeight, doneWidth, height);
+}
+
+//----------------------------------------------------------
+void ofMirrorPixelsRow(const unsigned char * src, unsigned char * dst, int width, int channels){
+	size_t i = 0;
+	if(channels==1){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += mirrorRow1_ssse3(src, dst, width);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += mirrorRow1_wasm(src, dst, width);
+#endif
+	}else if(channels==3){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSSE3)) i += mirrorRow3_ssse3(src, dst, width);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += mirrorRow3_wasm(src, dst, width);
+#endif
+	}else if(channels==4){
+#if defined(OF_PIXELS_SIMD_X86)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_SSE2)) i += mirrorRow4_sse2(src, dst, width);
+#elif defined(OF_PIXELS_SIMD_WASM)
+		if(OF_SIMD_AT_LEAST(OF_SIMD_WASM128)) i += mirrorRow4_wasm(src, dst, width);
+#endif
+	}
+	// the kernels fill dst from the end, what's left goes to the start
+	ofMirrorPixelsRow<unsigned char>(src + i*channels, dst, width - i, channels);
+}
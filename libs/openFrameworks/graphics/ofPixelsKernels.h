@@ -0,0 +1,188 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <limits>
+
+// conversion kernels used by ofPixels_ for the per frame format changes
+// (copies between pixel types, channel conversions, rgb <-> bgr swaps,
+// rotations and mirroring).
+//
+// the templated versions are the plain scalar loops and work for any pixel
+// type. the non templated overloads for unsigned char / unsigned short / float
+// are vectorized (sse2, ssse3, avx2 picked at runtime on x86, wasm simd when
+// building for emscripten with -msimd128) and fall back to the scalar loops
+// for the remaining pixels and on other cpus.
+//
+// define OF_PIXELS_NO_SIMD to compile only the scalar paths.
+
+enum ofSimdLevel{
+	OF_SIMD_NONE,
+	OF_SIMD_SSE2,
+	OF_SIMD_SSSE3,
+	OF_SIMD_AVX2,
+	OF_SIMD_WASM128
+};
+
+// best instruction set supported by this cpu and build
+ofSimdLevel ofGetSupportedSimdLevel();
+
+// instruction set currently used by the kernels, defaults to the supported one
+ofSimdLevel ofGetSimdLevel();
+
+// limit the kernels to a lower instruction set, mostly useful to compare
+// against the scalar code. levels higher than the supported one are ignored
+void ofSetSimdLevel(ofSimdLevel level);
+
+//----------------------------------------------------------
+// copy numValues values between pixel types, scaling to the destination range.
+// float pixels are expected in 0..1 and are clamped to it.
+template<typename SrcType, typename DstType>
+void ofConvertPixelValues(const SrcType * src, DstType * dst, size_t numValues){
+	const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : std::numeric_limits<SrcType>::max() );
+	const float dstMax = ( (sizeof(DstType) == sizeof(float) ) ? 1.f : std::numeric_limits<DstType>::max() );
+	const float factor = dstMax / srcMax;
+
+	if(sizeof(SrcType) == sizeof(float)) {
+		// coming from float we need a special case to clamp the values
+		for(size_t i = 0; i < numValues; i++){
+			dst[i] = CLAMP(src[i], 0, 1) * factor;
+		}
+	} else{
+		// everything else is a straight scaling
+		for(size_t i = 0; i < numValues; i++){
+			dst[i] = src[i] * factor;
+		}
+	}
+}
+
+void ofConvertPixelValues(const unsigned char * src, unsigned short * dst, size_t numValues);
+void ofConvertPixelValues(const unsigned char * src, float * dst, size_t numValues);
+void ofConvertPixelValues(const unsigned short * src, unsigned char * dst, size_t numValues);
+void ofConvertPixelValues(const unsigned short * src, float * dst, size_t numValues);
+void ofConvertPixelValues(const float * src, unsigned char * dst, size_t numValues);
+void ofConvertPixelValues(const float * src, unsigned short * dst, size_t numValues);
+
+//----------------------------------------------------------
+// convert numPixels pixels between 1, 3 and 4 channels. going to less channels
+// keeps the first ones, gray is expanded to rgb and new alpha channels are
+// filled with alpha. src and dst can't overlap
+template<typename PixelType>
+void ofConvertPixelChannels(const PixelType * src, int srcChannels, PixelType * dst, int dstChannels, size_t numPixels, PixelType alpha){
+	int diffNumChannels = 0;
+	if(dstChannels<srcChannels){
+		diffNumChannels = srcChannels-dstChannels;
+	}
+	for(size_t i=0;i<numPixels;i++){
+		const PixelType & gray = *src;
+		for(int j=0;j<dstChannels;j++){
+			if(j<srcChannels){
+				*dst++ =  *src++;
+			}else if(j<3){
+				*dst++ = gray;
+			}else{
+				*dst++ = alpha;
+			}
+		}
+		src+=diffNumChannels;
+	}
+}
+
+void ofConvertPixelChannels(const unsigned char * src, int srcChannels, unsigned char * dst, int dstChannels, size_t numPixels, unsigned char alpha);
+
+//----------------------------------------------------------
+// swap the first and third channel of numPixels pixels in place
+template<typename PixelType>
+void ofSwapPixelsRB(PixelType * pixels, int channels, size_t numPixels){
+	if (channels >= 3){
+		size_t sizePixels = numPixels*channels;
+		for (size_t i=0; i< sizePixels; i+=channels){
+			std::swap(pixels[i],pixels[i+2]);
+		}
+	}
+}
+
+void ofSwapPixelsRB(unsigned char * pixels, int channels, size_t numPixels);
+
+//----------------------------------------------------------
+// rotate a width x height image 90 degrees into dst, which is height x width.
+// the image is walked in square blocks so the columns written to dst stay in
+// cache. src and dst can't overlap
+template<typename PixelType>
+void ofRotatePixels90(const PixelType * src, int width, int height, int channels, PixelType * dst, bool clockwise){
+	const int blockSize = 16;
+	for(int blockY = 0; blockY < height; blockY += blockSize){
+		int endY = std::min(height, blockY + blockSize);
+		for(int blockX = 0; blockX < width; blockX += blockSize){
+			int endX = std::min(width, blockX + blockSize);
+			for(int y = blockY; y < endY; y++){
+				const PixelType * srcPixel = src + ((size_t)y * width + blockX) * channels;
+				for(int x = blockX; x < endX; x++){
+					int dstX = clockwise ? height - 1 - y : y;
+					int dstY = clockwise ? x : width - 1 - x;
+					PixelType * dstPixel = dst + ((size_t)dstY * height + dstX) * channels;
+					for(int k = 0; k < channels; k++){
+						dstPixel[k] = srcPixel[k];
+					}
+					srcPixel += channels;
+				}
+			}
+		}
+	}
+}
+
+void ofRotatePixels90(const unsigned char * src, int width, int height, int channels, unsigned char * dst, bool clockwise);
+
+//----------------------------------------------------------
+// copy one row of width pixels reversed, src and dst can't overlap
+template<typename PixelType>
+void ofMirrorPixelsRow(const PixelType * src, PixelType * dst, int width, int channels){
+	dst += (size_t)(width - 1) * channels;
+	for(int x = 0; x < width; x++){
+		for(int k = 0; k < channels; k++){
+			dst[k] = src[k];
+		}
+		src += channels;
+		dst -= channels;
+	}
+}
+
+void ofMirrorPixelsRow(const unsigned char * src, unsigned char * dst, int width, int channels);
+
+//----------------------------------------------------------
+// flip a width x height image into dst, src and dst can be the same buffer
+template<typename PixelType>
+void ofMirrorPixels(const PixelType * src, int width, int height, int channels, PixelType * dst, bool vertically, bool horizontally){
+	size_t rowSize = (size_t)width * channels;
+	bool inPlace = src == dst;
+	// rows are mirrored in pairs, in place both are copied out first
+	std::vector<PixelType> top(inPlace ? rowSize : 0);
+	std::vector<PixelType> bottom(inPlace ? rowSize : 0);
+	int numRows = vertically ? (height + 1) / 2 : height;
+	for(int y = 0; y < numRows; y++){
+		int pairY = vertically ? height - 1 - y : y;
+		const PixelType * srcTop = src + y * rowSize;
+		const PixelType * srcBottom = src + pairY * rowSize;
+		if(inPlace){
+			if(!horizontally && pairY == y){
+				continue;
+			}
+			std::copy(srcTop, srcTop + rowSize, top.begin());
+			srcTop = &top[0];
+			if(pairY != y){
+				std::copy(srcBottom, srcBottom + rowSize, bottom.begin());
+				srcBottom = &bottom[0];
+			}
+		}
+		if(horizontally){
+			ofMirrorPixelsRow(srcTop, dst + pairY * rowSize, width, channels);
+			if(pairY != y){
+				ofMirrorPixelsRow(srcBottom, dst + y * rowSize, width, channels);
+			}
+		}else{
+			std::copy(srcTop, srcTop + rowSize, dst + pairY * rowSize);
+			if(pairY != y){
+				std::copy(srcBottom, srcBottom + rowSize, dst + y * rowSize);
+			}
+		}
+	}
+}
@@ -0,0 +1,207 @@
+#include "ofPixelsPool.h"
+#include "ofLog.h"
+#include <mutex>
+#include <list>
+#include <map>
+#include <cstdlib>
+
+#ifdef TARGET_WIN32
+#include <malloc.h>
+#endif
+
+namespace{
+
+typedef std::pair<size_t,size_t> PoolKey; // bytes, alignment
+
+struct PooledBuffer{
+	PoolKey key;
+	void * buffer;
+};
+
+struct Pool{
+	Pool()
+	:enabled(false)
+	,maxBytes(256*1024*1024){
+		memset(&stats, 0, sizeof(stats));
+	}
+
+	// frees the oldest buffers until bytes more fit in maxBytes
+	void makeRoom(size_t bytes);
+	void clear();
+	void remove(std::list<PooledBuffer>::iterator it);
+
+	std::mutex mutex;
+	bool enabled;
+	size_t maxBytes;
+	ofPixelsPoolStats stats;
+
+	// buffers in release order so the ones unused for longer go first
+	std::list<PooledBuffer> buffers;
+	std::multimap<PoolKey, std::list<PooledBuffer>::iterator> index;
+};
+
+// never deleted so pixels destroyed at exit can still release their memory
+Pool & getPool(){
+	static Pool * pool = new Pool;
+	return *pool;
+}
+
+void * alignedAlloc(size_t bytes, size_t alignment){
+#ifdef TARGET_WIN32
+	return _aligned_malloc(bytes, alignment);
+#else
+	void * buffer = NULL;
+	if(posix_memalign(&buffer, alignment, bytes) != 0){
+		return NULL;
+	}
+	return buffer;
+#endif
+}
+
+void alignedFree(void * buffer){
+#ifdef TARGET_WIN32
+	_aligned_free(buffer);
+#else
+	free(buffer);
+#endif
+}
+
+void Pool::remove(std::list<PooledBuffer>::iterator it){
+	std::pair<std::multimap<PoolKey, std::list<PooledBuffer>::iterator>::iterator,
+		std::multimap<PoolKey, std::list<PooledBuffer>::iterator>::iterator> range = index.equal_range(it->key);
+	for(; range.first != range.second; ++range.first){
+		if(range.first->second == it){
+			index.erase(range.first);
+			break;
+		}
+	}
+	stats.bytesPooled -= it->key.first;
+	stats.buffersPooled--;
+	buffers.erase(it);
+}
+
+void Pool::clear(){
+	while(!buffers.empty()){
+		void * buffer = buffers.front().buffer;
+		remove(buffers.begin());
+		alignedFree(buffer);
+	}
+}
+
+void Pool::makeRoom(size_t bytes){
+	while(!buffers.empty() && stats.bytesPooled + bytes > maxBytes){
+		void * buffer = buffers.front().buffer;
+		remove(buffers.begin());
+		alignedFree(buffer);
+	}
+}
+
+}
+
+//--------------------------------------------------
+void ofSetPixelsPoolEnabled(bool enabled){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	pool.enabled = enabled;
+	if(!enabled){
+		pool.clear();
+	}
+}
+
+//--------------------------------------------------
+bool ofIsPixelsPoolEnabled(){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	return pool.enabled;
+}
+
+//--------------------------------------------------
+void ofSetPixelsPoolMaxBytes(size_t maxBytes){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	pool.maxBytes = maxBytes;
+	pool.makeRoom(0);
+}
+
+//--------------------------------------------------
+size_t ofGetPixelsPoolMaxBytes(){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	return pool.maxBytes;
+}
+
+//--------------------------------------------------
+ofPixelsPoolStats ofGetPixelsPoolStats(){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	return pool.stats;
+}
+
+//--------------------------------------------------
+void ofResetPixelsPoolStats(){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	pool.stats.allocations = 0;
+	pool.stats.reuses = 0;
+	pool.stats.releases = 0;
+	pool.stats.discarded = 0;
+	pool.stats.peakBytesInUse = pool.stats.bytesInUse;
+}
+
+//--------------------------------------------------
+void ofClearPixelsPool(){
+	Pool & pool = getPool();
+	std::unique_lock<std::mutex> lck(pool.mutex);
+	pool.clear();
+}
+
+//--------------------------------------------------
+void * ofPixelsPoolAllocate(size_t bytes, size_t alignment){
+	bytes = std::max(bytes, (size_t)1);
+	alignment = std::max(alignment, sizeof(void*));
+	Pool & pool = getPool();
+	{
+		std::unique_lock<std::mutex> lck(pool.mutex);
+		pool.stats.allocations++;
+		pool.stats.bytesInUse += bytes;
+		pool.stats.peakBytesInUse = std::max(pool.stats.peakBytesInUse, pool.stats.bytesInUse);
+		std::multimap<PoolKey, std::list<PooledBuffer>::iterator>::iterator found = pool.index.find(PoolKey(bytes, alignment));
+		if(found != pool.index.end()){
+			void * buffer = found->second->buffer;
+			pool.remove(found->second);
+			pool.stats.reuses++;
+			return buffer;
+		}
+	}
+
+	void * buffer = alignedAlloc(bytes, alignment);
+	if(buffer == NULL){
+		ofLogError("ofPixelsPool") << "ofPixelsPoolAllocate(): couldn't allocate " << bytes << " bytes";
+		std::unique_lock<std::mutex> lck(pool.mutex);
+		pool.stats.bytesInUse -= bytes;
+	}
+	return buffer;
+}
+
+//--------------------------------------------------
+void ofPixelsPoolRelease(void * buffer, size_t bytes, size_t alignment){
+	if(buffer == NULL) return;
+	bytes = std::max(bytes, (size_t)1);
+	alignment = std::max(alignment, sizeof(void*));
+	Pool & pool = getPool();
+	{
+		std::unique_lock<std::mutex> lck(pool.mutex);
+		pool.stats.releases++;
+		pool.stats.bytesInUse -= bytes;
+		if(pool.enabled && bytes <= pool.maxBytes){
+			pool.makeRoom(bytes);
+			PooledBuffer pooled = {PoolKey(bytes, alignment), buffer};
+			pool.index.insert(std::make_pair(pooled.key, pool.buffers.insert(pool.buffers.end(), pooled)));
+			pool.stats.bytesPooled += bytes;
+			pool.stats.buffersPooled++;
+			return;
+		}
+		pool.stats.discarded++;
+	}
+	alignedFree(buffer);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ofConstants.h"
+
+// recycling allocator for pixel buffers. ofPixels_::allocate takes its memory
+// from here so when the pool is enabled the buffers of pixels that get
+// destroyed or reallocated are kept and handed to the next allocation of the
+// same size and alignment instead of going back to the heap. this avoids
+// malloc / free of big buffers every frame when grabbers, video players or
+// image loaders keep reallocating their pixels.
+//
+// the pool is disabled by default, in that case buffers are freed right away.
+
+struct ofPixelsPoolStats{
+	size_t allocations;		// buffers handed out
+	size_t reuses;			// of those, how many came from the pool
+	size_t releases;		// buffers given back
+	size_t discarded;		// released buffers freed because the pool was full or disabled
+	size_t bytesInUse;		// bytes currently allocated through the pool
+	size_t peakBytesInUse;
+	size_t bytesPooled;		// bytes kept waiting for reuse
+	size_t buffersPooled;
+};
+
+void ofSetPixelsPoolEnabled(bool enabled);
+bool ofIsPixelsPoolEnabled();
+
+// maximum number of bytes kept for reuse, buffers released beyond that are
+// freed. defaults to 256MB
+void ofSetPixelsPoolMaxBytes(size_t maxBytes);
+size_t ofGetPixelsPoolMaxBytes();
+
+ofPixelsPoolStats ofGetPixelsPoolStats();
+void ofResetPixelsPoolStats();
+
+// frees every buffer waiting in the pool
+void ofClearPixelsPool();
+
+// alignment has to be a power of two multiple of sizeof(void*). memory from
+// ofPixelsPoolAllocate has to be released with ofPixelsPoolRelease and the
+// same size and alignment
+void * ofPixelsPoolAllocate(size_t bytes, size_t alignment);
+void ofPixelsPoolRelease(void * buffer, size_t bytes, size_t alignment);
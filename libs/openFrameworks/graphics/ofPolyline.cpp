@@ -1,5 +1,7 @@
 #include "ofPolyline.h"
 #include "ofGraphics.h"
+#include "ofParallel.h"
+#include <queue>
 
 //----------------------------------------------------------
 ofPolyline::ofPolyline(){
@@ -37,35 +39,36 @@ void ofPolyline::clear() {
 void ofPolyline::addVertex(const ofPoint& p) {
 	curveVertices.clear();
 	points.push_back(p);
-    flagHasChanged();
+    flagHasChangedFrom(points.size()-2);
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertex(float x, float y, float z) {
 	curveVertices.clear();
 	addVertex(ofPoint(x,y,z));
-    flagHasChanged();
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertices(const vector<ofPoint>& verts) {
 	curveVertices.clear();
+	int firstChanged = points.size()-1;
 	points.insert( points.end(), verts.begin(), verts.end() );
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
 void ofPolyline::addVertices(const ofPoint* verts, int numverts) {
 	curveVertices.clear();
+	int firstChanged = points.size()-1;
 	points.insert( points.end(), verts, verts + numverts );
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
 void ofPolyline::insertVertex(const ofPoint &p, int index) {
     curveVertices.clear();
     points.insert(points.begin()+index, p);
-    flagHasChanged();
+    flagHasChangedFrom(index-1);
 }
 
 //----------------------------------------------------------
@@ -86,14 +89,21 @@ const ofPoint& ofPolyline::operator[] (int index) const {
 
 //----------------------------------------------------------
 ofPoint& ofPolyline::operator[] (int index) {
-    flagHasChanged();
+    flagHasChangedFrom(index-1);
 	return points[index];
 }
 
+//----------------------------------------------------------
+void ofPolyline::setVertex(int index, const ofPoint & p) {
+	points[index] = p;
+    flagHasChangedFrom(index-1);
+}
+
 //----------------------------------------------------------
 void ofPolyline::resize(size_t size){
+	int firstChanged = MIN(size, points.size())-1;
 	points.resize(size);
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
@@ -125,7 +135,15 @@ bool ofPolyline::hasChanged(){
 //----------------------------------------------------------
 void ofPolyline::flagHasChanged() {
     bHasChanged = true;
-    bCacheIsDirty = true;
+    bAreaIsDirty = true;
+    cacheDirtyFrom = 0;
+}
+
+//----------------------------------------------------------
+void ofPolyline::flagHasChangedFrom(int index) {
+    bHasChanged = true;
+    bAreaIsDirty = true;
+    cacheDirtyFrom = MIN(cacheDirtyFrom, MAX(index, 0));
 }
 
 //----------------------------------------------------------
@@ -170,6 +188,7 @@ void ofPolyline::bezierTo( const ofPoint & cp1, const ofPoint & cp2, const ofPoi
 	// if, and only if poly vertices has points, we can make a bezier
 	// from the last point
 	curveVertices.clear();
+	int firstChanged = points.size()-1;
     
 	// the resolultion with which we computer this bezier
 	// is arbitrary, can we possibly make it dynamic?
@@ -208,12 +227,13 @@ void ofPolyline::bezierTo( const ofPoint & cp1, const ofPoint & cp2, const ofPoi
 			points.push_back(ofPoint(x,y,z));
 		}
 	}
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
 void ofPolyline::quadBezierTo(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, int curveResolution){
 	curveVertices.clear();
+	int firstChanged = points.size()-1;
 	for(int i=0; i <= curveResolution; i++){
 		double t = (double)i / (double)(curveResolution);
 		double a = (1.0 - t)*(1.0 - t);
@@ -224,11 +244,12 @@ void ofPolyline::quadBezierTo(float x1, float y1, float z1, float x2, float y2,
 		double z = a * z1 + b * z2 + c * z3;
 		points.push_back(ofPoint(x, y, z));
 	}
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
 void ofPolyline::curveTo( const ofPoint & to, int curveResolution ){
+	int firstChanged = points.size()-1;
     
 	curveVertices.push_back(to);
     
@@ -275,12 +296,13 @@ void ofPolyline::curveTo( const ofPoint & to, int curveResolution ){
 		}
 		curveVertices.pop_front();
 	}
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
 void ofPolyline::arc(const ofPoint & center, float radiusX, float radiusY, float angleBegin, float angleEnd, bool clockwise, int circleResolution){
     
+    int firstChanged = points.size()-1;
     if(circleResolution<=1) circleResolution=2;
     setCircleResolution(circleResolution);
     points.reserve(points.size()+circleResolution);
@@ -373,7 +395,7 @@ void ofPolyline::arc(const ofPoint & center, float radiusX, float radiusY, float
             remainingAngle = 0; // call it finished, the next while loop test will fail
         }
     }
-    flagHasChanged();
+    flagHasChangedFrom(firstChanged);
 }
 
 //----------------------------------------------------------
@@ -388,13 +410,13 @@ float ofPolyline::getPerimeter() const {
 
 //----------------------------------------------------------
 float ofPolyline::getArea() const{
-    updateCache();
+    updateArea();
     return area;
 }
 
 //----------------------------------------------------------
 ofPoint ofPolyline::getCentroid2D() const{
-    updateCache();
+    updateArea();
     return centroid2D;
 }
 
@@ -463,8 +485,23 @@ ofPolyline ofPolyline::getResampledBySpacing(float spacing) const {
     if(spacing==0 || size() == 0) return *this;
     ofPolyline poly;
     float totalLength = getPerimeter();
-    for(float f=0; f<totalLength; f += spacing) {
-        poly.lineTo(getPointAtLength(f));
+    if(size() > 1) {
+        updateCache();
+        // the lengths increase so the segment of each point is found
+        // walking forward from the previous one
+        int numSamples = ceil(totalLength / spacing);
+        poly.points.reserve(numSamples);
+        int segment = 0;
+        int lastSegment = lengths.size() - 2;
+        for(int i = 0; i < numSamples; i++) {
+            float f = i * spacing;
+            if(f >= totalLength) break;
+            while(segment < lastSegment && lengths[segment + 1] <= f) segment++;
+            float segmentLength = lengths[segment + 1] - lengths[segment];
+            float t = segmentLength > 0 ? (f - lengths[segment]) / segmentLength : 0;
+            poly.points.push_back(points[segment].getInterpolated(points[getWrappedIndex(segment + 1)], t));
+        }
+        poly.flagHasChanged();
     }
     
     if(!isClosed()) {
@@ -637,103 +674,179 @@ typedef struct{
 #define d(u,v)     norm(u-v)       // distance = norm of difference
 
 //--------------------------------------------------
-static void simplifyDP(float tol, ofPoint* v, int j, int k, int* mk ){
-    if (k <= j+1) // there is nothing to simplify
-        return;
-    
-    // check for adequate approximation by segment S from v[j] to v[k]
-    int     maxi	= j;          // index of vertex farthest from S
-    float   maxd2	= 0;         // distance squared of farthest vertex
+// marks the vertices of v that are further than tol from the segments
+// between the vertices already marked, the first and last have to be marked.
+// uses a stack of ranges instead of recursion so long polylines can't
+// overflow the call stack
+static void simplifyDP(float tol, const ofPoint* v, int n, unsigned char* mk ){
     float   tol2	= tol * tol;  // tolerance squared
-    Segment S		= {v[j], v[k]};  // segment from v[j] to v[k]
-    ofPoint u;
-	u				= S.P1 - S.P0;   // segment direction vector
-    double  cu		= dot(u,u);     // segment length squared
-    
-    // test each vertex v[i] for max distance from S
-    // compute using the Feb 2001 Algorithm's dist_ofPoint_to_Segment()
-    // Note: this works in any dimension (2D, 3D, ...)
-    ofPoint  w;
-    ofPoint   Pb;                // base of perpendicular from v[i] to S
-    float  b, cw, dv2;        // dv2 = distance v[i] to S squared
-    
-    for (int i=j+1; i<k; i++){
-        // compute distance squared
-        w = v[i] - S.P0;
-        cw = dot(w,u);
-        if ( cw <= 0 ) dv2 = d2(v[i], S.P0);
-        else if ( cu <= cw ) dv2 = d2(v[i], S.P1);
-        else {
-            b = (float)(cw / cu);
-            Pb = S.P0 + u*b;
-            dv2 = d2(v[i], Pb);
-        }
-        // test with current max distance squared
-        if (dv2 <= maxd2) continue;
+    vector<std::pair<int,int> > ranges;
+    ranges.push_back(std::make_pair(0, n-1));
+    
+    while(!ranges.empty()){
+        int j = ranges.back().first;
+        int k = ranges.back().second;
+        ranges.pop_back();
+        if (k <= j+1) // there is nothing to simplify
+            continue;
         
-        // v[i] is a new max vertex
-        maxi = i;
-        maxd2 = dv2;
+        // check for adequate approximation by segment S from v[j] to v[k]
+        int     maxi	= j;          // index of vertex farthest from S
+        float   maxd2	= 0;         // distance squared of farthest vertex
+        Segment S		= {v[j], v[k]};  // segment from v[j] to v[k]
+        ofPoint u;
+        u				= S.P1 - S.P0;   // segment direction vector
+        double  cu		= dot(u,u);     // segment length squared
+        
+        // test each vertex v[i] for max distance from S
+        // compute using the Feb 2001 Algorithm's dist_ofPoint_to_Segment()
+        // Note: this works in any dimension (2D, 3D, ...)
+        ofPoint  w;
+        ofPoint   Pb;                // base of perpendicular from v[i] to S
+        float  b, cw, dv2;        // dv2 = distance v[i] to S squared
+        
+        for (int i=j+1; i<k; i++){
+            // compute distance squared
+            w = v[i] - S.P0;
+            cw = dot(w,u);
+            if ( cw <= 0 ) dv2 = d2(v[i], S.P0);
+            else if ( cu <= cw ) dv2 = d2(v[i], S.P1);
+            else {
+                b = (float)(cw / cu);
+                Pb = S.P0 + u*b;
+                dv2 = d2(v[i], Pb);
+            }
+            // test with current max distance squared
+            if (dv2 <= maxd2) continue;
+            
+            // v[i] is a new max vertex
+            maxi = i;
+            maxd2 = dv2;
+        }
+        if (maxd2 > tol2)        // error is worse than the tolerance
+        {
+            // split the polyline at the farthest vertex from S
+            mk[maxi] = 1;      // mark v[maxi] for the simplified polyline
+            // simplify the two subpolylines at v[maxi]
+            ranges.push_back(std::make_pair(j, maxi));  // polyline v[j] to v[maxi]
+            ranges.push_back(std::make_pair(maxi, k));  // polyline v[maxi] to v[k]
+        }
+        // else the approximation is OK, so ignore intermediate vertices
     }
-    if (maxd2 > tol2)        // error is worse than the tolerance
-    {
-        // split the polyline at the farthest vertex from S
-        mk[maxi] = 1;      // mark v[maxi] for the simplified polyline
-        // recursively simplify the two subpolylines at v[maxi]
-        simplifyDP( tol, v, j, maxi, mk );  // polyline v[j] to v[maxi]
-        simplifyDP( tol, v, maxi, k, mk );  // polyline v[maxi] to v[k]
+}
+
+//--------------------------------------------------
+// area of the triangle a vertex forms with its neighbours
+static float triangleArea(const ofPoint & a, const ofPoint & b, const ofPoint & c){
+    return (b - a).getCrossed(c - a).length() * 0.5f;
+}
+
+//--------------------------------------------------
+// removes the vertex that forms the smallest triangle with its neighbours
+// until all the remaining ones form bigger triangles than minArea.
+// the vertices are a linked list and a priority queue keeps them ordered by
+// area, entries that are out of date are skipped when they come up
+static void simplifyVW(float minArea, const vector<ofPoint> & v, bool closed, unsigned char* mk ){
+    int n = v.size();
+    int minPoints = closed ? 3 : 2;
+    vector<int> prev(n), next(n);
+    vector<float> areas(n, 0);
+    typedef std::pair<float,int> Entry;
+    std::priority_queue<Entry, vector<Entry>, std::greater<Entry> > queue;
+    
+    for(int i=0; i<n; i++){
+        prev[i] = i-1;
+        next[i] = i+1;
+        mk[i] = 1;
+    }
+    if(closed){
+        prev[0] = n-1;
+        next[n-1] = 0;
+    }
+    int first = closed ? 0 : 1;
+    int last = closed ? n-1 : n-2;
+    for(int i=first; i<=last; i++){
+        areas[i] = triangleArea(v[prev[i]], v[i], v[next[i]]);
+        queue.push(Entry(areas[i], i));
+    }
+    
+    int remaining = n;
+    while(!queue.empty() && remaining > minPoints){
+        Entry entry = queue.top();
+        queue.pop();
+        int i = entry.second;
+        if(!mk[i] || entry.first != areas[i]) continue;
+        if(entry.first >= minArea) break;
+        
+        mk[i] = 0;
+        remaining--;
+        int p = prev[i];
+        int q = next[i];
+        next[p] = q;
+        prev[q] = p;
+        
+        // the neighbours never get a smaller area than the removed vertex,
+        // otherwise they would be removed before vertices that were more
+        // important than it
+        if(closed || p != 0){
+            areas[p] = MAX(triangleArea(v[prev[p]], v[p], v[q]), entry.first);
+            queue.push(Entry(areas[p], p));
+        }
+        if(closed || q != n-1){
+            areas[q] = MAX(triangleArea(v[p], v[q], v[next[q]]), entry.first);
+            queue.push(Entry(areas[q], q));
+        }
     }
-    // else the approximation is OK, so ignore intermediate vertices
-    return;
 }
 
 //--------------------------------------------------
-void ofPolyline::simplify(float tol){
+void ofPolyline::simplify(float tol, ofPolylineSimplifyMode mode){
     if(points.size() < 2) return;
     
 	int n = size();
-	
-	if(n == 0) {
-		return;
-	}
-
-	vector <ofPoint> sV;
-	sV.resize(n);
-    
-    int    i, k, m, pv;            // misc counters
-    float  tol2 = tol * tol;       // tolerance squared
-    vector<ofPoint> vt;
-    vector<int> mk;
-    vt.resize(n);
-	mk.resize(n,0);
-    
+    int    i, k, m;               // misc counters
+    vector<unsigned char> mk;
     
-    // STAGE 1.  Vertex Reduction within tolerance of prior vertex cluster
-    vt[0] = points[0];              // start at the beginning
-    for (i=k=1, pv=0; i<n; i++) {
-        if (d2(points[i], points[pv]) < tol2) continue;
+    if(mode == OF_SIMPLIFY_VISVALINGAM_WHYATT){
+        if(n <= (isClosed() ? 3 : 2)) return;
+        mk.resize(n);
+        simplifyVW(tol, points, isClosed(), &mk[0]);
+        k = n;
+    }else{
+        float  tol2 = tol * tol;       // tolerance squared
+        ofPoint last = points[n-1];
+        
+        // STAGE 1.  Vertex Reduction within tolerance of prior vertex cluster
+        // the kept vertices are moved to the front of points
+        bool lastKept = false;
+        for (i=k=1; i<n; i++) {
+            if (d2(points[i], points[k-1]) < tol2) continue;
+            points[k++] = points[i];
+            lastKept = i == n-1;
+        }
+        if (!lastKept) points[k++] = last;      // finish at the end
         
-        vt[k++] = points[i];
-        pv = i;
+        // STAGE 2.  Douglas-Peucker polyline simplification
+        mk.resize(k, 0);
+        mk[0] = mk[k-1] = 1;       // mark the first and last vertices
+        simplifyDP( tol, &points[0], k, &mk[0] );
     }
-    if (pv < n-1) vt[k++] = points[n-1];      // finish at the end
     
-    // STAGE 2.  Douglas-Peucker polyline simplification
-    mk[0] = mk[k-1] = 1;       // mark the first and last vertices
-    simplifyDP( tol, &vt[0], 0, k-1, &mk[0] );
-    
-    // copy marked vertices to the output simplified polyline
+    // keep the marked vertices
     for (i=m=0; i<k; i++) {
-        if (mk[i]) sV[m++] = vt[i];
+        if (mk[i]) points[m++] = points[i];
     }
-    
-	//get rid of the unused points
-	if( m < (int)sV.size() ){
-		points.assign( sV.begin(),sV.begin()+m );
-	}else{
-		points = sV;
-	}
-    
+    points.resize(m);
+    flagHasChanged();
+}
+
+//--------------------------------------------------
+void ofPolyline::simplify(vector<ofPolyline> & polylines, float tolerance, ofPolylineSimplifyMode mode){
+    ofParallelFor(0, polylines.size(), [&](int begin, int end){
+        for(int i = begin; i < end; i++){
+            polylines[i].simplify(tolerance, mode);
+        }
+    }, 8);
 }
 
 //--------------------------------------------------
@@ -761,30 +874,13 @@ float ofPolyline::getIndexAtLength(float length) const {
     float totalLength = getPerimeter();
     length = ofClamp(length, 0, totalLength);
     
-    int lastPointIndex = isClosed() ? points.size() : points.size()-1;
-    
-    int i1 = ofClamp(floor(length / totalLength * lastPointIndex), 0, lengths.size()-2);   // start approximation here
-    int leftLimit = 0;
-    int rightLimit = lastPointIndex;
-    
-    float distAt1, distAt2;
-    for(int iterations = 0; iterations < 32; iterations ++) {	// limit iterations
-        i1 = ofClamp(i1, 0, lengths.size()-1);
-        distAt1 = lengths[i1];
-        if(distAt1 <= length) {         // if Length at i1 is less than desired Length (this is good)
-            distAt2 = lengths[i1+1];
-            if(distAt2 > length) {
-                float t = ofMap(length, distAt1, distAt2, 0, 1);
-                return i1 + t;
-            } else {
-                leftLimit = i1;
-            }
-        } else {
-            rightLimit = i1;
-        }
-        i1 = (leftLimit + rightLimit)/2;
-    }
-    return 0;
+    // the last segment that starts at or before length
+    int i1 = upper_bound(lengths.begin(), lengths.end(), length) - lengths.begin() - 1;
+    i1 = ofClamp(i1, 0, lengths.size()-2);
+    float distAt1 = lengths[i1];
+    float distAt2 = lengths[i1+1];
+    if(distAt2 <= distAt1) return i1;
+    return i1 + (length - distAt1) / (distAt2 - distAt1);
 }
 
 
@@ -947,65 +1043,83 @@ void ofPolyline::getInterpolationParams(float findex, int &i1, int &i2, float &t
 
 //--------------------------------------------------
 void ofPolyline::updateCache(bool bForceUpdate) const {
-    if(bCacheIsDirty || bForceUpdate) {
+    if(bForceUpdate) cacheDirtyFrom = 0;
+    int numPoints = points.size();
+    if(cacheDirtyFrom >= numPoints) return;
+
+    if(numPoints < 2) {
         lengths.clear();
         angles.clear();
         rotations.clear();
         normals.clear();
         tangents.clear();
-        area = 0;
-        centroid2D.set(0, 0, 0);
-        bCacheIsDirty = false;
-        
-        if(points.size() < 2) return;
+        cacheDirtyFrom = numPoints;
+        return;
+    }
 
-        // area
-        for(int i=0;i<(int)points.size()-1;i++){
-            area += points[i].x * points[i+1].y - points[i+1].x * points[i].y;
-        }
-        area += points[points.size()-1].x * points[0].y - points[0].x * points[points.size()-1].y;
-        area *= 0.5;
+    // per vertex cache, the data of the vertices before cacheDirtyFrom
+    // is still valid so only the rest is calculated again
+    int first = cacheDirtyFrom;
+    lengths.resize(numPoints);
+    tangents.resize(numPoints);
+    angles.resize(numPoints);
+    normals.resize(numPoints);
+    rotations.resize(numPoints);
+
+    float angle;
+    ofVec3f rotation;
+    ofVec3f normal;
+    ofVec3f tangent;
+
+    float length = 0;
+    if(first > 0) length = lengths[first-1] + points[first-1].distance(points[first]);
+    for(int i=first; i<numPoints; i++) {
+        lengths[i] = length;
+
+        calcData(i, tangent, angle, rotation, normal);
+        tangents[i] = tangent;
+        angles[i] = angle;
+        rotations[i] = rotation;
+        normals[i] = normal;
+
+        length += points[i].distance(points[getWrappedIndex(i + 1)]);
+    }
 
-        
-        // centroid
-        // TODO: doesn't seem to work on all concave shapes
-        for(int i=0;i<(int)points.size()-1;i++){
-            centroid2D.x += (points[i].x + points[i+1].x) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
-            centroid2D.y += (points[i].y + points[i+1].y) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
+    if(isClosed()) {
+        lengths.push_back(length);
+        // the first vertex depends on the last one
+        if(first > 0) {
+            calcData(0, tangents[0], angles[0], rotations[0], normals[0]);
         }
-        centroid2D.x += (points[points.size()-1].x + points[0].x) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
-        centroid2D.y += (points[points.size()-1].y + points[0].y) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
-        
-        centroid2D.x /= (6*area);
-        centroid2D.y /= (6*area);
-
-        
-        // per vertex cache
-        lengths.resize(points.size());
-        tangents.resize(points.size());
-        angles.resize(points.size());
-        normals.resize(points.size());
-        rotations.resize(points.size());
-        
-        float angle;
-        ofVec3f rotation;
-        ofVec3f normal;
-        ofVec3f tangent;
-
-        float length = 0;
-        for(int i=0; i<(int)points.size(); i++) {
-            lengths[i] = length;
-
-            calcData(i, tangent, angle, rotation, normal);
-            tangents[i] = tangent;
-            angles[i] = angle;
-            rotations[i] = rotation;
-            normals[i] = normal;
-            
-            length += points[i].distance(points[getWrappedIndex(i + 1)]);
-        }
-        
-        if(isClosed()) lengths.push_back(length);
     }
+    cacheDirtyFrom = numPoints;
 }
 
+//--------------------------------------------------
+void ofPolyline::updateArea() const {
+    if(!bAreaIsDirty) return;
+    bAreaIsDirty = false;
+    area = 0;
+    centroid2D.set(0, 0, 0);
+    if(points.size() < 2) return;
+
+    // area
+    for(int i=0;i<(int)points.size()-1;i++){
+        area += points[i].x * points[i+1].y - points[i+1].x * points[i].y;
+    }
+    area += points[points.size()-1].x * points[0].y - points[0].x * points[points.size()-1].y;
+    area *= 0.5;
+
+
+    // centroid
+    // TODO: doesn't seem to work on all concave shapes
+    for(int i=0;i<(int)points.size()-1;i++){
+        centroid2D.x += (points[i].x + points[i+1].x) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
+        centroid2D.y += (points[i].y + points[i+1].y) * (points[i].x*points[i+1].y - points[i+1].x*points[i].y);
+    }
+    centroid2D.x += (points[points.size()-1].x + points[0].x) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
+    centroid2D.y += (points[points.size()-1].y + points[0].y) * (points[points.size()-1].x*points[0].y - points[0].x*points[points.size()-1].y);
+
+    centroid2D.x /= (6*area);
+    centroid2D.y /= (6*area);
+}
@@ -9,6 +9,11 @@
 
 using std::deque;
 
+enum ofPolylineSimplifyMode{
+	OF_SIMPLIFY_DOUGLAS_PEUCKER,
+	OF_SIMPLIFY_VISVALINGAM_WHYATT
+};
+
 class ofRectangle;
 
 class ofPolyline {
@@ -110,12 +115,20 @@ public:
     bool inside(float x, float y) const;
     bool inside(const ofPoint & p) const;
 
-	void simplify(float tolerance=0.3f);
+	// removes the vertices that don't change the shape of the polyline by
+	// more than tolerance. with OF_SIMPLIFY_DOUGLAS_PEUCKER tolerance is a
+	// distance, with OF_SIMPLIFY_VISVALINGAM_WHYATT it's the area of the
+	// smallest triangle a vertex can form with its neighbours to be kept
+	void simplify(float tolerance=0.3f, ofPolylineSimplifyMode mode=OF_SIMPLIFY_DOUGLAS_PEUCKER);
+
+	// simplifies every polyline, splitting them over ofParallelFor
+	static void simplify(vector<ofPolyline> & polylines, float tolerance=0.3f, ofPolylineSimplifyMode mode=OF_SIMPLIFY_DOUGLAS_PEUCKER);
 
 	/// points vector access
 	size_t size() const;
 	const ofPoint& operator[] (int index) const;
 	ofPoint& operator[] (int index);
+	void setVertex(int index, const ofPoint & p);
 	void resize(size_t size);
 
 	/// closed
@@ -205,6 +218,7 @@ private:
     mutable vector<float> angles;    // angle (degrees) between adjacent segments, stored per point (asin(cross product))
     mutable ofPoint centroid2D;
     mutable float area;
+    mutable bool bAreaIsDirty;
     
     
 	deque<ofPoint> curveVertices;
@@ -212,9 +226,14 @@ private:
 
 	bool bClosed;
 	bool bHasChanged;   // public API has access to this
-    mutable bool bCacheIsDirty;   // used only internally, no public API to read
-    
+    // used only internally, no public API to read. the per vertex cache is
+    // valid for the vertices before this index, appending or editing
+    // vertices only invalidates it from the first one affected
+    mutable int cacheDirtyFrom;
+
+    void flagHasChangedFrom(int index);
     void updateCache(bool bForceUpdate = false) const;
+    void updateArea() const;
     
     // given an interpolated index (e.g. 5.75) return neighboring indices and interolation factor (e.g. 5, 6, 0.75)
     void getInterpolationParams(float findex, int &i1, int &i2, float &t) const;
@@ -0,0 +1,367 @@
+#include "ofPreparedPolygon.h"
+#include "ofParallel.h"
+#include "ofPixelsKernels.h"
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OF_POLYGON_SIMD_SSE2
+	#include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+	#define OF_POLYGON_SIMD_WASM
+	#include <wasm_simd128.h>
+#endif
+
+// floats per block of 4 edges: ax, ay, bx, by, nx, ny, d
+static const int blockSize = 28;
+
+// parity of the 4 bits of a crossing mask
+static inline int maskParity(int mask){
+	return (0x6996 >> mask) & 1;
+}
+
+//----------------------------------------------------------
+// the point is relative to the reference point of the cell, an edge is
+// crossed when its ends are on different sides of the segment from the
+// reference point to the point and those are on different sides of the edge
+static int crossingParityScalar(const float * block, int numBlocks, float px, float py){
+	int parity = 0;
+	for(int i = 0; i < numBlocks; i++, block += blockSize){
+		for(int j = 0; j < 4; j++){
+			float ax = block[j], ay = block[4+j];
+			float bx = block[8+j], by = block[12+j];
+			float d = block[24+j];
+			bool sa = px*ay - py*ax > 0;
+			bool sb = px*by - py*bx > 0;
+			bool sp = block[16+j]*px + block[20+j]*py + d > 0;
+			parity ^= (sa != sb) && (sp != (d > 0));
+		}
+	}
+	return parity;
+}
+
+#if defined(OF_POLYGON_SIMD_SSE2)
+//----------------------------------------------------------
+static int crossingParitySse2(const float * block, int numBlocks, float px, float py){
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 vpx = _mm_set1_ps(px);
+	const __m128 vpy = _mm_set1_ps(py);
+	__m128 parity = zero;
+	for(int i = 0; i < numBlocks; i++, block += blockSize){
+		__m128 ax = _mm_loadu_ps(block);
+		__m128 ay = _mm_loadu_ps(block + 4);
+		__m128 bx = _mm_loadu_ps(block + 8);
+		__m128 by = _mm_loadu_ps(block + 12);
+		__m128 nx = _mm_loadu_ps(block + 16);
+		__m128 ny = _mm_loadu_ps(block + 20);
+		__m128 d = _mm_loadu_ps(block + 24);
+		__m128 sa = _mm_cmpgt_ps(_mm_sub_ps(_mm_mul_ps(vpx, ay), _mm_mul_ps(vpy, ax)), zero);
+		__m128 sb = _mm_cmpgt_ps(_mm_sub_ps(_mm_mul_ps(vpx, by), _mm_mul_ps(vpy, bx)), zero);
+		__m128 sp = _mm_cmpgt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, vpx), _mm_mul_ps(ny, vpy)), d), zero);
+		__m128 sr = _mm_cmpgt_ps(d, zero);
+		parity = _mm_xor_ps(parity, _mm_and_ps(_mm_xor_ps(sa, sb), _mm_xor_ps(sp, sr)));
+	}
+	return maskParity(_mm_movemask_ps(parity));
+}
+#endif
+
+#if defined(OF_POLYGON_SIMD_WASM)
+//----------------------------------------------------------
+static int crossingParityWasm(const float * block, int numBlocks, float px, float py){
+	const v128_t zero = wasm_f32x4_splat(0.f);
+	const v128_t vpx = wasm_f32x4_splat(px);
+	const v128_t vpy = wasm_f32x4_splat(py);
+	v128_t parity = zero;
+	for(int i = 0; i < numBlocks; i++, block += blockSize){
+		v128_t ax = wasm_v128_load(block);
+		v128_t ay = wasm_v128_load(block + 4);
+		v128_t bx = wasm_v128_load(block + 8);
+		v128_t by = wasm_v128_load(block + 12);
+		v128_t nx = wasm_v128_load(block + 16);
+		v128_t ny = wasm_v128_load(block + 20);
+		v128_t d = wasm_v128_load(block + 24);
+		v128_t sa = wasm_f32x4_gt(wasm_f32x4_sub(wasm_f32x4_mul(vpx, ay), wasm_f32x4_mul(vpy, ax)), zero);
+		v128_t sb = wasm_f32x4_gt(wasm_f32x4_sub(wasm_f32x4_mul(vpx, by), wasm_f32x4_mul(vpy, bx)), zero);
+		v128_t sp = wasm_f32x4_gt(wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(nx, vpx), wasm_f32x4_mul(ny, vpy)), d), zero);
+		v128_t sr = wasm_f32x4_gt(d, zero);
+		parity = wasm_v128_xor(parity, wasm_v128_and(wasm_v128_xor(sa, sb), wasm_v128_xor(sp, sr)));
+	}
+	return maskParity(wasm_i32x4_bitmask(parity));
+}
+#endif
+
+//----------------------------------------------------------
+// the same crossing test as ofPolyline::inside over some of the edges, used
+// to know if the reference points of the cells are inside
+static bool insideEdges(float x, float y, const vector<ofPoint> & points, const vector<int> & edges){
+	int N = points.size();
+	bool inside = false;
+	for(int i = 0; i < (int)edges.size(); i++){
+		const ofPoint & p1 = points[edges[i]];
+		const ofPoint & p2 = points[(edges[i] + 1) % N];
+		if(y > MIN(p1.y, p2.y) && y <= MAX(p1.y, p2.y) && x <= MAX(p1.x, p2.x) && p1.y != p2.y){
+			double xinters = (y - p1.y) * (p2.x - p1.x) / (p2.y - p1.y) + p1.x;
+			if(p1.x == p2.x || x <= xinters){
+				inside = !inside;
+			}
+		}
+	}
+	return inside;
+}
+
+//----------------------------------------------------------
+static float distanceToSegmentSquared(float x, float y, const ofPoint & a, const ofPoint & b){
+	float dx = b.x - a.x, dy = b.y - a.y;
+	float lengthSquared = dx*dx + dy*dy;
+	float t = 0;
+	if(lengthSquared > 0){
+		t = ofClamp(((x - a.x)*dx + (y - a.y)*dy) / lengthSquared, 0, 1);
+	}
+	float ex = a.x + t*dx - x, ey = a.y + t*dy - y;
+	return ex*ex + ey*ey;
+}
+
+//----------------------------------------------------------
+ofPreparedPolygon::ofPreparedPolygon(){
+	clear();
+}
+
+//----------------------------------------------------------
+ofPreparedPolygon::ofPreparedPolygon(const ofPolyline & polyline){
+	build(polyline);
+}
+
+//----------------------------------------------------------
+void ofPreparedPolygon::clear(){
+	minX = minY = maxX = maxY = 0;
+	cellWidth = cellHeight = 0;
+	gridWidth = gridHeight = 0;
+	numEdges = 0;
+	refX.clear();
+	refY.clear();
+	refInside.clear();
+	cellStart.clear();
+	edgeBlocks.clear();
+}
+
+//----------------------------------------------------------
+bool ofPreparedPolygon::isBuilt() const{
+	return !cellStart.empty();
+}
+
+//----------------------------------------------------------
+void ofPreparedPolygon::build(const ofPolyline & polyline){
+	clear();
+	const vector<ofPoint> & points = polyline.getVertices();
+	int N = points.size();
+	if(N < 3) return;
+
+	minX = maxX = points[0].x;
+	minY = maxY = points[0].y;
+	for(int i = 1; i < N; i++){
+		minX = MIN(minX, points[i].x);
+		maxX = MAX(maxX, points[i].x);
+		minY = MIN(minY, points[i].y);
+		maxY = MAX(maxY, points[i].y);
+	}
+	float width = maxX - minX;
+	float height = maxY - minY;
+	// no area, nothing can be inside
+	if(width <= 0 || height <= 0) return;
+
+	// about one cell per edge, with cells as square as possible
+	numEdges = N;
+	gridWidth = ofClamp(roundf(sqrtf(N * width / height)), 1, 1024);
+	gridHeight = ofClamp(roundf(sqrtf(N * height / width)), 1, 1024);
+	cellWidth = width / gridWidth;
+	cellHeight = height / gridHeight;
+	int numCells = gridWidth * gridHeight;
+
+	// every cell gets the edges that touch it, grown a bit so rounding
+	// can't leave out an edge that passes right by a cell
+	float padX = cellWidth * 1e-3f;
+	float padY = cellHeight * 1e-3f;
+	vector<vector<int> > cellEdges(numCells);
+	vector<vector<int> > rowEdges(gridHeight);
+	for(int i = 0; i < N; i++){
+		const ofPoint & a = points[i];
+		const ofPoint & b = points[(i + 1) % N];
+		float edgeMinY = MIN(a.y, b.y) - padY;
+		float edgeMaxY = MAX(a.y, b.y) + padY;
+		int row0 = ofClamp(floorf((edgeMinY - minY) / cellHeight), 0, gridHeight - 1);
+		int row1 = ofClamp(floorf((edgeMaxY - minY) / cellHeight), 0, gridHeight - 1);
+		for(int row = row0; row <= row1; row++){
+			rowEdges[row].push_back(i);
+			float x0, x1;
+			if(a.y == b.y){
+				x0 = MIN(a.x, b.x);
+				x1 = MAX(a.x, b.x);
+			}else{
+				// the part of the edge inside the row
+				float y0 = MAX(edgeMinY, minY + row * cellHeight - padY);
+				float y1 = MIN(edgeMaxY, minY + (row + 1) * cellHeight + padY);
+				float t0 = ofClamp((y0 - a.y) / (b.y - a.y), 0, 1);
+				float t1 = ofClamp((y1 - a.y) / (b.y - a.y), 0, 1);
+				x0 = a.x + t0 * (b.x - a.x);
+				x1 = a.x + t1 * (b.x - a.x);
+				if(x0 > x1) std::swap(x0, x1);
+			}
+			int col0 = ofClamp(floorf((x0 - padX - minX) / cellWidth), 0, gridWidth - 1);
+			int col1 = ofClamp(floorf((x1 + padX - minX) / cellWidth), 0, gridWidth - 1);
+			for(int col = col0; col <= col1; col++){
+				cellEdges[row * gridWidth + col].push_back(i);
+			}
+		}
+	}
+
+	// the reference point of each cell is the one of a few candidates that
+	// is furthest from the edges of the cell, so its inside state is
+	// unambiguous
+	static const float candidates[][2] = {
+		{0.5f, 0.5f}, {0.25f, 0.25f}, {0.75f, 0.25f}, {0.25f, 0.75f}, {0.75f, 0.75f},
+		{0.5f, 0.25f}, {0.5f, 0.75f}, {0.25f, 0.5f}, {0.75f, 0.5f}
+	};
+	refX.resize(numCells);
+	refY.resize(numCells);
+	refInside.resize(numCells);
+	cellStart.resize(numCells + 1);
+	ofParallelFor(0, gridHeight, [&](int rowBegin, int rowEnd){
+		for(int row = rowBegin; row < rowEnd; row++){
+			for(int col = 0; col < gridWidth; col++){
+				int cell = row * gridWidth + col;
+				const vector<int> & edges = cellEdges[cell];
+				float bestX = minX + (col + 0.5f) * cellWidth;
+				float bestY = minY + (row + 0.5f) * cellHeight;
+				if(!edges.empty()){
+					float goodEnough = MIN(cellWidth, cellHeight) * 0.1f;
+					float bestDistance = -1;
+					for(int c = 0; c < 9 && bestDistance < goodEnough * goodEnough; c++){
+						float x = minX + (col + candidates[c][0]) * cellWidth;
+						float y = minY + (row + candidates[c][1]) * cellHeight;
+						float distance = std::numeric_limits<float>::max();
+						for(int e = 0; e < (int)edges.size(); e++){
+							distance = MIN(distance, distanceToSegmentSquared(x, y, points[edges[e]], points[(edges[e] + 1) % N]));
+						}
+						if(distance > bestDistance){
+							bestDistance = distance;
+							bestX = x;
+							bestY = y;
+						}
+					}
+				}
+				refX[cell] = bestX;
+				refY[cell] = bestY;
+				refInside[cell] = insideEdges(bestX, bestY, points, rowEdges[row]);
+			}
+		}
+	});
+
+	int numBlocks = 0;
+	for(int cell = 0; cell < numCells; cell++){
+		cellStart[cell] = numBlocks;
+		numBlocks += (cellEdges[cell].size() + 3) / 4;
+	}
+	cellStart[numCells] = numBlocks;
+
+	edgeBlocks.assign(numBlocks * blockSize, 0);
+	for(int cell = 0; cell < numCells; cell++){
+		const vector<int> & edges = cellEdges[cell];
+		for(int e = 0; e < (int)edges.size(); e++){
+			const ofPoint & a = points[edges[e]];
+			const ofPoint & b = points[(edges[e] + 1) % N];
+			float ax = a.x - refX[cell], ay = a.y - refY[cell];
+			float bx = b.x - refX[cell], by = b.y - refY[cell];
+			float nx = ay - by;
+			float ny = bx - ax;
+			float * block = &edgeBlocks[(cellStart[cell] + e / 4) * blockSize];
+			int j = e % 4;
+			block[j] = ax;
+			block[4+j] = ay;
+			block[8+j] = bx;
+			block[12+j] = by;
+			block[16+j] = nx;
+			block[20+j] = ny;
+			block[24+j] = -(nx * ax + ny * ay);
+		}
+	}
+}
+
+//----------------------------------------------------------
+ofRectangle ofPreparedPolygon::getBoundingBox() const{
+	return ofRectangle(minX, minY, maxX - minX, maxY - minY);
+}
+
+//----------------------------------------------------------
+int ofPreparedPolygon::getNumEdges() const{
+	return numEdges;
+}
+
+//----------------------------------------------------------
+int ofPreparedPolygon::getGridWidth() const{
+	return gridWidth;
+}
+
+//----------------------------------------------------------
+int ofPreparedPolygon::getGridHeight() const{
+	return gridHeight;
+}
+
+//----------------------------------------------------------
+int ofPreparedPolygon::getCell(float x, float y) const{
+	// written so nan ends up outside too
+	if(!isBuilt() || !(x >= minX && x <= maxX && y >= minY && y <= maxY)) return -1;
+	int col = MIN(int((x - minX) / cellWidth), gridWidth - 1);
+	int row = MIN(int((y - minY) / cellHeight), gridHeight - 1);
+	return row * gridWidth + col;
+}
+
+//----------------------------------------------------------
+bool ofPreparedPolygon::inside(float x, float y) const{
+	unsigned char result;
+	ofPoint p(x, y);
+	insideRange(&p, &result, 1, ofGetSimdLevel() != OF_SIMD_NONE);
+	return result;
+}
+
+//----------------------------------------------------------
+bool ofPreparedPolygon::inside(const ofPoint & p) const{
+	return inside(p.x, p.y);
+}
+
+//----------------------------------------------------------
+void ofPreparedPolygon::inside(const vector<ofPoint> & points, vector<bool> & result) const{
+	// vector<bool> can't be written from several threads
+	vector<unsigned char> inside(points.size());
+	bool useSimd = ofGetSimdLevel() != OF_SIMD_NONE;
+	ofParallelFor(0, points.size(), [&](int begin, int end){
+		insideRange(&points[begin], &inside[begin], end - begin, useSimd);
+	}, 1024);
+	result.assign(inside.begin(), inside.end());
+}
+
+//----------------------------------------------------------
+void ofPreparedPolygon::insideRange(const ofPoint * points, unsigned char * result, int count, bool useSimd) const{
+	for(int i = 0; i < count; i++){
+		int cell = getCell(points[i].x, points[i].y);
+		if(cell < 0){
+			result[i] = false;
+			continue;
+		}
+		const float * block = edgeBlocks.empty() ? NULL : &edgeBlocks[cellStart[cell] * blockSize];
+		int numBlocks = cellStart[cell + 1] - cellStart[cell];
+		float px = points[i].x - refX[cell];
+		float py = points[i].y - refY[cell];
+		int parity;
+		if(useSimd){
+#if defined(OF_POLYGON_SIMD_SSE2)
+			parity = crossingParitySse2(block, numBlocks, px, py);
+#elif defined(OF_POLYGON_SIMD_WASM)
+			parity = crossingParityWasm(block, numBlocks, px, py);
+#else
+			parity = crossingParityScalar(block, numBlocks, px, py);
+#endif
+		}else{
+			parity = crossingParityScalar(block, numBlocks, px, py);
+		}
+		result[i] = refInside[cell] ^ parity;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ofPolyline.h"
+#include "ofRectangle.h"
+
+// a polyline prepared for fast point in polygon tests, for when the same
+// outline is tested against many points:
+//
+//	ofPreparedPolygon polygon(outline);
+//	vector<bool> inside;
+//	polygon.inside(particles, inside);
+//
+// the edges are bucketed into a grid over the bounding box. each cell knows
+// whether a point close to its center is inside the polygon, a query only
+// has to count the crossings between that point and the query point with the
+// edges in its cell, so the cost depends on the number of edges per cell
+// instead of the number of vertices. cells without edges answer directly.
+//
+// as with ofPolyline::inside the polyline is always considered closed and
+// only x and y are used. the result for points exactly on the outline can
+// differ from ofPolyline::inside. the polygon keeps a copy of the edges, it
+// has to be built again if the polyline changes
+class ofPreparedPolygon{
+public:
+	ofPreparedPolygon();
+	ofPreparedPolygon(const ofPolyline & polyline);
+
+	void build(const ofPolyline & polyline);
+	void clear();
+	bool isBuilt() const;
+
+	ofRectangle getBoundingBox() const;
+	int getNumEdges() const;
+	int getGridWidth() const;
+	int getGridHeight() const;
+
+	bool inside(float x, float y) const;
+	bool inside(const ofPoint & p) const;
+
+	// tests every point, splitting the work over ofParallelFor and testing
+	// several edges at once with simd where available. result is resized to
+	// the number of points
+	void inside(const vector<ofPoint> & points, vector<bool> & result) const;
+
+private:
+	int getCell(float x, float y) const;
+	void insideRange(const ofPoint * points, unsigned char * result, int count, bool useSimd) const;
+
+	float minX, minY, maxX, maxY;
+	float cellWidth, cellHeight;
+	int gridWidth, gridHeight;
+	int numEdges;
+
+	// per cell the point the crossings are counted from and whether it's
+	// inside. the edges of a cell are the blocks [cellStart[i], cellStart[i+1])
+	vector<float> refX, refY;
+	vector<unsigned char> refInside;
+	vector<int> cellStart;
+
+	// blocks of 4 edges, each block stores ax, ay, bx, by, nx, ny, d for the
+	// 4 edges one after the other. the coordinates are relative to the
+	// reference point of the cell and nx*x + ny*y + d is the orientation of a
+	// point to the edge. cells are padded with empty edges that never cross
+	vector<float> edgeBlocks;
+};
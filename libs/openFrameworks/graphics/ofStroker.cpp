@@ -0,0 +1,514 @@
+#include "ofStroker.h"
+#include <limits>
+
+// points closer than this are merged before stroking
+static const float minSegmentLength = 1e-5f;
+
+//----------------------------------------------------------
+// emits the triangles straight into the mesh vectors, keeping the segment
+// directions and lengths of the current polyline
+struct ofStroker::Builder{
+	Builder(const ofStroker & stroker, ofMesh & mesh)
+	:stroker(stroker)
+	,vertices(mesh.getVertices())
+	,indices(mesh.getIndices())
+	,hw(stroker.width*0.5f)
+	,full(false){}
+
+	// once the indices can't reach a new vertex nothing else is added and
+	// the polyline being stroked is removed
+	ofIndexType add(const ofPoint & p, const ofVec2f & offset){
+		if(full || vertices.size() > maxIndex()){
+			full = true;
+			return 0;
+		}
+		vertices.push_back(ofVec3f(p.x+offset.x, p.y+offset.y, p.z));
+		return vertices.size()-1;
+	}
+
+	void triangle(ofIndexType a, ofIndexType b, ofIndexType c){
+		if(full) return;
+		indices.push_back(a);
+		indices.push_back(b);
+		indices.push_back(c);
+	}
+
+	void quad(ofIndexType l0, ofIndexType r0, ofIndexType l1, ofIndexType r1){
+		triangle(l0,r0,l1);
+		triangle(l1,r0,r1);
+	}
+
+	int arcSegments(float angle) const{
+		angle = fabs(angle);
+		int segments;
+		if(stroker.circleResolution>0){
+			segments = ceil(angle / TWO_PI * stroker.circleResolution);
+		}else{
+			// keep the chords within a quarter unit of the arc
+			float step = hw>0.25f ? 2*acos(1-0.25f/hw) : PI;
+			segments = ceil(angle / step);
+		}
+		return ofClamp(segments,1,128);
+	}
+
+	// triangles from apex to the arc around center, from u0 rotated by sweep
+	// radians. first and last are the vertices at both ends of the arc
+	void fan(ofIndexType apex, const ofPoint & center, const ofVec2f & u0, float sweep, ofIndexType first, ofIndexType last){
+		int segments = arcSegments(sweep);
+		ofIndexType prev = first;
+		for(int i=1;i<segments;i++){
+			float a = sweep*i/segments;
+			float c = cos(a), s = sin(a);
+			ofIndexType next = add(center, ofVec2f(u0.x*c - u0.y*s, u0.x*s + u0.y*c)*hw);
+			triangle(apex,prev,next);
+			prev = next;
+		}
+		triangle(apex,prev,last);
+	}
+
+	// the left and right vertices where the stroke starts at p going towards d
+	void startCap(const ofPoint & p, const ofVec2f & d, ofIndexType & l, ofIndexType & r){
+		ofVec2f n(-d.y,d.x);
+		if(stroker.cap==OF_STROKE_CAP_SQUARE){
+			l = add(p, (n-d)*hw);
+			r = add(p, (-n-d)*hw);
+		}else{
+			l = add(p, n*hw);
+			r = add(p, -n*hw);
+			if(stroker.cap==OF_STROKE_CAP_ROUND){
+				fan(add(p,ofVec2f()), p, n, PI, l, r);
+			}
+		}
+	}
+
+	// the left and right vertices where the stroke ends at p coming from d
+	void endCap(const ofPoint & p, const ofVec2f & d, ofIndexType & l, ofIndexType & r){
+		ofVec2f n(-d.y,d.x);
+		if(stroker.cap==OF_STROKE_CAP_SQUARE){
+			l = add(p, (n+d)*hw);
+			r = add(p, (-n+d)*hw);
+		}else{
+			l = add(p, n*hw);
+			r = add(p, -n*hw);
+			if(stroker.cap==OF_STROKE_CAP_ROUND){
+				fan(add(p,ofVec2f()), p, -n, PI, r, l);
+			}
+		}
+	}
+
+	// a stroke of a single point, only visible with round or square caps
+	void dot(const ofPoint & p, const ofVec2f & d){
+		ofVec2f n(-d.y,d.x);
+		if(stroker.cap==OF_STROKE_CAP_ROUND){
+			ofIndexType first = add(p, n*hw);
+			fan(add(p,ofVec2f()), p, n, TWO_PI, first, first);
+		}else if(stroker.cap==OF_STROKE_CAP_SQUARE){
+			quad(add(p,(n-d)*hw), add(p,(-n-d)*hw), add(p,(n+d)*hw), add(p,(-n+d)*hw));
+		}
+	}
+
+	// the join at vertex i between segments i-1 and i. inL, inR end the
+	// incoming segment, outL, outR start the outgoing one
+	void joinAt(int i, int prev, ofIndexType & inL, ofIndexType & inR, ofIndexType & outL, ofIndexType & outR){
+		const ofPoint & p = points[i];
+		const ofVec2f & d0 = directions[prev];
+		const ofVec2f & d1 = directions[i];
+		ofVec2f n0(-d0.y,d0.x), n1(-d1.y,d1.x);
+		float cross = d0.x*d1.y - d0.y*d1.x;
+		float dot = d0.dot(d1);
+		if(fabs(cross)<1e-6f && dot>0){
+			inL = outL = add(p, n0*hw);
+			inR = outR = add(p, -n0*hw);
+			return;
+		}
+
+		// the outer side of the turn is to the right when turning left
+		float side = cross>0 ? -1 : 1;
+		ofVec2f o0 = n0*side, o1 = n1*side;
+		ofIndexType a = add(p, o0*hw);
+		ofIndexType b = add(p, o1*hw);
+
+		// the miter goes along the bisector, its projection on either normal
+		// is the half width. it doesn't exist for a full turn back
+		float k = 1 + o0.dot(o1);
+		bool hasMiter = k>1e-6f;
+		ofVec2f miter;
+		if(hasMiter){
+			miter = (o0+o1) * (hw/k);
+		}
+
+		// the inner corner is where both edges meet, unless that's past the
+		// end of one of the segments, then both segments end at p and the
+		// overlap covers the inside
+		ofIndexType pivot, innerIn, innerOut;
+		if(hasMiter && fabs(miter.dot(d0)) <= std::min(lengths[prev], lengths[i])){
+			pivot = innerIn = innerOut = add(p, -miter);
+		}else{
+			innerIn = add(p, -o0*hw);
+			innerOut = add(p, -o1*hw);
+			pivot = add(p, ofVec2f());
+		}
+
+		switch(stroker.join){
+		case OF_STROKE_JOIN_MITER:
+			if(hasMiter && miter.lengthSquared() <= stroker.miterLimit*stroker.miterLimit*hw*hw){
+				ofIndexType m = add(p, miter);
+				triangle(pivot,a,m);
+				triangle(pivot,m,b);
+			}else{
+				triangle(pivot,a,b);
+			}
+			break;
+		case OF_STROKE_JOIN_BEVEL:
+			triangle(pivot,a,b);
+			break;
+		case OF_STROKE_JOIN_ROUND:{
+			// rotating the outer normal by -side goes forward around p
+			float angle = acos(ofClamp(o0.dot(o1),-1,1));
+			fan(pivot, p, o0, -side*angle, a, b);
+			break;
+		}
+		}
+
+		if(side>0){
+			inL = a; inR = innerIn;
+			outL = b; outR = innerOut;
+		}else{
+			inL = innerIn; inR = a;
+			outL = innerOut; outR = b;
+		}
+	}
+
+	// copies the polyline without repeated points and computes the segments,
+	// closing ones included
+	void setPoints(const ofPoint * src, int count, bool closed){
+		points.clear();
+		for(int i=0;i<count;i++){
+			if(points.empty() || points.back().squareDistance(src[i]) > minSegmentLength*minSegmentLength){
+				points.push_back(src[i]);
+			}
+		}
+		if(closed){
+			while(points.size()>1 && points.back().squareDistance(points.front()) <= minSegmentLength*minSegmentLength){
+				points.pop_back();
+			}
+		}
+		int n = points.size();
+		int segments = closed && n>1 ? n : n-1;
+		directions.resize(std::max(segments,0));
+		lengths.resize(std::max(segments,0));
+		for(int i=0;i<segments;i++){
+			ofVec2f d(points[(i+1)%n].x - points[i].x, points[(i+1)%n].y - points[i].y);
+			lengths[i] = d.length();
+			directions[i] = d / lengths[i];
+		}
+	}
+
+	void strokeOpen(const ofVec2f & dotDirection){
+		int n = points.size();
+		if(n==0) return;
+		if(n==1){
+			dot(points[0], dotDirection);
+			return;
+		}
+		ofIndexType l, r, inL, inR;
+		startCap(points[0], directions[0], l, r);
+		for(int i=1;i<n-1;i++){
+			ofIndexType outL, outR;
+			joinAt(i, i-1, inL, inR, outL, outR);
+			quad(l,r,inL,inR);
+			l = outL;
+			r = outR;
+		}
+		endCap(points[n-1], directions[n-2], inL, inR);
+		quad(l,r,inL,inR);
+	}
+
+	void strokeClosed(){
+		int n = points.size();
+		if(n<2){
+			strokeOpen(ofVec2f(1,0));
+			return;
+		}
+		ofIndexType firstL, firstR, l, r;
+		joinAt(0, n-1, firstL, firstR, l, r);
+		for(int i=1;i<n;i++){
+			ofIndexType inL, inR, outL, outR;
+			joinAt(i, i-1, inL, inR, outL, outR);
+			quad(l,r,inL,inR);
+			l = outL;
+			r = outR;
+		}
+		quad(l,r,firstL,firstR);
+	}
+
+	void strokeDash(const ofVec2f & direction){
+		setPoints(&dashPoints[0], dashPoints.size(), false);
+		strokeOpen(direction);
+	}
+
+	// walks the segments of the polyline switching the pattern on and off,
+	// every on part is stroked as an open polyline with its own caps
+	void strokeDashed(const ofPoint * src, int count, bool closed){
+		setPoints(src, count, closed);
+		int n = points.size();
+		if(n==1){
+			strokeOpen(ofVec2f(1,0));
+			return;
+		}
+		// the dashes reuse points, directions and lengths
+		polyline.swap(points);
+		polylineDirections.swap(directions);
+		polylineLengths.swap(lengths);
+
+		const vector<float> & pattern = stroker.dashes;
+		float total = 0;
+		for(int i=0;i<(int)pattern.size();i++){
+			total += pattern[i];
+		}
+		float offset = fmod(stroker.dashOffset, total);
+		if(offset<0) offset += total;
+		int dash = 0;
+		while(offset>0 && offset >= pattern[dash]){
+			offset -= pattern[dash];
+			dash = (dash+1) % pattern.size();
+		}
+		float remaining = pattern[dash] - offset;
+
+		dashPoints.clear();
+		if(dash%2==0) dashPoints.push_back(polyline[0]);
+		for(int i=0;i<(int)polylineLengths.size();i++){
+			const ofPoint & a = polyline[i];
+			const ofPoint & b = polyline[(i+1)%n];
+			float length = polylineLengths[i];
+			float position = 0;
+			// a boundary right at the end of the last segment starts a dash
+			// that is still drawn if it has no length
+			bool last = i==(int)polylineLengths.size()-1;
+			while(length - position > remaining || (last && length - position >= remaining - minSegmentLength)){
+				position += remaining;
+				ofPoint p = a + (b-a)*(position/length);
+				dashPoints.push_back(p);
+				if(dash%2==0){
+					strokeDash(polylineDirections[i]);
+				}
+				dashPoints.clear();
+				dashPoints.push_back(p);
+				dash = (dash+1) % pattern.size();
+				remaining = pattern[dash];
+			}
+			remaining -= length - position;
+			if(dash%2==0) dashPoints.push_back(b);
+		}
+		// unless it started right at the end
+		if(dash%2==0 && remaining < pattern[dash]){
+			strokeDash(polylineDirections.back());
+		}
+	}
+
+	void stroke(const ofPolyline & polyline){
+		if(full || polyline.size()==0) return;
+		int numVertices = vertices.size();
+		int numIndices = indices.size();
+		const ofPoint * src = &polyline.getVertices()[0];
+		if(stroker.isDashed()){
+			strokeDashed(src, polyline.size(), polyline.isClosed());
+		}else if(polyline.isClosed()){
+			setPoints(src, polyline.size(), true);
+			strokeClosed();
+		}else{
+			setPoints(src, polyline.size(), false);
+			strokeOpen(ofVec2f(1,0));
+		}
+		if(full){
+			vertices.resize(numVertices);
+			indices.resize(numIndices);
+			ofLogError("ofStroker") << "stroke(): mesh can't hold more than " << maxIndex() + 1 << " vertices with its indices, dropping the rest of the strokes";
+		}
+	}
+
+	static size_t maxIndex(){
+		return std::numeric_limits<ofIndexType>::max();
+	}
+
+	const ofStroker & stroker;
+	vector<ofVec3f> & vertices;
+	vector<ofIndexType> & indices;
+	float hw;
+	bool full;
+
+	vector<ofPoint> points;
+	vector<ofVec2f> directions;
+	vector<float> lengths;
+	vector<ofPoint> dashPoints;
+	vector<ofPoint> polyline;
+	vector<ofVec2f> polylineDirections;
+	vector<float> polylineLengths;
+};
+
+//----------------------------------------------------------
+ofStroker::ofStroker(){
+	width = 1;
+	join = OF_STROKE_JOIN_MITER;
+	cap = OF_STROKE_CAP_BUTT;
+	miterLimit = 4;
+	circleResolution = 0;
+	dashOffset = 0;
+}
+
+//----------------------------------------------------------
+void ofStroker::setWidth(float _width){
+	width = _width;
+}
+
+//----------------------------------------------------------
+void ofStroker::setJoin(ofStrokeJoin _join){
+	join = _join;
+}
+
+//----------------------------------------------------------
+void ofStroker::setCap(ofStrokeCap _cap){
+	cap = _cap;
+}
+
+//----------------------------------------------------------
+void ofStroker::setMiterLimit(float limit){
+	if(limit<1){
+		ofLogWarning("ofStroker") << "setMiterLimit(): limit " << limit << " is less than 1, using 1";
+		limit = 1;
+	}
+	miterLimit = limit;
+}
+
+//----------------------------------------------------------
+void ofStroker::setCircleResolution(int resolution){
+	circleResolution = resolution;
+}
+
+//----------------------------------------------------------
+void ofStroker::setDashes(const vector<float> & _dashes, float offset){
+	float total = 0;
+	for(int i=0;i<(int)_dashes.size();i++){
+		if(_dashes[i]<0){
+			ofLogError("ofStroker") << "setDashes(): negative dash length " << _dashes[i] << ", drawing solid strokes";
+			clearDashes();
+			return;
+		}
+		total += _dashes[i];
+	}
+	if(!_dashes.empty() && total<=0){
+		ofLogError("ofStroker") << "setDashes(): dash lengths add up to 0, drawing solid strokes";
+		clearDashes();
+		return;
+	}
+	dashes = _dashes;
+	if(dashes.size()%2==1){
+		dashes.insert(dashes.end(), _dashes.begin(), _dashes.end());
+	}
+	dashOffset = offset;
+}
+
+//----------------------------------------------------------
+void ofStroker::clearDashes(){
+	dashes.clear();
+	dashOffset = 0;
+}
+
+//----------------------------------------------------------
+float ofStroker::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------
+ofStrokeJoin ofStroker::getJoin() const{
+	return join;
+}
+
+//----------------------------------------------------------
+ofStrokeCap ofStroker::getCap() const{
+	return cap;
+}
+
+//----------------------------------------------------------
+float ofStroker::getMiterLimit() const{
+	return miterLimit;
+}
+
+//----------------------------------------------------------
+int ofStroker::getCircleResolution() const{
+	return circleResolution;
+}
+
+//----------------------------------------------------------
+const vector<float> & ofStroker::getDashes() const{
+	return dashes;
+}
+
+//----------------------------------------------------------
+float ofStroker::getDashOffset() const{
+	return dashOffset;
+}
+
+//----------------------------------------------------------
+bool ofStroker::isDashed() const{
+	return !dashes.empty();
+}
+
+//----------------------------------------------------------
+bool ofStroker::checkMesh(ofMesh & mesh) const{
+	if(mesh.getNumVertices()==0){
+		mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+		return true;
+	}
+	if(mesh.getMode()!=OF_PRIMITIVE_TRIANGLES || mesh.getNumIndices()==0){
+		ofLogError("ofStroker") << "stroke(): mesh has to be empty or indexed OF_PRIMITIVE_TRIANGLES";
+		return false;
+	}
+	if((size_t)mesh.getNumVertices() > Builder::maxIndex()){
+		ofLogError("ofStroker") << "stroke(): mesh already has " << mesh.getNumVertices() << " vertices, the max its indices can reach";
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+void ofStroker::stroke(const ofPolyline & polyline, ofMesh & mesh) const{
+	if(width<=0 || !checkMesh(mesh)) return;
+	Builder builder(*this, mesh);
+	builder.stroke(polyline);
+}
+
+//----------------------------------------------------------
+void ofStroker::stroke(const ofPolyline & polyline, ofMesh & mesh, const ofFloatColor & color) const{
+	stroke(polyline, mesh);
+	mesh.getColors().resize(mesh.getNumVertices(), color);
+}
+
+//----------------------------------------------------------
+void ofStroker::stroke(const vector<ofPolyline> & polylines, ofMesh & mesh) const{
+	if(width<=0 || !checkMesh(mesh)) return;
+	Builder builder(*this, mesh);
+	for(int i=0;i<(int)polylines.size();i++){
+		builder.stroke(polylines[i]);
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::stroke(const vector<ofPolyline> & polylines, ofMesh & mesh, const ofFloatColor & color) const{
+	stroke(polylines, mesh);
+	mesh.getColors().resize(mesh.getNumVertices(), color);
+}
+
+//----------------------------------------------------------
+ofMesh ofStroker::getStroke(const ofPolyline & polyline) const{
+	ofMesh mesh;
+	stroke(polyline, mesh);
+	return mesh;
+}
+
+//----------------------------------------------------------
+ofMesh ofStroker::getStroke(const vector<ofPolyline> & polylines) const{
+	ofMesh mesh;
+	stroke(polylines, mesh);
+	return mesh;
+}
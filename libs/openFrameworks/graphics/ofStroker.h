@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ofPolyline.h"
+#include "ofMesh.h"
+
+enum ofStrokeJoin{
+	OF_STROKE_JOIN_MITER,
+	OF_STROKE_JOIN_ROUND,
+	OF_STROKE_JOIN_BEVEL
+};
+
+enum ofStrokeCap{
+	OF_STROKE_CAP_BUTT,
+	OF_STROKE_CAP_ROUND,
+	OF_STROKE_CAP_SQUARE
+};
+
+// turns polylines into the triangles of their outline with a given width,
+// for when GL lines are too thin or don't support the width at all, as in
+// GL ES and core profiles:
+//
+//	ofStroker stroker;
+//	stroker.setWidth(8);
+//	stroker.setJoin(OF_STROKE_JOIN_ROUND);
+//	ofMesh mesh;
+//	for(int i=0;i<(int)lines.size();i++){
+//		stroker.stroke(lines[i], mesh, colors[i]);
+//	}
+//	mesh.draw();
+//
+// the strokes are appended to the mesh so any number of them can be drawn in
+// one call. joins and caps follow the svg rules: miters longer than
+// miterLimit times the width become bevels and dashes alternate on and off
+// lengths starting with on. the stroke is built in the xy plane, z is taken
+// from the vertices
+class ofStroker{
+public:
+	ofStroker();
+
+	void setWidth(float width); // default 1
+	void setJoin(ofStrokeJoin join); // default OF_STROKE_JOIN_MITER
+	void setCap(ofStrokeCap cap); // default OF_STROKE_CAP_BUTT
+	void setMiterLimit(float limit); // default 4
+	// segments used for a full circle in round joins and caps, 0 (default)
+	// picks them from the width
+	void setCircleResolution(int resolution);
+	// an odd number of lengths is repeated to make it even, an empty pattern
+	// draws a solid stroke
+	void setDashes(const vector<float> & dashes, float offset=0);
+	void clearDashes();
+
+	float getWidth() const;
+	ofStrokeJoin getJoin() const;
+	ofStrokeCap getCap() const;
+	float getMiterLimit() const;
+	int getCircleResolution() const;
+	const vector<float> & getDashes() const;
+	float getDashOffset() const;
+	bool isDashed() const;
+
+	// appends the stroke to mesh, which has to be empty or indexed
+	// OF_PRIMITIVE_TRIANGLES. the overloads with a color add it to every new
+	// vertex, don't mix them with the ones without color on the same mesh.
+	// the mesh can't grow past the vertices its indices reach, 65536 where
+	// ofIndexType is 16 bits as on android and arm. a polyline that doesn't
+	// fit is dropped with an error, as are the ones after it
+	void stroke(const ofPolyline & polyline, ofMesh & mesh) const;
+	void stroke(const ofPolyline & polyline, ofMesh & mesh, const ofFloatColor & color) const;
+	void stroke(const vector<ofPolyline> & polylines, ofMesh & mesh) const;
+	void stroke(const vector<ofPolyline> & polylines, ofMesh & mesh, const ofFloatColor & color) const;
+
+	ofMesh getStroke(const ofPolyline & polyline) const;
+	ofMesh getStroke(const vector<ofPolyline> & polylines) const;
+
+private:
+	struct Builder;
+	bool checkMesh(ofMesh & mesh) const;
+
+	float width;
+	ofStrokeJoin join;
+	ofStrokeCap cap;
+	float miterLimit;
+	int circleResolution;
+	vector<float> dashes;
+	float dashOffset;
+};
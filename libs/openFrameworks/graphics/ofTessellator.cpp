@@ -25,29 +25,71 @@
 //
 // important note!
 //
-// this assumes single threaded polygon creation
-// you can have big problems if creating polygons in
-// multiple threads... please be careful
-//
-// (but also be aware that alot of opengl code
-// is single threaded anyway, so you will have problems
-// with many things opengl related across threads)
+// a tessellator can only be used from one thread at a
+// time, ofTessellator::getThreadTessellator() gives
+// every thread its own one
 //
 // ------------------------------------
 // (note: this implementation is based on code from ftgl)
 // ------------------------------------
 
 
-void * memAllocator( void *userData, unsigned int size ){
-	return malloc(size);
+// blocks freed by libtess2 by size, class i holds blocks of 16 << i bytes.
+// libtess2 allocates mostly the same bucket sizes on every tessellation so
+// after the first few a tessellator doesn't need to ask the system for memory
+struct ofTessellator::MemoryPool{
+	~MemoryPool(){
+		for(int i=0;i<numClasses;i++){
+			for(int j=0;j<(int)freeBlocks[i].size();j++){
+				free(freeBlocks[i][j]);
+			}
+		}
+	}
+
+	static const int numClasses = 29;
+	vector<void*> freeBlocks[numClasses];
+};
+
+// every block starts with its size class, padded so the memory returned
+// keeps malloc's alignment
+static const size_t blockHeaderSize = 16;
+
+static size_t blockSize(int sizeClass){
+	return size_t(16) << sizeClass;
 }
 
-void * memReallocator( void *userData, void* ptr, unsigned int size ){
-	return realloc(ptr,size);
+static void * memAllocator( void *userData, unsigned int size ){
+	vector<void*> * freeBlocks = (vector<void*>*)userData;
+	int sizeClass = 0;
+	while(blockSize(sizeClass) < size) sizeClass++;
+	void * block;
+	if(!freeBlocks[sizeClass].empty()){
+		block = freeBlocks[sizeClass].back();
+		freeBlocks[sizeClass].pop_back();
+	}else{
+		block = malloc(blockHeaderSize + blockSize(sizeClass));
+		if(block == NULL) return NULL;
+	}
+	*(int*)block = sizeClass;
+	return (char*)block + blockHeaderSize;
+}
+
+static void memFree( void *userData, void *ptr ){
+	if(ptr == NULL) return;
+	vector<void*> * freeBlocks = (vector<void*>*)userData;
+	void * block = (char*)ptr - blockHeaderSize;
+	freeBlocks[*(int*)block].push_back(block);
 }
 
-void memFree( void *userData, void *ptr ){
-	free (ptr);
+static void * memReallocator( void *userData, void* ptr, unsigned int size ){
+	if(ptr == NULL) return memAllocator(userData, size);
+	size_t currentSize = blockSize(*(int*)((char*)ptr - blockHeaderSize));
+	if(size <= currentSize) return ptr;
+	void * newPtr = memAllocator(userData, size);
+	if(newPtr == NULL) return NULL;
+	memcpy(newPtr, ptr, currentSize);
+	memFree(userData, ptr);
+	return newPtr;
 }
 
 //----------------------------------------------------------
@@ -57,7 +99,7 @@ ofTessellator::ofTessellator(){
 
 //----------------------------------------------------------
 ofTessellator::~ofTessellator(){
-	tessDeleteTess(cacheTess);
+	destroy();
 }
 
 //----------------------------------------------------------
@@ -67,12 +109,29 @@ ofTessellator::ofTessellator(const ofTessellator & mom){
 
 //----------------------------------------------------------
 ofTessellator & ofTessellator::operator=(const ofTessellator & mom){
-	if(&mom != this) init();
+	if(&mom != this){
+		destroy();
+		init();
+	}
 	return *this;
 }
 
+//----------------------------------------------------------
+ofTessellator & ofTessellator::getThreadTessellator(){
+	static thread_local ofTessellator tessellator;
+	return tessellator;
+}
+
+//----------------------------------------------------------
+void ofTessellator::destroy(){
+	tessDeleteTess(cacheTess);
+	delete memoryPool;
+}
+
 //----------------------------------------------------------
 void ofTessellator::init(){
+	memoryPool = new MemoryPool;
+	tessAllocator.userData = memoryPool->freeBlocks;
 	tessAllocator.memalloc = memAllocator;
 	tessAllocator.memrealloc = memReallocator;
 	tessAllocator.memfree = memFree;
@@ -88,8 +147,7 @@ void ofTessellator::init(){
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D){
 
-	ofPolyline& polyline = const_cast<ofPolyline&>(src);
-	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
+	tessAddContour( cacheTess, bIs2D?2:3, &src.getVertices()[0], sizeof(ofPoint), src.size());
 
 	performTessellation( polyWindingMode, dstmesh, bIs2D );
 }
@@ -101,9 +159,7 @@ void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindi
 
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
-		ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
-
-		tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0].x, sizeof(ofPoint), polyline.size());
+		tessAddContour( cacheTess, bIs2D?2:3, &src[i].getVertices()[0].x, sizeof(ofPoint), src[i].size());
 	}
 
 	performTessellation( polyWindingMode, dstmesh, bIs2D );
@@ -112,8 +168,7 @@ void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindi
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D){
 
-	ofPolyline& polyline = const_cast<ofPolyline&>(src);
-	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(ofPoint), polyline.size());
+	tessAddContour( cacheTess, bIs2D?2:3, &src.getVertices()[0], sizeof(ofPoint), src.size());
 
 	performTessellation( polyWindingMode, dstpoly, bIs2D );
 }
@@ -124,9 +179,7 @@ void ofTessellator::tessellateToPolylines( const vector<ofPolyline>& src, ofPoly
 
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
-		ofPolyline& polyline = const_cast<ofPolyline&>(src[i]);
-
-		tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0].x, sizeof(ofPoint), polyline.size());
+		tessAddContour( cacheTess, bIs2D?2:3, &src[i].getVertices()[0].x, sizeof(ofPoint), src[i].size());
 	}
 
 	performTessellation( polyWindingMode, dstpoly, bIs2D );
@@ -138,6 +191,9 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 
 	if (!tessTesselate(cacheTess, polyWindingMode, TESS_POLYGONS, 3, 3, 0)){
 		ofLogError("ofTessellator") << "performTessellation(): mesh polygon tessellation failed, winding mode " << polyWindingMode;
+		// libtess2 keeps the contours after a failure, start from a clean context
+		destroy();
+		init();
 		return;
 	}
 
@@ -161,6 +217,8 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
 	if (!tessTesselate(cacheTess, polyWindingMode, TESS_BOUNDARY_CONTOURS, 0, 3, 0)){
 		ofLogError("ofTessellator") << "performTesselation(): polyline boundary contours tessellation failed, winding mode " << polyWindingMode;
+		destroy();
+		init();
 		return;
 	}
 
@@ -7,6 +7,10 @@
 #include "tesselator.h"
 
 
+// a libtess2 context. it's not thread safe, use one ofTessellator per
+// thread, getThreadTessellator() returns one for the calling thread. the
+// memory libtess2 frees is kept by each tessellator and reused for the next
+// tessellations instead of going back to the system
 class ofTessellator
 {
 public:	
@@ -22,14 +26,20 @@ public:
 	void tessellateToPolylines( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D=false );
 	void tessellateToPolylines( const ofPolyline & src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D=false );
 
+	// the tessellator of the calling thread, created the first time it's used
+	static ofTessellator & getThreadTessellator();
+
 private:
+	struct MemoryPool;
 	
 	void performTessellation( ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D );
 	void performTessellation(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D );
 	void init();
+	void destroy();
 
 	TESStesselator * cacheTess;
 	TESSalloc tessAllocator;
+	MemoryPool * memoryPool;
 };
 
 
@@ -0,0 +1,123 @@
+#include "ofTextBlock.h"
+#include "ofTrueTypeFont.h"
+#include "ofGraphics.h"
+
+//----------------------------------------------------------
+ofTextBlock::ofTextBlock(){
+	font = NULL;
+	generation = 0;
+	bVFlipped = false;
+	bNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+ofTextBlock::ofTextBlock(ofTrueTypeFont & font, const string & text){
+	generation = 0;
+	bVFlipped = false;
+	setup(font,text);
+}
+
+//----------------------------------------------------------
+void ofTextBlock::setup(ofTrueTypeFont & _font, const string & _text){
+	font = &_font;
+	text = _text;
+	bNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+void ofTextBlock::setFont(ofTrueTypeFont & _font){
+	if(font == &_font) return;
+	font = &_font;
+	bNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+void ofTextBlock::setText(const string & _text){
+	if(text == _text) return;
+	text = _text;
+	bNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+ofTrueTypeFont * ofTextBlock::getFont() const{
+	return font;
+}
+
+//----------------------------------------------------------
+const string & ofTextBlock::getText() const{
+	return text;
+}
+
+//----------------------------------------------------------
+ofRectangle ofTextBlock::getBoundingBox(){
+	update();
+	return boundingBox;
+}
+
+//----------------------------------------------------------
+void ofTextBlock::update(){
+	if(!font || !font->isLoaded()){
+		pages.clear();
+		boundingBox = ofRectangle();
+		return;
+	}
+	if(!bNeedsUpdate && generation == font->getGeneration() && bVFlipped == ofIsVFlipped()){
+		return;
+	}
+
+	vector<ofMesh> meshes;
+	font->getStringMeshes(text, meshes);
+	pages.resize(meshes.size());
+	for(int i=0;i<(int)meshes.size();i++){
+		pages[i] = meshes[i];
+	}
+	boundingBox = font->getStringBoundingBox(text, 0, 0);
+
+	// building it can add glyphs to the atlas
+	generation = font->getGeneration();
+	bVFlipped = ofIsVFlipped();
+	bNeedsUpdate = false;
+}
+
+//----------------------------------------------------------
+void ofTextBlock::draw(){
+	if(!font || !font->isLoaded()){
+		return;
+	}
+
+	// binding starts a new batch in the atlas of dynamic fonts, which can
+	// drop pages, so the layout is checked after it
+	bool alreadyBinded = font->binded;
+	if(!alreadyBinded) font->bind();
+	update();
+	for(int i=0;i<(int)pages.size();i++){
+		if(pages[i].getNumVertices() == 0) continue;
+		if(font->bDynamic){
+			font->atlas->touch(i);
+			ofTexture & texture = font->atlas->getTexture(i);
+			texture.bind();
+			pages[i].drawFaces();
+			texture.unbind();
+		}else{
+			// bind() already bound the texture of the font
+			pages[i].drawFaces();
+		}
+	}
+	if(!alreadyBinded) font->unbind();
+}
+
+//----------------------------------------------------------
+void ofTextBlock::draw(float x, float y){
+	ofPushMatrix();
+	ofTranslate(x, y);
+	draw();
+	ofPopMatrix();
+}
+
+//----------------------------------------------------------
+void ofTextBlock::draw(const ofMatrix4x4 & transform){
+	ofPushMatrix();
+	ofMultMatrix(transform);
+	draw();
+	ofPopMatrix();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofRectangle.h"
+#include "ofMatrix4x4.h"
+#include "ofVboMesh.h"
+
+class ofTrueTypeFont;
+
+// the quads of a string in a font, laid out once and kept in vbos so drawing
+// it again only costs the draw calls:
+//
+//	ofTextBlock label(font, "temperature");
+//	label.draw(20, 40);
+//
+// the layout starts at 0,0 on the baseline of the first line, as drawString
+// does at x, y. it's built again when the text changes, when the font is
+// loaded again or its spacing changes, when the glyph atlas of a dynamic
+// font grows or clears a page and when the vertical flip changes. the font
+// has to outlive the block
+class ofTextBlock{
+public:
+	ofTextBlock();
+	ofTextBlock(ofTrueTypeFont & font, const string & text);
+
+	void setup(ofTrueTypeFont & font, const string & text);
+	void setFont(ofTrueTypeFont & font);
+	void setText(const string & text);
+
+	ofTrueTypeFont * getFont() const;
+	const string & getText() const;
+	ofRectangle getBoundingBox();
+
+	void draw();
+	void draw(float x, float y);
+	void draw(const ofMatrix4x4 & transform);
+
+private:
+	void update();
+
+	ofTrueTypeFont * font;
+	string text;
+	// one mesh per page of the font texture
+	vector<ofVboMesh> pages;
+	ofRectangle boundingBox;
+	unsigned int generation;
+	bool bVFlipped;
+	bool bNeedsUpdate;
+};
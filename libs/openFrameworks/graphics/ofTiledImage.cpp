@@ -0,0 +1,309 @@
+#include "ofTiledImage.h"
+#include "ofGLUtils.h"
+#include <fstream>
+
+static unsigned long long getTileKey(int level, int column, int row){
+	return ((unsigned long long)level << 48) | ((unsigned long long)column << 24) | (unsigned long long)row;
+}
+
+//----------------------------------------------------------
+ofTiledImage::ofTiledImage()
+:width(0)
+,height(0)
+,channels(0)
+,tileSize(0)
+,numLevels(0)
+,bLoaded(false)
+,maxResidentTiles(256)
+,drawCount(0){}
+
+//----------------------------------------------------------
+bool ofTiledImage::load(string path, int _tileSize, string _cacheDirectory){
+	clear();
+
+	if(_tileSize <= 0){
+		ofLogError("ofTiledImage") << "load(): tile size has to be bigger than 0";
+		return false;
+	}
+
+	ofFile file(path);
+	if(!file.exists()){
+		ofLogError("ofTiledImage") << "load(): couldn't find \"" << path << "\"";
+		return false;
+	}
+
+	tileSize = _tileSize;
+	cacheDirectory = ofToDataPath(_cacheDirectory.empty() ? path + ".tiles" : _cacheDirectory, true);
+	string infoPath = ofFilePath::join(cacheDirectory, "tiles.txt");
+
+	// the cache is rebuilt whenever the image or the tile size change
+	string sourceInfo = file.getAbsolutePath() + " " + ofToString(file.getSize()) + " "
+		+ ofToString(file.getPocoFile().getLastModified().epochMicroseconds()) + " " + ofToString(tileSize);
+
+	if(!isCacheValid(infoPath, sourceInfo) && !buildCache(path, infoPath, sourceInfo)){
+		clear();
+		return false;
+	}
+
+	bLoaded = true;
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofTiledImage::isCacheValid(const string & infoPath, const string & sourceInfo){
+	if(!ofFile::doesFileExist(infoPath, false)){
+		return false;
+	}
+	ofBuffer info = ofBufferFromFile(infoPath);
+	if(info.getFirstLine() != sourceInfo){
+		return false;
+	}
+	vector<string> sizes = ofSplitString(info.getNextLine(), " ");
+	if(sizes.size() != 4){
+		return false;
+	}
+	width = ofToInt(sizes[0]);
+	height = ofToInt(sizes[1]);
+	channels = ofToInt(sizes[2]);
+	numLevels = ofToInt(sizes[3]);
+	return width > 0 && height > 0 && channels > 0 && numLevels > 0;
+}
+
+//----------------------------------------------------------
+bool ofTiledImage::buildCache(const string & path, const string & infoPath, const string & sourceInfo){
+	ofPixels level;
+	if(!ofLoadImage(level, path, ofImageLoadSettings())){
+		ofLogError("ofTiledImage") << "load(): couldn't load \"" << path << "\"";
+		return false;
+	}
+
+	ofDirectory::createDirectory(cacheDirectory, false, true);
+
+	width = level.getWidth();
+	height = level.getHeight();
+	channels = level.getNumChannels();
+	numLevels = 0;
+
+	while(true){
+		for(int row = 0; row < getNumTileRows(numLevels); row++){
+			for(int column = 0; column < getNumTileColumns(numLevels); column++){
+				ofPixelsView tile = level.getView(column * tileSize, row * tileSize, tileSize, tileSize);
+				std::ofstream out(getTilePath(numLevels, column, row).c_str(), std::ios::binary);
+				for(int y = 0; y < tile.getHeight(); y++){
+					out.write((const char*)tile.getRow(y), tile.getWidth() * tile.getBytesPerPixel());
+				}
+				if(!out){
+					ofLogError("ofTiledImage") << "load(): couldn't write tiles to \"" << cacheDirectory << "\"";
+					return false;
+				}
+			}
+		}
+		numLevels++;
+
+		if(level.getWidth() <= tileSize && level.getHeight() <= tileSize){
+			break;
+		}
+
+		ofPixels half;
+		half.allocate(getLevelWidth(numLevels), getLevelHeight(numLevels), channels);
+		level.resizeTo(half, OF_INTERPOLATE_AREA);
+		level.swap(half);
+	}
+
+	// written last so an interrupted build is never taken as valid
+	ofBuffer info(sourceInfo + "\n" + ofToString(width) + " " + ofToString(height) + " " + ofToString(channels) + " " + ofToString(numLevels) + "\n");
+	return ofBufferToFile(infoPath, info);
+}
+
+//----------------------------------------------------------
+void ofTiledImage::clear(){
+	tiles.clear();
+	cacheDirectory.clear();
+	width = height = channels = numLevels = 0;
+	bLoaded = false;
+}
+
+//----------------------------------------------------------
+bool ofTiledImage::isLoaded() const{
+	return bLoaded;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getHeight() const{
+	return height;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getNumChannels() const{
+	return channels;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getTileSize() const{
+	return tileSize;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getNumLevels() const{
+	return numLevels;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getLevelWidth(int level) const{
+	return MAX(1, (width + (1 << level) - 1) >> level);
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getLevelHeight(int level) const{
+	return MAX(1, (height + (1 << level) - 1) >> level);
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getNumTileColumns(int level) const{
+	return (getLevelWidth(level) + tileSize - 1) / tileSize;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getNumTileRows(int level) const{
+	return (getLevelHeight(level) + tileSize - 1) / tileSize;
+}
+
+//----------------------------------------------------------
+string ofTiledImage::getTilePath(int level, int column, int row) const{
+	return ofFilePath::join(cacheDirectory, ofToString(level) + "_" + ofToString(column) + "_" + ofToString(row) + ".raw");
+}
+
+//----------------------------------------------------------
+bool ofTiledImage::getTilePixels(int level, int column, int row, ofPixels & pixels) const{
+	if(level < 0 || level >= numLevels || column < 0 || column >= getNumTileColumns(level) || row < 0 || row >= getNumTileRows(level)){
+		return false;
+	}
+	int tileWidth = MIN(tileSize, getLevelWidth(level) - column * tileSize);
+	int tileHeight = MIN(tileSize, getLevelHeight(level) - row * tileSize);
+
+	ofMappedFile mapped(getTilePath(level, column, row));
+	if(!mapped.isOpen() || mapped.size() != (long)tileWidth * tileHeight * channels){
+		ofLogError("ofTiledImage") << "getTilePixels(): tile " << level << " " << column << " " << row << " missing from the cache";
+		return false;
+	}
+	pixels.setFromPixels((const unsigned char*)mapped.getData(), tileWidth, tileHeight, channels);
+	return true;
+}
+
+//----------------------------------------------------------
+ofTexture & ofTiledImage::getTile(int level, int column, int row){
+	unsigned long long key = getTileKey(level, column, row);
+	std::map<unsigned long long, Tile>::iterator it = tiles.find(key);
+	if(it == tiles.end()){
+		it = tiles.insert(std::make_pair(key, Tile())).first;
+
+		// upload straight from the mapped file
+		int tileWidth = MIN(tileSize, getLevelWidth(level) - column * tileSize);
+		int tileHeight = MIN(tileSize, getLevelHeight(level) - row * tileSize);
+		ofMappedFile mapped(getTilePath(level, column, row));
+		if(mapped.isOpen() && mapped.size() == (long)tileWidth * tileHeight * channels){
+			ofPixelsView pixels((unsigned char*)mapped.getData(), tileWidth, tileHeight, channels);
+			it->second.texture.allocate(tileWidth, tileHeight, ofGetGlFormat(pixels));
+			it->second.texture.loadData(pixels);
+		}else{
+			ofLogError("ofTiledImage") << "draw(): tile " << level << " " << column << " " << row << " missing from the cache";
+		}
+	}
+	it->second.lastUsed = drawCount;
+	return it->second.texture;
+}
+
+//----------------------------------------------------------
+void ofTiledImage::releaseTiles(){
+	while((int)tiles.size() > maxResidentTiles){
+		std::map<unsigned long long, Tile>::iterator oldest = tiles.begin();
+		for(std::map<unsigned long long, Tile>::iterator it = tiles.begin(); it != tiles.end(); it++){
+			if(it->second.lastUsed < oldest->second.lastUsed){
+				oldest = it;
+			}
+		}
+		// the tiles drawn in the last call stay even if there's too many
+		if(oldest->second.lastUsed == drawCount){
+			break;
+		}
+		tiles.erase(oldest);
+	}
+}
+
+//----------------------------------------------------------
+void ofTiledImage::draw(float x, float y){
+	draw(x, y, width, height);
+}
+
+//----------------------------------------------------------
+void ofTiledImage::draw(float x, float y, float w, float h){
+	drawSubsection(x, y, w, h, 0, 0, width, height);
+}
+
+//----------------------------------------------------------
+void ofTiledImage::drawSubsection(float x, float y, float w, float h, float sx, float sy, float sw, float sh){
+	if(!bLoaded || w <= 0 || h <= 0 || sw <= 0 || sh <= 0){
+		return;
+	}
+	drawCount++;
+
+	// the level with about one texel per drawn pixel
+	float reduction = MIN(sw / w, sh / h);
+	int level = 0;
+	while(level + 1 < numLevels && reduction >= (1 << (level + 1))){
+		level++;
+	}
+
+	// the region in level coordinates
+	float levelScale = 1.f / (1 << level);
+	ofRectangle region(sx * levelScale, sy * levelScale, sw * levelScale, sh * levelScale);
+	float scaleX = w / region.width;
+	float scaleY = h / region.height;
+
+	int firstColumn = MAX(0, floor(region.x / tileSize));
+	int lastColumn = MIN(getNumTileColumns(level) - 1, floor(region.getRight() / tileSize));
+	int firstRow = MAX(0, floor(region.y / tileSize));
+	int lastRow = MIN(getNumTileRows(level) - 1, floor(region.getBottom() / tileSize));
+
+	for(int row = firstRow; row <= lastRow; row++){
+		for(int column = firstColumn; column <= lastColumn; column++){
+			ofRectangle tileRect(column * tileSize, row * tileSize,
+				MIN(tileSize, getLevelWidth(level) - column * tileSize),
+				MIN(tileSize, getLevelHeight(level) - row * tileSize));
+			ofRectangle visible = tileRect.getIntersection(region);
+			if(visible.isEmpty()){
+				continue;
+			}
+			ofTexture & texture = getTile(level, column, row);
+			if(!texture.isAllocated()){
+				continue;
+			}
+			texture.drawSubsection(x + (visible.x - region.x) * scaleX, y + (visible.y - region.y) * scaleY,
+				visible.width * scaleX, visible.height * scaleY,
+				visible.x - tileRect.x, visible.y - tileRect.y, visible.width, visible.height);
+		}
+	}
+
+	releaseTiles();
+}
+
+//----------------------------------------------------------
+void ofTiledImage::setMaxResidentTiles(int maxTiles){
+	maxResidentTiles = MAX(1, maxTiles);
+	releaseTiles();
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getMaxResidentTiles() const{
+	return maxResidentTiles;
+}
+
+//----------------------------------------------------------
+int ofTiledImage::getNumResidentTiles() const{
+	return tiles.size();
+}
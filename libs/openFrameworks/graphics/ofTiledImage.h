@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ofImage.h"
+#include <map>
+
+// draws images too big to keep in memory. the first time an image is loaded
+// it's cut in tiles at full size and at every half size down to one tile,
+// and those are written to a cache directory next to it. after that only the
+// tiles needed to draw the requested region at the drawn scale are read from
+// the cache and kept as textures, the least recently drawn ones are released
+// when there's more than setMaxResidentTiles of them.
+//
+// building the cache decodes the image once at full size, loading it again
+// while the cache is up to date doesn't decode it at all
+class ofTiledImage{
+public:
+	ofTiledImage();
+
+	// cacheDirectory defaults to the image path with .tiles appended
+	bool load(string path, int tileSize = 512, string cacheDirectory = "");
+	void clear();
+	bool isLoaded() const;
+
+	int getWidth() const;
+	int getHeight() const;
+	int getNumChannels() const;
+	int getTileSize() const;
+	int getNumLevels() const;
+
+	// size of the image at a level, every level is half the previous one
+	int getLevelWidth(int level) const;
+	int getLevelHeight(int level) const;
+	int getNumTileColumns(int level) const;
+	int getNumTileRows(int level) const;
+
+	// reads a tile from the cache
+	bool getTilePixels(int level, int column, int row, ofPixels & pixels) const;
+
+	void draw(float x, float y);
+	void draw(float x, float y, float w, float h);
+	// draws the region sx, sy, sw, sh in full size image coordinates
+	void drawSubsection(float x, float y, float w, float h, float sx, float sy, float sw, float sh);
+
+	void setMaxResidentTiles(int maxTiles);
+	int getMaxResidentTiles() const;
+	int getNumResidentTiles() const;
+
+private:
+	struct Tile{
+		ofTexture texture;
+		unsigned long lastUsed;
+	};
+
+	bool isCacheValid(const string & infoPath, const string & sourceInfo);
+	bool buildCache(const string & path, const string & infoPath, const string & sourceInfo);
+	string getTilePath(int level, int column, int row) const;
+	ofTexture & getTile(int level, int column, int row);
+	void releaseTiles();
+
+	string cacheDirectory;
+	int width, height, channels, tileSize, numLevels;
+	bool bLoaded;
+
+	std::map<unsigned long long, Tile> tiles;
+	int maxResidentTiles;
+	unsigned long drawCount;
+};
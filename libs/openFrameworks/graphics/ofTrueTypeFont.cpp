@@ -17,10 +17,12 @@
 #endif
 
 #include <algorithm>
+#include <map>
 
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
+#include "ofGLProgrammableRenderer.h"
 #include "Poco/TextConverter.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
@@ -30,6 +32,20 @@ static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
 static FT_Library library;
+static unsigned int fontGenerations = 0;
+
+// size in pixels of the em the distance fields are generated at and how far
+// from the outline they reach
+static const int distanceFieldSize = 64;
+static const int distanceFieldSpread = 8;
+
+// the face and the distance fields shared by every size of a file
+struct ofTrueTypeFont::DistanceField{
+	ofPtr<FT_FaceRec_> face;
+	ofPtr<ofGlyphAtlas> atlas;
+	// where any of the sizes added each glyph, props aren't used
+	std::unordered_map<unsigned int,Glyph> glyphs;
+};
 
 //--------------------------------------------------------
 void ofTrueTypeFont::setGlobalDpi(int newDpi){
@@ -201,6 +217,188 @@ bool compare_cps(const charProps & c1, const charProps & c2){
 	else return c1.tH > c2.tH;
 }
 
+//--------------------------------------------------------
+static void setCharProps(charProps & props, FT_GlyphSlot glyph, int character, int fontSize){
+	props.character		= character;
+	props.height 		= glyph->bitmap_top;
+	props.width 		= glyph->bitmap.width;
+	props.setWidth 		= glyph->advance.x >> 6;
+	props.topExtent 	= glyph->bitmap.rows;
+	props.leftExtent	= glyph->bitmap_left;
+
+	props.tW			= props.width;
+	props.tH			= glyph->bitmap.rows;
+
+	GLint fheight	= props.height;
+	GLint bwidth	= props.width;
+	GLint top		= props.topExtent - props.height;
+	GLint lextent	= props.leftExtent;
+
+	GLfloat	corr, stretch;
+
+	//this accounts for the fact that we are showing 2*visibleBorder extra pixels
+	//so we make the size of each char that many pixels bigger
+	stretch = 0;//(float)(visibleBorder * 2);
+
+	corr	= (float)(( (fontSize - fheight) + top) - fontSize);
+
+	props.x1		= lextent + bwidth + stretch;
+	props.y1		= fheight + corr + stretch;
+	props.x2		= (float) lextent;
+	props.y2		= -top + corr;
+}
+
+//--------------------------------------------------------
+// white pixels with the coverage of the glyph in the last channel, luminance
+// alpha or rgba
+static void bitmapToPixels(const FT_Bitmap & bitmap, bool bAntiAliased, int channels, ofPixels & pixels){
+	pixels.allocate(bitmap.width, bitmap.rows, channels);
+	pixels.set(255);
+	for(int j=0; j <(int)bitmap.rows;j++) {
+		const unsigned char * src = bitmap.buffer + j*bitmap.pitch;
+		unsigned char * dst = pixels.getPixels() + j*bitmap.width*channels + channels-1;
+		for(int k=0; k < (int)bitmap.width ; k++){
+			if (bAntiAliased == true){
+				dst[k*channels] = src[k];
+			}else{
+				// true type packs monochrome info in a
+				// 1-bit format, hella funky
+				dst[k*channels] = (src[k/8] << (k%8)) & 0x80 ? 255 : 0;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------
+static int scaleMetric(float metric, float scale){
+	return floor(metric * scale + 0.5f);
+}
+
+//--------------------------------------------------------
+// the metrics of a glyph loaded at distanceFieldSize scaled to the font
+// size, the quad and texture size include the spread around the bitmap
+static void setDistanceFieldProps(charProps & props, FT_GlyphSlot glyph, int character, float scale){
+	int spread = distanceFieldSpread;
+	props.character		= character;
+	props.height 		= scaleMetric(glyph->bitmap_top, scale);
+	props.width 		= scaleMetric(glyph->bitmap.width, scale);
+	props.setWidth 		= scaleMetric(glyph->advance.x / 64.f, scale);
+	props.topExtent 	= scaleMetric(glyph->bitmap.rows, scale);
+	props.leftExtent	= scaleMetric(glyph->bitmap_left, scale);
+
+	if(glyph->bitmap.width == 0 || glyph->bitmap.rows == 0){
+		props.tW = props.tH = 0;
+	}else{
+		props.tW = glyph->bitmap.width + spread*2;
+		props.tH = glyph->bitmap.rows + spread*2;
+	}
+
+	props.x1 = (glyph->bitmap_left + (int)glyph->bitmap.width + spread) * scale;
+	props.y1 = ((int)glyph->bitmap.rows - glyph->bitmap_top + spread) * scale;
+	props.x2 = (glyph->bitmap_left - spread) * scale;
+	props.y2 = (-glyph->bitmap_top - spread) * scale;
+}
+
+//--------------------------------------------------------
+// signed distance to the outline of the glyph loaded last, for every pixel
+// of its bitmap and distanceFieldSpread around it. it goes in the alpha of
+// white pixels, 0.5 on the outline and growing towards the inside
+static void makeDistanceField(FT_Face & face, ofPixels & pixels){
+	FT_GlyphSlot glyph = face->glyph;
+	int spread = distanceFieldSpread;
+	int width = glyph->bitmap.width + spread*2;
+	int height = glyph->bitmap.rows + spread*2;
+	pixels.allocate(width, height, 4);
+	pixels.set(255);
+
+	ofTTFCharacter contours = makeContoursForCharacter(face);
+	const vector<ofPolyline> & outlines = contours.getOutline();
+	vector<ofVec2f> starts, deltas;
+	vector<float> lengths;
+	for(int i=0;i<(int)outlines.size();i++){
+		const vector<ofPoint> & vertices = outlines[i].getVertices();
+		for(int j=0;j<(int)vertices.size();j++){
+			const ofPoint & next = vertices[(j+1)%vertices.size()];
+			starts.push_back(ofVec2f(vertices[j].x,vertices[j].y));
+			deltas.push_back(ofVec2f(next.x-vertices[j].x,next.y-vertices[j].y));
+			lengths.push_back(deltas.back().lengthSquared());
+		}
+	}
+
+	// the contours have y going down from the baseline
+	float left = glyph->bitmap_left - spread + 0.5f;
+	float top = -glyph->bitmap_top - spread + 0.5f;
+	unsigned char * alpha = pixels.getPixels() + 3;
+	for(int y=0;y<height;y++){
+		for(int x=0;x<width;x++){
+			ofVec2f p(left + x, top + y);
+			float minDistance = spread*spread;
+			int winding = 0;
+			for(int i=0;i<(int)starts.size();i++){
+				ofVec2f ap = p - starts[i];
+				const ofVec2f & ab = deltas[i];
+				float t = lengths[i] > 0 ? ofClamp(ap.dot(ab) / lengths[i], 0, 1) : 0;
+				minDistance = std::min(minDistance, (ap - ab*t).lengthSquared());
+
+				// nonzero rule, as truetype, with a ray towards +x
+				float cross = ab.x*ap.y - ab.y*ap.x;
+				if(ap.y >= 0){
+					if(ap.y < ab.y && cross > 0) winding++;
+				}else{
+					if(ap.y >= ab.y && cross < 0) winding--;
+				}
+			}
+			float distance = sqrt(minDistance);
+			if(winding == 0) distance = -distance;
+			alpha[(y*width+x)*4] = ofClamp(0.5f + distance / (spread*2), 0, 1) * 255 + 0.5f;
+		}
+	}
+}
+
+//--------------------------------------------------------
+// decodes the utf8 character at index and moves index past it, an invalid
+// sequence decodes to U+FFFD and skips only its first byte
+static unsigned int decodeUTF8(const string & s, int & index){
+	unsigned char c = s[index++];
+	if(c < 0x80) return c;
+
+	int extra;
+	unsigned int codepoint, minimum;
+	if((c & 0xE0) == 0xC0){
+		extra = 1;
+		codepoint = c & 0x1F;
+		minimum = 0x80;
+	}else if((c & 0xF0) == 0xE0){
+		extra = 2;
+		codepoint = c & 0x0F;
+		minimum = 0x800;
+	}else if((c & 0xF8) == 0xF0){
+		extra = 3;
+		codepoint = c & 0x07;
+		minimum = 0x10000;
+	}else{
+		return 0xFFFD;
+	}
+	if(index + extra > (int)s.size()) return 0xFFFD;
+	for(int i=0;i<extra;i++){
+		unsigned char next = s[index+i];
+		if((next & 0xC0) != 0x80) return 0xFFFD;
+		codepoint = (codepoint << 6) | (next & 0x3F);
+	}
+	// overlong, surrogates and out of range
+	if(codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) return 0xFFFD;
+	index += extra;
+	return codepoint;
+}
+
+//--------------------------------------------------------
+static void doneFace(FT_Face face){
+	// FT_Done_FreeType already released the faces at exit
+	if(librariesInitialized){
+		FT_Done_Face(face);
+	}
+}
+
 
 #ifdef TARGET_OSX
 static string osxFontPathByName( string fontname ){
@@ -367,6 +565,7 @@ void ofTrueTypeFont::finishLibraries(){
 		//FcFini();
 #endif
 		FT_Done_FreeType(library);
+		librariesInitialized = false;
 	}
 }
 
@@ -375,6 +574,13 @@ void ofTrueTypeFont::finishLibraries(){
 ofTrueTypeFont::ofTrueTypeFont(){
 	bLoadedOk		= false;
 	bMakeContours	= false;
+	bDynamic		= false;
+	bDistanceField	= false;
+	distanceFieldScale = 1;
+	encoding		= OF_ENCODING_UTF8;
+	generation		= 0;
+	atlasGeneration	= 0;
+	maxCachedStrings = 1024;
 	#if defined(TARGET_ANDROID) || defined(TARGET_OF_IOS)
 		all_fonts().insert(this);
 	#endif
@@ -408,11 +614,25 @@ void ofTrueTypeFont::unloadTextures(){
 	if(!bLoadedOk) return;
 
 	texAtlas.clear();
+	stringCache.clear();
+	if(bDynamic){
+		glyphs.clear();
+		pageQuads.clear();
+		atlas.reset();
+		face.reset();
+		distanceField.reset();
+	}
 	bLoadedOk = false;
 }
 
 void ofTrueTypeFont::reloadTextures(){
-	loadFont(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	if(bDistanceField){
+		loadDistanceFieldFont(filename, fontSize, bMakeContours, simplifyAmt, dpi);
+	}else if(bDynamic){
+		loadDynamicFont(filename, fontSize, bAntiAliased, bMakeContours, simplifyAmt, dpi);
+	}else{
+		loadFont(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	}
 }
 
 static bool loadFontFace(string fontname, int _fontSize, FT_Face & face, string & filename){
@@ -481,6 +701,9 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 
 
 	bLoadedOk 			= false;
+	updateGeneration();
+	bDynamic			= false;
+	bDistanceField		= false;
 	bAntiAliased 		= _bAntiAliased;
 	bFullCharacterSet 	= _bFullCharacterSet;
 	fontSize			= _fontSize;
@@ -569,89 +792,26 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 
 			if(simplifyAmt>0)
 				charOutlines[i].simplify(simplifyAmt);
-			charOutlines[i].getTessellation();
 
 			if(simplifyAmt>0)
 				charOutlinesNonVFlipped[i].simplify(simplifyAmt);
-			charOutlinesNonVFlipped[i].getTessellation();
 		}
 
 
 		// -------------------------
 		// info about the character:
-		cps[i].character		= i;
-		cps[i].height 			= face->glyph->bitmap_top;
-		cps[i].width 			= face->glyph->bitmap.width;
-		cps[i].setWidth 		= face->glyph->advance.x >> 6;
-		cps[i].topExtent 		= face->glyph->bitmap.rows;
-		cps[i].leftExtent		= face->glyph->bitmap_left;
-
-		int width  = cps[i].width;
-		int height = bitmap.rows;
-
-
-		cps[i].tW				= width;
-		cps[i].tH				= height;
-
-
+		setCharProps(cps[i], face->glyph, i, fontSize);
 
-		GLint fheight	= cps[i].height;
-		GLint bwidth	= cps[i].width;
-		GLint top		= cps[i].topExtent - cps[i].height;
-		GLint lextent	= cps[i].leftExtent;
-
-		GLfloat	corr, stretch;
-
-		//this accounts for the fact that we are showing 2*visibleBorder extra pixels
-		//so we make the size of each char that many pixels bigger
-		stretch = 0;//(float)(visibleBorder * 2);
-
-		corr	= (float)(( (fontSize - fheight) + top) - fontSize);
-
-		cps[i].x1		= lextent + bwidth + stretch;
-		cps[i].y1		= fheight + corr + stretch;
-		cps[i].x2		= (float) lextent;
-		cps[i].y2		= -top + corr;
-
-
-		// Allocate Memory For The Texture Data.
-		expanded_data[i].allocate(width, height, 2);
-		//-------------------------------- clear data:
-		expanded_data[i].set(0,255); // every luminance pixel = 255
-		expanded_data[i].set(1,0);
-
-
-		if (bAntiAliased == true){
-			ofPixels bitmapPixels;
-			bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,1);
-			expanded_data[i].setChannel(1,bitmapPixels);
-		} else {
-			//-----------------------------------
-			// true type packs monochrome info in a
-			// 1-bit format, hella funky
-			// here we unpack it:
-			unsigned char *src =  bitmap.buffer;
-			for(int j=0; j <bitmap.rows;j++) {
-				unsigned char b=0;
-				unsigned char *bptr =  src;
-				for(int k=0; k < bitmap.width ; k++){
-					expanded_data[i][2*(k+j*width)] = 255;
-
-					if (k%8==0){
-						b = (*bptr++);
-					}
-
-					expanded_data[i][2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
-					b <<= 1;
-				}
-				src += bitmap.pitch;
-			}
-			//-----------------------------------
-		}
+		bitmapToPixels(bitmap, bAntiAliased, 2, expanded_data[i]);
 
 		areaSum += (cps[i].width+border*2)*(cps[i].height+border*2);
 	}
 
+	if(bMakeContours){
+		ofPath::tessellate(charOutlines);
+		ofPath::tessellate(charOutlinesNonVFlipped);
+	}
+
 	vector<charProps> sortedCopy = cps;
 	sort(sortedCopy.begin(),sortedCopy.end(),&compare_cps);
 
@@ -736,12 +896,253 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 	return true;
 }
 
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadDynamicFont(string _filename, int _fontSize, bool _bAntiAliased, bool _makeContours, float _simplifyAmt, int _dpi) {
+
+	initLibraries();
+
+	if (bLoadedOk == true){
+		unloadTextures();
+	}
+
+	if( _dpi == 0 ){
+		_dpi = ttfGlobalDpi;
+	}
+
+	bLoadedOk 			= false;
+	updateGeneration();
+	bDynamic			= false;
+	bDistanceField		= false;
+	bAntiAliased 		= _bAntiAliased;
+	bFullCharacterSet 	= true;
+	fontSize			= _fontSize;
+	bMakeContours 		= _makeContours;
+	simplifyAmt			= _simplifyAmt;
+	dpi 				= _dpi;
+	nCharacters			= 0;
+	cps.clear();
+	charOutlines.clear();
+	charOutlinesNonVFlipped.clear();
+	glyphs.clear();
+	pageQuads.clear();
+
+	// the face stays open to rasterize the glyphs as they're needed
+	FT_Face ftFace;
+	if(!loadFontFace(_filename,_fontSize,ftFace,filename)){
+		return false;
+	}
+	// only set once there's a face and an atlas behind them
+	bDynamic = true;
+	FT_Set_Char_Size( ftFace, fontSize << 6, fontSize << 6, dpi, dpi);
+	face = ofPtr<FT_FaceRec_>(ftFace,doneFace);
+	lineHeight = fontSize * 1.43f;
+
+	atlas = ofPtr<ofGlyphAtlas>(new ofGlyphAtlas);
+	if(bAntiAliased && fontSize>20){
+		atlas->setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+	}else{
+		atlas->setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	}
+
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadDistanceFieldFont(string _filename, int _fontSize, bool _makeContours, float _simplifyAmt, int _dpi) {
+
+	initLibraries();
+
+	if (bLoadedOk == true){
+		unloadTextures();
+	}
+
+	if( _dpi == 0 ){
+		_dpi = ttfGlobalDpi;
+	}
+
+	bLoadedOk 			= false;
+	updateGeneration();
+	bDynamic			= false;
+	bDistanceField		= false;
+	bAntiAliased 		= true;
+	bFullCharacterSet 	= true;
+	fontSize			= _fontSize;
+	bMakeContours 		= _makeContours;
+	simplifyAmt			= _simplifyAmt;
+	dpi 				= _dpi;
+	nCharacters			= 0;
+	cps.clear();
+	charOutlines.clear();
+	charOutlinesNonVFlipped.clear();
+	glyphs.clear();
+	pageQuads.clear();
+
+	FT_Face ftFace;
+	if(!loadFontFace(_filename,_fontSize,ftFace,filename)){
+		return false;
+	}
+	bDynamic = true;
+	bDistanceField = true;
+
+	static std::map<string, std::weak_ptr<DistanceField> > distanceFields;
+	distanceField = distanceFields[filename].lock();
+	if(distanceField){
+		FT_Done_Face(ftFace);
+	}else{
+		FT_Set_Char_Size( ftFace, distanceFieldSize << 6, distanceFieldSize << 6, 72, 72);
+		distanceField = ofPtr<DistanceField>(new DistanceField);
+		distanceField->face = ofPtr<FT_FaceRec_>(ftFace,doneFace);
+		distanceField->atlas = ofPtr<ofGlyphAtlas>(new ofGlyphAtlas);
+		distanceField->atlas->setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+		distanceFields[filename] = distanceField;
+	}
+	face = distanceField->face;
+	atlas = distanceField->atlas;
+	distanceFieldScale = fontSize * dpi / (72.f * distanceFieldSize);
+	lineHeight = fontSize * 1.43f;
+
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+unsigned int ofTrueTypeFont::nextCharacter(const string & s, int & index){
+	if(bDynamic && encoding==OF_ENCODING_UTF8){
+		return decodeUTF8(s,index);
+	}
+	unsigned int c = (unsigned char)s[index++];
+	if(bDynamic && c == 0xA4) c = 0x20AC; // the euro sign in 8859-15, as loadFont does
+	return c;
+}
+
+//-----------------------------------------------------------
+const charProps * ofTrueTypeFont::getCharProps(unsigned int c){
+	if(bDynamic){
+		Glyph * glyph = getGlyph(c);
+		return glyph ? &glyph->props : NULL;
+	}
+	int cy = (int)c - NUM_CHARACTER_TO_START;
+	if(cy < 0 || cy >= nCharacters) return NULL;
+	return &cps[cy];
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::Glyph * ofTrueTypeFont::getGlyph(unsigned int c){
+	if(c < NUM_CHARACTER_TO_START || !face) return NULL;
+	std::unordered_map<unsigned int,Glyph>::iterator it = glyphs.find(c);
+	if(it != glyphs.end()) return &it->second;
+
+	Glyph & glyph = glyphs[c];
+	glyph.page = -1;
+	glyph.epoch = 0;
+	memset(&glyph.props,0,sizeof(charProps));
+	glyph.props.character = c;
+	if(!renderGlyph(c)) return &glyph;
+
+	FT_Face ftFace = face.get();
+	if(bDistanceField){
+		setDistanceFieldProps(glyph.props, ftFace->glyph, c, distanceFieldScale);
+	}else{
+		setCharProps(glyph.props, ftFace->glyph, c, fontSize);
+	}
+	if(bMakeContours){
+		glyph.contour = makeContoursForCharacter(ftFace);
+		if(bDistanceField){
+			glyph.contour.scale(distanceFieldScale,distanceFieldScale);
+		}
+		glyph.contourNonVFlipped = glyph.contour;
+		glyph.contourNonVFlipped.translate(ofVec3f(0,glyph.props.height));
+		glyph.contourNonVFlipped.scale(1,-1);
+		if(simplifyAmt>0){
+			glyph.contour.simplify(simplifyAmt);
+			glyph.contourNonVFlipped.simplify(simplifyAmt);
+		}
+	}
+	packGlyph(glyph);
+	return &glyph;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::renderGlyph(unsigned int c){
+	FT_Face ftFace = face.get();
+	FT_Error err = FT_Load_Glyph( ftFace, FT_Get_Char_Index( ftFace, c ), FT_LOAD_DEFAULT );
+	if(err){
+		ofLogError("ofTrueTypeFont") << "renderGlyph(): FT_Load_Glyph failed for char " << c << ": FT_Error " << err;
+		return false;
+	}
+	if (bAntiAliased == true) FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_NORMAL);
+	else FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_MONO);
+	return true;
+}
+
+//-----------------------------------------------------------
+// copies the bitmap rendered last to the atlas
+void ofTrueTypeFont::packGlyph(Glyph & glyph){
+	if(bDistanceField){
+		packDistanceField(glyph);
+		return;
+	}
+	glyph.page = -1;
+	const FT_Bitmap & bitmap = face->glyph->bitmap;
+	if(bitmap.width == 0 || bitmap.rows == 0) return;
+
+	int x, y;
+	if(!atlas->add(bitmap.width + border*2, bitmap.rows + border*2, glyph.page, x, y)){
+		glyph.page = -1;
+		return;
+	}
+	ofPixels pixels;
+	bitmapToPixels(bitmap, bAntiAliased, 4, pixels);
+	atlas->setPixels(glyph.page, x + border, y + border, pixels);
+	glyph.x = x + border;
+	glyph.y = y + border;
+	glyph.epoch = atlas->getPageEpoch(glyph.page);
+}
+
+//-----------------------------------------------------------
+// generates the distance field of the glyph loaded last, unless another size
+// of the font already added it to the shared atlas
+void ofTrueTypeFont::packDistanceField(Glyph & glyph){
+	glyph.page = -1;
+	FT_Face ftFace = face.get();
+	if(ftFace->glyph->bitmap.width == 0 || ftFace->glyph->bitmap.rows == 0) return;
+
+	std::unordered_map<unsigned int,Glyph>::iterator it = distanceField->glyphs.find(glyph.props.character);
+	if(it != distanceField->glyphs.end() && atlas->getPageEpoch(it->second.page) == it->second.epoch){
+		glyph.page = it->second.page;
+		glyph.x = it->second.x;
+		glyph.y = it->second.y;
+		glyph.epoch = it->second.epoch;
+		return;
+	}
+
+	ofPixels pixels;
+	makeDistanceField(ftFace, pixels);
+	int x, y;
+	if(!atlas->add(pixels.getWidth(), pixels.getHeight(), glyph.page, x, y)){
+		glyph.page = -1;
+		return;
+	}
+	atlas->setPixels(glyph.page, x, y, pixels);
+	glyph.x = x;
+	glyph.y = y;
+	glyph.epoch = atlas->getPageEpoch(glyph.page);
+
+	Glyph & shared = distanceField->glyphs[glyph.props.character];
+	shared.page = glyph.page;
+	shared.x = glyph.x;
+	shared.y = glyph.y;
+	shared.epoch = glyph.epoch;
+}
+
 ofTextEncoding ofTrueTypeFont::getEncoding() const {
 	return encoding;
 }
 
 void ofTrueTypeFont::setEncoding(ofTextEncoding _encoding) {
 	encoding = _encoding;
+	updateGeneration();
 }
 
 //-----------------------------------------------------------
@@ -749,6 +1150,16 @@ bool ofTrueTypeFont::isLoaded() {
 	return bLoadedOk;
 }
 
+//-----------------------------------------------------------
+bool ofTrueTypeFont::isDynamic() {
+	return bDynamic;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::isDistanceField() {
+	return bDistanceField;
+}
+
 //-----------------------------------------------------------
 bool ofTrueTypeFont::isAntiAliased() {
 	return bAntiAliased;
@@ -767,6 +1178,7 @@ int ofTrueTypeFont::getSize() {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	updateGeneration();
 }
 
 //-----------------------------------------------------------
@@ -777,6 +1189,7 @@ float ofTrueTypeFont::getLineHeight(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	updateGeneration();
 }
 
 //-----------------------------------------------------------
@@ -787,6 +1200,7 @@ float ofTrueTypeFont::getLetterSpacing(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	updateGeneration();
 }
 
 //-----------------------------------------------------------
@@ -800,6 +1214,11 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(int character, bool vflip){
 		ofLogError("ofxTrueTypeFont") << "getCharacterAsPoints(): contours not created, call loadFont() with makeContours set to true";
 		return ofTTFCharacter();
 	}
+	if(bDynamic){
+		Glyph * glyph = getGlyph(character);
+		if(!glyph) return ofTTFCharacter();
+		return vflip ? glyph->contour : glyph->contourNonVFlipped;
+	}
     if (character - NUM_CHARACTER_TO_START >= nCharacters || character < NUM_CHARACTER_TO_START){
         ofLogError("ofxTrueTypeFont") << "getCharacterAsPoint(): char " << character + NUM_CHARACTER_TO_START
 		<< " not allocated: line " << __LINE__ << " in " << __FILE__;
@@ -862,9 +1281,85 @@ void ofTrueTypeFont::drawChar(int c, float x, float y) {
 	stringQuads.addIndex(firstIndex);
 }
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawGlyph(Glyph & glyph, float x, float y) {
+	const charProps & props = glyph.props;
+	if(props.tW == 0 || props.tH == 0) return;
+	if(atlas->getPageEpoch(glyph.page) != glyph.epoch || glyph.page < 0){
+		// the page was cleared since
+		if(!renderGlyph(props.character)) return;
+		packGlyph(glyph);
+		if(glyph.page < 0) return;
+	}
+	atlas->touch(glyph.page);
+
+	if((int)pageQuads.size() <= glyph.page){
+		pageQuads.resize(glyph.page+1);
+	}
+	ofMesh & quads = pageQuads[glyph.page];
+	quads.setMode(OF_PRIMITIVE_TRIANGLES);
+
+	float x1 = props.x1 + x;
+	float y1 = props.y1;
+	float x2 = props.x2 + x;
+	float y2 = props.y2;
+	if(!ofIsVFlipped()){
+		y1 *= -1;
+		y2 *= -1;
+	}
+	y1 += y;
+	y2 += y;
+
+	float t1 = glyph.x + props.tW;
+	float v1 = glyph.y + props.tH;
+	float t2 = glyph.x;
+	float v2 = glyph.y;
+
+	int firstIndex = quads.getNumVertices();
+	quads.addVertex(ofVec3f(x1,y1));
+	quads.addVertex(ofVec3f(x2,y1));
+	quads.addVertex(ofVec3f(x2,y2));
+	quads.addVertex(ofVec3f(x1,y2));
+
+	quads.addTexCoord(ofVec2f(t1,v1));
+	quads.addTexCoord(ofVec2f(t2,v1));
+	quads.addTexCoord(ofVec2f(t2,v2));
+	quads.addTexCoord(ofVec2f(t1,v2));
+
+	quads.addIndex(firstIndex);
+	quads.addIndex(firstIndex+1);
+	quads.addIndex(firstIndex+2);
+	quads.addIndex(firstIndex+2);
+	quads.addIndex(firstIndex+3);
+	quads.addIndex(firstIndex);
+}
+
+//-----------------------------------------------------------
+// draws the quads of each page with its texture, by now every page used
+// in the batch has its final size
+void ofTrueTypeFont::drawPageQuads(){
+	for(int i=0;i<(int)pageQuads.size();i++){
+		ofMesh & quads = pageQuads[i];
+		if(quads.getNumVertices() == 0 || !atlas || i >= atlas->getNumPages()){
+			quads.clear();
+			continue;
+		}
+		float size = atlas->getPageSize(i);
+		vector<ofVec2f> & texCoords = quads.getTexCoords();
+		for(int j=0;j<(int)texCoords.size();j++){
+			texCoords[j] /= size;
+		}
+		ofTexture & texture = atlas->getTexture(i);
+		texture.bind();
+		quads.drawFaces();
+		texture.unbind();
+		quads.clear();
+	}
+}
+
 //-----------------------------------------------------------
 vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip){
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+	if(!bDynamic && bFullCharacterSet && encoding==OF_ENCODING_UTF8){
 		string o;
 		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(str,o);
 		str=o;
@@ -893,22 +1388,22 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip)
 	int len = (int)str.length();
 
 	while(index < len){
-		int cy = (unsigned char)str[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-			if (str[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = 0 ; //reset X Pos back to zero
-			}else if (str[index] == ' ') {
-				int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				X += cps[cy].setWidth * letterSpacing * spaceSize;
-			} else if(cy > -1){
-				shapes.push_back(getCharacterAsPoints((unsigned char)str[index],vflip));
+		unsigned int c = nextCharacter(str,index);
+		if (c == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = 0 ; //reset X Pos back to zero
+		}else if (c == ' ') {
+			const charProps * space = getCharProps('p');
+			if(space) X += space->setWidth * letterSpacing * spaceSize;
+		} else {
+			const charProps * props = getCharProps(c);
+			if(props){
+				shapes.push_back(getCharacterAsPoints(c,vflip));
 				shapes.back().translate(ofPoint(X,Y));
 
-				X += cps[cy].setWidth * letterSpacing;
+				X += props->setWidth * letterSpacing;
 			}
 		}
-		index++;
 	}
 	return shapes;
 
@@ -916,6 +1411,14 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip)
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawCharAsShape(int c, float x, float y) {
+	if(bDynamic){
+		Glyph * glyph = getGlyph(c);
+		if(!glyph) return;
+		ofTTFCharacter & charRef = ofIsVFlipped() ? glyph->contour : glyph->contourNonVFlipped;
+		charRef.setFilled(ofGetStyle().bFill);
+		charRef.draw(x,y);
+		return;
+	}
 	if (c - NUM_CHARACTER_TO_START >= nCharacters || c < NUM_CHARACTER_TO_START){
 		//ofLogError("ofTrueTypeFont") << "drawCharAsShape(): char " << << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
 		return;
@@ -958,7 +1461,7 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
     float       maxx    = -1;
     float       maxy    = -1;
 
-    if ( len < 1 || cps.empty() ){
+    if ( len < 1 || (!bDynamic && cps.empty()) ){
         myRect.x        = 0;
         myRect.y        = 0;
         myRect.width    = 0;
@@ -968,20 +1471,19 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
 
     bool bFirstCharacter = true;
 	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
- 	    if (cy < nCharacters){ 			// full char set or not?
-	       if (c[index] == '\n') {
+		unsigned int character = nextCharacter(c,index);
+	       if (character == '\n') {
 				yoffset += lineHeight;
 				xoffset = 0 ; //reset X Pos back to zero
-	      } else if (c[index] == ' ') {
-	     		int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 xoffset += cps[cy].setWidth * letterSpacing * spaceSize;
+	      } else if (character == ' ') {
+	     		const charProps * space = getCharProps('p');
+				 if(space) xoffset += space->setWidth * letterSpacing * spaceSize;
 				 // zach - this is a bug to fix -- for now, we don't currently deal with ' ' in calculating string bounding box
-		  } else if(cy > -1){
-                GLint height	= cps[cy].height;
-            	GLint bwidth	= cps[cy].width * letterSpacing;
-            	GLint top		= cps[cy].topExtent - cps[cy].height;
-            	GLint lextent	= cps[cy].leftExtent;
+		  } else if(const charProps * props = getCharProps(character)){
+                GLint height	= props->height;
+            	GLint bwidth	= props->width * letterSpacing;
+            	GLint top		= props->topExtent - props->height;
+            	GLint lextent	= props->leftExtent;
             	float	x1, y1, x2, y2, corr, stretch;
             	stretch = 0;//(float)visibleBorder * 2;
 				corr = (float)(((fontSize - height) + top) - fontSize);
@@ -989,7 +1491,7 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
             	y1		= (y + yoffset + height + corr + stretch);
             	x2		= (x + xoffset + lextent);
             	y2		= (y + yoffset + -top + corr);
-				xoffset += cps[cy].setWidth * letterSpacing;
+				xoffset += props->setWidth * letterSpacing;
 				if (bFirstCharacter == true){
                     minx = x2;
                     miny = y2;
@@ -1003,8 +1505,6 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
                     if (y1 > maxy) maxy = y1;
             }
 		  }
-	  	}
-    	index++;
     }
 
     myRect.x        = minx;
@@ -1036,35 +1536,166 @@ void ofTrueTypeFont::createStringMesh(string c, float x, float y){
 	int len = (int)c.length();
 
 	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-		  if (c[index] == '\n') {
+		unsigned int character = nextCharacter(c,index);
+		  if (character == '\n') {
 
 				Y += lineHeight*newLineDirection;
 				X = x ; //reset X Pos back to zero
 
-		  }else if (c[index] == ' ') {
-				 int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 X += cps[cy].setWidth * letterSpacing * spaceSize;
-		  } else if(cy > -1){
-				drawChar(cy, X, Y);
-				X += cps[cy].setWidth * letterSpacing;
+		  }else if (character == ' ') {
+				 const charProps * space = getCharProps('p');
+				 if(space) X += space->setWidth * letterSpacing * spaceSize;
+		  } else if(bDynamic){
+				Glyph * glyph = getGlyph(character);
+				if(glyph){
+					drawGlyph(*glyph, X, Y);
+					X += glyph->props.setWidth * letterSpacing;
+				}
+		  } else {
+				int cy = (int)character - NUM_CHARACTER_TO_START;
+				if(cy > -1 && cy < nCharacters){
+					drawChar(cy, X, Y);
+					X += cps[cy].setWidth * letterSpacing;
+				}
 		  }
-		}
-		index++;
 	}
 }
 
 ofMesh & ofTrueTypeFont::getStringMesh(string c, float x, float y){
 	stringQuads.clear();
 	createStringMesh(c,x,y);
+	if(bDynamic){
+		// only the glyphs in the first page, the one getFontTexture returns
+		if(!pageQuads.empty() && atlas && atlas->getNumPages() > 0){
+			stringQuads.append(pageQuads[0]);
+			float size = atlas->getPageSize(0);
+			vector<ofVec2f> & texCoords = stringQuads.getTexCoords();
+			for(int i=0;i<(int)texCoords.size();i++){
+				texCoords[i] /= size;
+			}
+		}
+		for(int i=0;i<(int)pageQuads.size();i++){
+			pageQuads[i].clear();
+		}
+	}
 	return stringQuads;
 }
 
 ofTexture & ofTrueTypeFont::getFontTexture(){
+	// unloading drops the atlas of a dynamic font
+	if(bDynamic && atlas && atlas->getNumPages() > 0){
+		return atlas->getTexture(0);
+	}
 	return texAtlas;
 }
 
+ofGlyphAtlas & ofTrueTypeFont::getGlyphAtlas(){
+	if(!atlas){
+		atlas = ofPtr<ofGlyphAtlas>(new ofGlyphAtlas);
+	}
+	return *atlas;
+}
+
+//-----------------------------------------------------------
+// unique for every font so a block can't mistake one for another
+void ofTrueTypeFont::updateGeneration(){
+	generation = ++fontGenerations;
+}
+
+//-----------------------------------------------------------
+unsigned int ofTrueTypeFont::getGeneration(){
+	if(atlas && atlas->getGeneration() != atlasGeneration){
+		atlasGeneration = atlas->getGeneration();
+		updateGeneration();
+	}
+	return generation;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::getStringMeshes(string c, vector<ofMesh> & meshes){
+	if(!bDynamic && bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+		string o;
+		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
+		c=o;
+	}
+
+	// the quads of a batch in progress stay out of it
+	ofMesh pendingQuads;
+	vector<ofMesh> pendingPageQuads;
+	if(binded){
+		pendingQuads = stringQuads;
+		pendingPageQuads.swap(pageQuads);
+	}
+
+	meshes.clear();
+	stringQuads.clear();
+	for(int i=0;i<(int)pageQuads.size();i++){
+		pageQuads[i].clear();
+	}
+	createStringMesh(c,0,0);
+	if(bDynamic){
+		meshes.resize(atlas ? std::min((int)pageQuads.size(),atlas->getNumPages()) : 0);
+		for(int i=0;i<(int)meshes.size();i++){
+			meshes[i] = pageQuads[i];
+			float size = atlas->getPageSize(i);
+			vector<ofVec2f> & texCoords = meshes[i].getTexCoords();
+			for(int j=0;j<(int)texCoords.size();j++){
+				texCoords[j] /= size;
+			}
+			pageQuads[i].clear();
+		}
+	}else{
+		meshes.push_back(stringQuads);
+		stringQuads.clear();
+	}
+
+	if(binded){
+		stringQuads = pendingQuads;
+		pageQuads.swap(pendingPageQuads);
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setStringCacheSize(int size){
+	maxCachedStrings = std::max(0,size);
+	releaseCachedStrings();
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getStringCacheSize(){
+	return maxCachedStrings;
+}
+
+//-----------------------------------------------------------
+// the first time a string is drawn it's only remembered, strings that
+// change every frame would build a vbo each time otherwise
+bool ofTrueTypeFont::drawCachedString(const string & s, float x, float y){
+	std::unordered_map<string,std::list<CachedString>::iterator>::iterator it = stringCache.index.find(s);
+	if(it == stringCache.index.end()){
+		stringCache.strings.push_front(CachedString());
+		stringCache.strings.front().text = s;
+		stringCache.index[s] = stringCache.strings.begin();
+		releaseCachedStrings();
+		return false;
+	}
+	stringCache.strings.splice(stringCache.strings.begin(), stringCache.strings, it->second);
+	ofTextBlock & block = it->second->block;
+	// the second time it's drawn
+	if(block.getFont() != this){
+		block.setup(*this,s);
+	}
+	block.draw(x,y);
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::releaseCachedStrings(){
+	while((int)stringCache.index.size() > maxCachedStrings){
+		stringCache.index.erase(stringCache.strings.back().text);
+		stringCache.strings.pop_back();
+	}
+}
+
 //=====================================================================
 void ofTrueTypeFont::drawString(string c, float x, float y) {
 	
@@ -1072,16 +1703,20 @@ void ofTrueTypeFont::drawString(string c, float x, float y) {
 	 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	 texAtlas.draw(0,0);*/
 	
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
-	}
-	
 	if (!bLoadedOk){
 		ofLogError("ofTrueTypeFont") << "drawString(): font not allocated: line " << __LINE__ << " in " << __FILE__;
 		return;
 	};
+
+	if(!binded && maxCachedStrings > 0 && drawCachedString(c,x,y)){
+		return;
+	}
+	
+	if(!bDynamic && bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+		string o;
+		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
+		c=o;
+	}
 	
 	bool alreadyBinded = binded;
 
@@ -1131,7 +1766,28 @@ void ofTrueTypeFont::bind(){
 	    glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		texAtlas.bind();
+		if(bDistanceField){
+			ofPtr<ofGLProgrammableRenderer> programmableRenderer = ofGetGLProgrammableRenderer();
+			if(!programmableRenderer){
+				#ifndef TARGET_OPENGLES
+					// without shaders the edge is where the distance is 0.5.
+					// alpha is the distance, blending with it would leave the
+					// inside of the glyphs translucent
+					glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
+					glDisable(GL_BLEND);
+					glEnable(GL_ALPHA_TEST);
+					glAlphaFunc(GL_GEQUAL, 0.5);
+				#endif
+			}else{
+				programmableRenderer->setDistanceFieldText(true);
+			}
+		}
+
+		if(bDynamic){
+			if(atlas) atlas->nextBatch();
+		}else{
+			texAtlas.bind();
+		}
 		stringQuads.clear();
 		binded = true;
 	}
@@ -1140,8 +1796,23 @@ void ofTrueTypeFont::bind(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::unbind(){
 	if(binded){
-		stringQuads.drawFaces();
-		texAtlas.unbind();
+		if(bDynamic){
+			drawPageQuads();
+		}else{
+			stringQuads.drawFaces();
+			texAtlas.unbind();
+		}
+
+		if(bDistanceField){
+			ofPtr<ofGLProgrammableRenderer> programmableRenderer = ofGetGLProgrammableRenderer();
+			if(!programmableRenderer){
+				#ifndef TARGET_OPENGLES
+					glPopAttrib();
+				#endif
+			}else{
+				programmableRenderer->setDistanceFieldText(false);
+			}
+		}
 
 		if( !blend_enabled )
 			glDisable(GL_BLEND);
@@ -1173,7 +1844,7 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) {
 		return;
 	}
 
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+	if(!bDynamic && bFullCharacterSet && encoding==OF_ENCODING_UTF8){
 		string o;
 		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
 		c=o;
@@ -1194,29 +1865,29 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) {
 	int len = (int)c.length();
 
 	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-		  if (c[index] == '\n') {
+		unsigned int character = nextCharacter(c,index);
+		  if (character == '\n') {
 
 				Y += lineHeight*newLineDirection;
 				X = x ; //reset X Pos back to zero
 
-		  }else if (c[index] == ' ') {
-				 int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 X += cps[cy].setWidth * letterSpacing * spaceSize;
+		  }else if (character == ' ') {
+				 const charProps * space = getCharProps('p');
+				 if(space) X += space->setWidth * letterSpacing * spaceSize;
 				 //glTranslated(cps[cy].width, 0, 0);
-		  } else if(cy > -1){
-				drawCharAsShape((unsigned char)c[index], X, Y);
-				X += cps[cy].setWidth * letterSpacing;
+		  } else if(const charProps * props = getCharProps(character)){
+				drawCharAsShape(character, X, Y);
+				X += props->setWidth * letterSpacing;
 				//glTranslated(cps[cy].setWidth, 0, 0);
 		  }
-		}
-		index++;
 	}
 
 }
 
 //-----------------------------------------------------------
 int ofTrueTypeFont::getNumCharacters() {
+	if(bDynamic){
+		return glyphs.size();
+	}
 	return nCharacters;
 }
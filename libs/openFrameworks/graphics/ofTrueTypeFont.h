@@ -8,6 +8,10 @@
 #include "ofPath.h"
 #include "ofTexture.h"
 #include "ofMesh.h"
+#include "ofGlyphAtlas.h"
+#include "ofTextBlock.h"
+#include <unordered_map>
+#include <list>
 
 //--------------------------------------------------
 typedef struct {
@@ -25,6 +29,8 @@ typedef struct {
 
 typedef ofPath ofTTFCharacter;
 
+struct FT_FaceRec_;
+
 //--------------------------------------------------
 #define NUM_CHARACTER_TO_START		33		// 0 - 32 are control characters, no graphics needed.
 
@@ -45,8 +51,26 @@ public:
 			
 	// 			-- default (without dpi), non-full char set, anti aliased, 96 dpi:
 	bool 		loadFont(string filename, int fontsize, bool _bAntiAliased=true, bool _bFullCharacterSet=false, bool makeContours=false, float simplifyAmt=0.3, int dpi=0);
+
+	// loads the font without rasterizing any glyph. each one is rasterized
+	// the first time it's used and packed in the pages of an ofGlyphAtlas,
+	// so any character in the font can be drawn and loading takes the same
+	// time at any size. strings are decoded as utf8 unless the encoding is
+	// OF_ENCODING_ISO_8859_15. getStringMesh() and getFontTexture() only
+	// cover the first page of the atlas
+	bool		loadDynamicFont(string filename, int fontsize, bool _bAntiAliased=true, bool makeContours=false, float simplifyAmt=0.3, int dpi=0);
+
+	// a dynamic font whose glyphs are signed distance fields generated from
+	// their outlines, so they stay sharp when scaled or zoomed. the fields
+	// are generated at a fixed size and shared by every size loaded from the
+	// same file, so a font per size costs only its metrics. the programmable
+	// renderer draws them with its distance field shader, the fixed pipeline
+	// with an alpha test
+	bool		loadDistanceFieldFont(string filename, int fontsize, bool makeContours=false, float simplifyAmt=0.3, int dpi=0);
 	
 	bool		isLoaded();
+	bool		isDynamic();
+	bool		isDistanceField();
 	bool		isAntiAliased();
 	bool		hasFullCharacterSet();
 
@@ -64,6 +88,14 @@ public:
 	
 	void 		drawString(string s, float x, float y);
 	void		drawStringAsShapes(string s, float x, float y);
+
+	// drawString outside of bind() and unbind() keeps the quads of strings
+	// drawn more than once in an ofTextBlock, and only moves them to x, y
+	// the next times. this is how many strings are kept, 0 disables it. it
+	// has to be more than the strings drawn in a frame, or they are dropped
+	// before they are drawn again
+	void		setStringCacheSize(int size); // default 1024
+	int			getStringCacheSize();
 	
 	//			get the num chars in the loaded char set
 	int			getNumCharacters();	
@@ -72,6 +104,8 @@ public:
 	vector<ofTTFCharacter> getStringAsPoints(string str, bool vflip=ofIsVFlipped());
 	ofMesh & getStringMesh(string s, float x, float y);
 	ofTexture & getFontTexture();
+	// the pages of a dynamic font, to change their sizes or how many are kept
+	ofGlyphAtlas & getGlyphAtlas();
 
 	void bind();
 	void unbind();
@@ -110,6 +144,70 @@ protected:
 	bool binded;
 	ofMesh stringQuads;
 
+	// changes every time the quads of a string would change
+	unsigned int	generation;
+	unsigned int	atlasGeneration;
+	unsigned int	getGeneration();
+	void			updateGeneration();
+	// the quads of a string at 0,0 for each texture of the font, with
+	// normalized texture coordinates
+	void			getStringMeshes(string s, vector<ofMesh> & meshes);
+
+	// the most recently drawn strings first, so finding, moving and
+	// dropping one is constant time. a copy of a font starts with an empty
+	// cache since the iterators and blocks belong to the original
+	struct CachedString{
+		string text;
+		ofTextBlock block;
+	};
+	struct StringCache{
+		StringCache(){}
+		StringCache(const StringCache &){}
+		StringCache & operator=(const StringCache &){ clear(); return *this; }
+		void clear(){ index.clear(); strings.clear(); }
+		std::list<CachedString> strings;
+		std::unordered_map<string,std::list<CachedString>::iterator> index;
+	};
+	StringCache		stringCache;
+	int				maxCachedStrings;
+	bool			drawCachedString(const string & s, float x, float y);
+	void			releaseCachedStrings();
+
+	// glyphs of dynamic fonts, rasterized on first use
+	struct Glyph{
+		charProps props;
+		// where the bitmap is in the atlas, page is -1 if it isn't
+		int page;
+		int x, y;
+		// of the page when the bitmap was added, if it changed the page
+		// was cleared and the glyph has to be rasterized again
+		unsigned int epoch;
+		ofTTFCharacter contour;
+		ofTTFCharacter contourNonVFlipped;
+	};
+
+	bool			bDynamic;
+	bool			bDistanceField;
+	// from the pixels of the distance fields to the ones of this size
+	float			distanceFieldScale;
+	struct DistanceField;
+	ofPtr<DistanceField> distanceField;
+	ofPtr<FT_FaceRec_> face;
+	ofPtr<ofGlyphAtlas> atlas;
+	std::unordered_map<unsigned int,Glyph> glyphs;
+	// quads of the current batch per atlas page, with texture
+	// coordinates in pixels since pages can grow during the batch
+	vector<ofMesh>	pageQuads;
+
+	unsigned int	nextCharacter(const string & s, int & index);
+	const charProps * getCharProps(unsigned int c);
+	Glyph *			getGlyph(unsigned int c);
+	bool			renderGlyph(unsigned int c);
+	void			packGlyph(Glyph & glyph);
+	void			packDistanceField(Glyph & glyph);
+	void			drawGlyph(Glyph & glyph, float x, float y);
+	void			drawPageQuads();
+
 private:
 #if defined(TARGET_ANDROID) || defined(TARGET_OF_IOS)
 	friend void ofUnloadAllFontTextures();
@@ -144,6 +242,7 @@ private:
 	static void finishLibraries();
 
 	friend void ofExitCallback();
+	friend class ofTextBlock;
 };
 
 
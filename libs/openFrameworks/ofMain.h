@@ -5,6 +5,7 @@
 #include "ofConstants.h"
 #include "ofFileUtils.h"
 #include "ofLog.h"
+#include "ofParallel.h"
 #include "ofSystemUtils.h"
 #include "ofThread.h"
 #include "ofURLFileLoader.h"
@@ -52,13 +53,19 @@
 #if !defined( TARGET_OF_IOS ) & !defined(TARGET_ANDROID) & !defined(TARGET_EMSCRIPTEN)  
 #include "ofCairoRenderer.h"
 #endif
+#include "ofGlyphAtlas.h"
 #include "ofGraphics.h"
 #include "ofImage.h"
+#include "ofImageSaver.h"
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
+#include "ofPreparedPolygon.h"
 #include "ofRendererCollection.h"
+#include "ofStroker.h"
 #include "ofTessellator.h"
+#include "ofTextBlock.h"
+#include "ofTiledImage.h"
 #include "ofTrueTypeFont.h"
 
 //--------------------------
@@ -88,5 +95,10 @@
 #include "ofCamera.h"
 #include "ofEasyCam.h"
 #include "ofMesh.h"
+#include "ofMeshBVH.h"
+#include "ofMeshDecimate.h"
+#include "ofMeshFile.h"
+#include "ofMeshOptimize.h"
 #include "ofNode.h"
+#include "ofRay.h"
 
@@ -4,6 +4,7 @@
 #endif
 
 #include "ofUtils.h"
+#include "Poco/Exception.h"
 
 
 #ifdef TARGET_OSX
@@ -237,6 +238,58 @@ bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary){
 	return ret;
 }
 
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofMappedFile
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------
+ofMappedFile::ofMappedFile(){
+}
+
+//--------------------------------------------------
+ofMappedFile::ofMappedFile(const string & path){
+	open(path);
+}
+
+//--------------------------------------------------
+bool ofMappedFile::open(const string & path){
+	close();
+	try{
+		Poco::File file(ofToDataPath(path));
+		if(!file.exists() || file.getSize() == 0){
+			return false;
+		}
+		memory = Poco::SharedMemory(file, Poco::SharedMemory::AM_READ);
+	}catch(Poco::Exception & e){
+		ofLogError("ofMappedFile") << "open(): couldn't map \"" << path << "\": " << e.displayText();
+		return false;
+	}
+	return isOpen();
+}
+
+//--------------------------------------------------
+void ofMappedFile::close(){
+	memory = Poco::SharedMemory();
+}
+
+//--------------------------------------------------
+bool ofMappedFile::isOpen() const{
+	return memory.begin() != NULL;
+}
+
+//--------------------------------------------------
+const char * ofMappedFile::getData() const{
+	return memory.begin();
+}
+
+//--------------------------------------------------
+long ofMappedFile::size() const{
+	return memory.end() - memory.begin();
+}
+
+
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 // -- ofFile
@@ -2,6 +2,7 @@
 
 #include "ofConstants.h"
 #include "Poco/File.h"
+#include "Poco/SharedMemory.h"
 
 //----------------------------------------------------------
 // ofBuffer
@@ -58,6 +59,31 @@ ofBuffer ofBufferFromFile(const string & path, bool binary=false);
 bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary=false);
 
 
+//----------------------------------------------------------
+// ofMappedFile
+//----------------------------------------------------------
+
+// read only memory mapping of a whole file. the contents are paged in by the
+// os as they are accessed instead of being copied into memory up front, and
+// stay valid until the file is closed or the object destroyed
+class ofMappedFile{
+
+public:
+	ofMappedFile();
+	ofMappedFile(const string & path);
+
+	bool open(const string & path);
+	void close();
+	bool isOpen() const;
+
+	const char * getData() const;
+	long size() const;
+
+private:
+	Poco::SharedMemory memory;
+};
+
+
 //--------------------------------------------------
 class ofFilePath{
 public:
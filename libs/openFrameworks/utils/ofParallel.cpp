@@ -0,0 +1,188 @@
+#include "ofParallel.h"
+
+#if defined(TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+	#define OF_PARALLEL_NO_THREADS
+#endif
+
+#ifndef OF_PARALLEL_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+
+namespace{
+
+// set in the pool threads so nested ofParallelFor calls don't wait on
+// workers that are already busy running their parent
+thread_local bool insideWorker = false;
+
+class ParallelPool{
+public:
+	ParallelPool(int numWorkers)
+	:exiting(false){
+		for(int i=0;i<numWorkers;i++){
+			workers.push_back(std::thread(&ParallelPool::work, this));
+		}
+	}
+
+	~ParallelPool(){
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			exiting = true;
+		}
+		condition.notify_all();
+		for(size_t i=0;i<workers.size();i++){
+			workers[i].join();
+		}
+	}
+
+	void add(const function<void()> & task){
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			tasks.push_back(task);
+		}
+		condition.notify_one();
+	}
+
+	int getNumWorkers() const{
+		return workers.size();
+	}
+
+private:
+	void work(){
+		insideWorker = true;
+		while(true){
+			function<void()> task;
+			{
+				std::unique_lock<std::mutex> lck(mutex);
+				while(!exiting && tasks.empty()){
+					condition.wait(lck);
+				}
+				if(tasks.empty()){
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<function<void()> > tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool exiting;
+};
+
+// state shared by the pool tasks of one ofParallelFor call
+struct ParallelJob{
+	ParallelJob(int begin, int end, int chunkSize, int numChunks, const function<void(int,int)> & func)
+	:begin(begin)
+	,end(end)
+	,chunkSize(chunkSize)
+	,numChunks(numChunks)
+	,func(func)
+	,nextChunk(0)
+	,doneChunks(0){}
+
+	// runs chunks until there's none left
+	void run(){
+		int chunk;
+		while((chunk = nextChunk++) < numChunks){
+			int chunkBegin = begin + chunk * chunkSize;
+			int chunkEnd = std::min(end, chunkBegin + chunkSize);
+			func(chunkBegin, chunkEnd);
+			if(++doneChunks == numChunks){
+				std::unique_lock<std::mutex> lck(mutex);
+				done.notify_all();
+			}
+		}
+	}
+
+	void wait(){
+		std::unique_lock<std::mutex> lck(mutex);
+		while(doneChunks < numChunks){
+			done.wait(lck);
+		}
+	}
+
+	int begin, end, chunkSize, numChunks;
+	// only used while the caller waits in ofParallelFor so it's safe to keep a reference
+	const function<void(int,int)> & func;
+	std::atomic<int> nextChunk;
+	std::atomic<int> doneChunks;
+	std::mutex mutex;
+	std::condition_variable done;
+};
+
+std::mutex poolMutex;
+int numThreads = 0;
+std::shared_ptr<ParallelPool> pool;
+
+std::shared_ptr<ParallelPool> getPool(){
+	std::unique_lock<std::mutex> lck(poolMutex);
+	if(numThreads <= 0){
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if(!pool || pool->getNumWorkers() != numThreads - 1){
+		pool = std::make_shared<ParallelPool>(numThreads - 1);
+	}
+	return pool;
+}
+
+}
+#endif
+
+//--------------------------------------------------
+int ofGetParallelThreads(){
+#ifdef OF_PARALLEL_NO_THREADS
+	return 1;
+#else
+	std::unique_lock<std::mutex> lck(poolMutex);
+	if(numThreads <= 0){
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	return numThreads;
+#endif
+}
+
+//--------------------------------------------------
+void ofSetParallelThreads(int _numThreads){
+#ifndef OF_PARALLEL_NO_THREADS
+	std::unique_lock<std::mutex> lck(poolMutex);
+	numThreads = std::max(1, _numThreads);
+#endif
+}
+
+//--------------------------------------------------
+void ofParallelFor(int begin, int end, const function<void(int,int)> & func, int grainSize){
+	if(end <= begin) return;
+	grainSize = std::max(1, grainSize);
+
+#ifdef OF_PARALLEL_NO_THREADS
+	func(begin, end);
+#else
+	int threads = ofGetParallelThreads();
+	int count = end - begin;
+	if(insideWorker || threads == 1 || count <= grainSize){
+		func(begin, end);
+		return;
+	}
+
+	// a few chunks per thread so uneven chunks still balance
+	int numChunks = std::min(threads * 4, (count + grainSize - 1) / grainSize);
+	int chunkSize = (count + numChunks - 1) / numChunks;
+	numChunks = (count + chunkSize - 1) / chunkSize;
+
+	std::shared_ptr<ParallelJob> job = std::make_shared<ParallelJob>(begin, end, chunkSize, numChunks, func);
+	std::shared_ptr<ParallelPool> workers = getPool();
+	int helpers = std::min(workers->getNumWorkers(), numChunks - 1);
+	for(int i=0;i<helpers;i++){
+		workers->add([job]{ job->run(); });
+	}
+	job->run();
+	job->wait();
+#endif
+}
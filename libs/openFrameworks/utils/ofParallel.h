@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ofConstants.h"
+
+// a small pool of worker threads shared by the parts of the core that split
+// cpu bound work (image resampling, mesh and polyline processing...) across
+// cores. on platforms without threads everything runs on the calling thread.
+
+// number of threads the pool uses including the calling one, defaults to the
+// number of hardware threads
+int ofGetParallelThreads();
+void ofSetParallelThreads(int numThreads);
+
+// calls func(chunkBegin, chunkEnd) over [begin, end) split in chunks of at
+// least grainSize elements, runs them on the pool and the calling thread and
+// returns when all of them are done. calls from inside a worker run inline
+void ofParallelFor(int begin, int end, const function<void(int,int)> & func, int grainSize = 1);
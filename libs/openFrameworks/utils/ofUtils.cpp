@@ -1,5 +1,6 @@
 #include "ofUtils.h"
 #include "ofImage.h"
+#include "ofImageSaver.h"
 #include "ofTypes.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
@@ -767,6 +768,36 @@ void ofSaveFrame(bool bUseViewport){
 	saveImageCounter++;
 }
 
+//--------------------------------------------------
+future<bool> ofSaveScreenAsync(string filename) {
+	ofImage screen;
+	screen.setUseTexture(false);
+	screen.allocate(ofGetWidth(), ofGetHeight(), OF_IMAGE_COLOR);
+	screen.grabScreen(0, 0, ofGetWidth(), ofGetHeight());
+	return ofSaveImageAsync(std::move(screen.getPixelsRef()), filename);
+}
+
+//--------------------------------------------------
+future<bool> ofSaveViewportAsync(string filename) {
+	ofImage screen;
+	ofRectangle view = ofGetCurrentViewport();
+	screen.setUseTexture(false);
+	screen.allocate(view.width, view.height, OF_IMAGE_COLOR);
+	screen.grabScreen(0, 0, view.width, view.height);
+	return ofSaveImageAsync(std::move(screen.getPixelsRef()), filename);
+}
+
+//--------------------------------------------------
+future<bool> ofSaveFrameAsync(bool bUseViewport){
+	string fileName = ofToString(saveImageCounter) + ".png";
+	saveImageCounter++;
+	if (bUseViewport){
+		return ofSaveViewportAsync(fileName);
+	} else {
+		return ofSaveScreenAsync(fileName);
+	}
+}
+
 //--------------------------------------------------
 string ofSystem(string command){
 	FILE * ret = NULL;
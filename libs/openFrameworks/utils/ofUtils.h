@@ -202,6 +202,11 @@ void	ofSaveScreen(string filename);
 void	ofSaveFrame(bool bUseViewport = false);
 void	ofSaveViewport(string filename);
 
+// grab the screen and encode it in the background, see ofImageSaver
+future<bool> ofSaveScreenAsync(string filename);
+future<bool> ofSaveFrameAsync(bool bUseViewport = false);
+future<bool> ofSaveViewportAsync(string filename);
+
 //--------------------------------------------------
 vector <string> ofSplitString(const string & source, const string & delimiter, bool ignoreEmpty = false, bool trim = false);
 string ofJoinString(vector <string> stringElements, const string & delimiter);